@@ -6,11 +6,28 @@
 #define INTERVAL 2 * MINUTE
 #define BATTERY_INTERVAL 60 * MINUTE
 
+// Values sent in place of measurement of sensor which failed
+#define INVALID_TEMPERATURE INT16_MIN
+#define INVALID_HUMIDITY UINT8_MAX
+#define INVALID_LIGHT UINT16_MAX
+#define INVALID_PRESSURE UINT16_MAX
+
+// Number of measurements sent in one radio frame
+#ifndef BATCH_SIZE
+#define BATCH_SIZE 1
+#endif
+
+// 1 sends battery values in one multi frame and subtopics as numeric ids, gateway firmware has to decode
+// headers 0x20 to 0x22 (older one acknowledges frames with unknown header and drops them)
+#ifndef COMPACT_FRAMES
+#define COMPACT_FRAMES 0
+#endif
+
 
 void measurement(bc_module_climate_event_t event, void *event_param)
 {
     (void) event_param;
-    float value = 0.0f;
+    bc_module_climate_snapshot_t snapshot;
     uint8_t buffer[7] = {0};
 
     uint8_t humidity;
@@ -18,28 +35,24 @@ void measurement(bc_module_climate_event_t event, void *event_param)
     uint16_t pressure;
     uint16_t light;
 
-    if(event == BC_MODULE_CLIMATE_EVENT_UPDATE_BAROMETER)
+    if(event == BC_MODULE_CLIMATE_EVENT_UPDATE_ALL_SENSORS && bc_module_climate_get_snapshot(&snapshot))
     {
-        
-        bc_module_climate_get_temperature_celsius(&value);
-        temperature = value * 100;
+        // Value of sensor which failed is replaced by sentinel, it would be indistinguishable from real reading otherwise
+        temperature = snapshot.temperature_valid ? snapshot.temperature_celsius * 100 : INVALID_TEMPERATURE;
 
-        bc_module_climate_get_humidity_percentage(&value);
-        humidity = (uint8_t)value;
+        humidity = snapshot.humidity_valid ? (uint8_t)snapshot.humidity_percentage : INVALID_HUMIDITY;
 
-        bc_module_climate_get_illuminance_lux(&value);
-        light = (uint16_t)value;
+        // Illuminance above range of frame is saturated below sentinel
+        light = !snapshot.illuminance_valid ? INVALID_LIGHT : snapshot.illuminance_lux < INVALID_LIGHT ? (uint16_t)snapshot.illuminance_lux : INVALID_LIGHT - 1;
 
-        bc_module_climate_get_pressure_pascal(&value);
-        value /= 100.0f;
-        pressure = (value - 900) * 100;
+        pressure = snapshot.pressure_valid ? (snapshot.pressure_pascal / 100.0f - 900) * 100 : INVALID_PRESSURE;
 
         memcpy(&buffer[0], &temperature, 2);
         memcpy(&buffer[2], &humidity, 1);
         memcpy(&buffer[3], &light, 2);
         memcpy(&buffer[5], &pressure, 2);
 
-        bc_radio_pub_buffer(&buffer, sizeof(buffer));
+        bc_radio_pub_batch_buffer(&buffer, sizeof(buffer));
 
     }
 }
@@ -51,6 +64,10 @@ static void battery_event(bc_module_battery_event_t event, void *event_param)
     float voltage;
     int percentage;
 
+    if (COMPACT_FRAMES)
+    {
+        bc_radio_pub_multi_begin();
+    }
 
     if(bc_module_battery_get_voltage(&voltage))
     {
@@ -72,19 +89,26 @@ static void battery_event(bc_module_battery_event_t event, void *event_param)
         int data = 0;
         bc_radio_pub_int("bat-alarm", &data);
     }
+
+    if (COMPACT_FRAMES)
+    {
+        bc_radio_pub_multi_end();
+    }
 }
 
 
 void application_init(void)
 {
    bc_radio_init(BC_RADIO_MODE_NODE_SLEEPING);
+   bc_radio_pub_batch_set_size(BATCH_SIZE);
+   bc_radio_pub_set_topic_dictionary(COMPACT_FRAMES);
    bc_module_battery_init(BC_MODULE_BATTERY_FORMAT_MINI);
    bc_module_battery_set_event_handler(battery_event, NULL);
    bc_module_battery_set_update_interval(BATTERY_INTERVAL);
 
    bc_module_climate_init();
    bc_module_climate_set_event_handler(measurement, NULL);
-   bc_module_climate_set_update_interval_all_sensors(INTERVAL);
+   bc_module_climate_set_update_interval_synchronized(INTERVAL);
 
    bc_radio_pairing_request("METEOSONDA", "1");
    
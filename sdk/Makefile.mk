@@ -315,6 +315,76 @@ $(BIN): $(ELF)
 	$(Q)rm -f $(OUT).bin
 	$(Q)cp $(BIN) $(OUT).bin
 
+################################################################################
+# Host target (x86-64 Linux build with simulated peripherals)                  #
+################################################################################
+
+HOST_CC ?= gcc
+HOST_AR ?= ar
+HOST_LIB ?= $(OUT_DIR)/host/libbcl.a
+
+HOST_INC_DIR += $(SDK_DIR)/bcl/inc
+HOST_INC_DIR += $(SDK_DIR)/bcl/host/inc
+
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_atsha204.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_button.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_data_stream.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_eeprom_log.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_fifo.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_led.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_module_climate.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_module_lcd.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_mpl3115a2.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_opt3001.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_queue.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_radio.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_radio_node.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_radio_pub.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_scheduler.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_sht20.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_tca9534a.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_telemetry_codec.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_tick.c
+HOST_SRC_C += $(SDK_DIR)/bcl/src/bc_tmp112.c
+HOST_SRC_C += $(wildcard $(SDK_DIR)/bcl/src/bc_font_*.c)
+HOST_SRC_C += $(wildcard $(SDK_DIR)/bcl/host/src/*.c)
+
+HOST_CFLAGS += -Wall
+HOST_CFLAGS += -pedantic
+HOST_CFLAGS += -Wextra
+HOST_CFLAGS += -Wmissing-include-dirs
+HOST_CFLAGS += -Wswitch-default
+HOST_CFLAGS += -Wswitch-enum
+HOST_CFLAGS += -D'__weak=__attribute__((weak))'
+HOST_CFLAGS += -D'__packed=__attribute__((__packed__))'
+HOST_CFLAGS += -D'BC_HOST'
+HOST_CFLAGS += -std=c11
+HOST_CFLAGS += -g3
+HOST_CFLAGS += -O2
+
+HOST_OBJ = $(HOST_SRC_C:%.c=$(OBJ_DIR)/host/%.o)
+
+.PHONY: host
+host: $(HOST_LIB)
+
+$(HOST_LIB): $(HOST_OBJ)
+	$(Q)$(ECHO) "Creating $(HOST_LIB)..."
+	$(Q)mkdir -p $(@D)
+	$(Q)rm -f $(HOST_LIB)
+	$(Q)$(HOST_AR) rcs $(HOST_LIB) $(HOST_OBJ)
+
+$(OBJ_DIR)/host/%.o: %.c
+	$(Q)$(ECHO) "Compiling (host): $<"
+	$(Q)mkdir -p $(@D)
+	$(Q)$(HOST_CC) -MMD -c $(HOST_CFLAGS) $(foreach d,$(HOST_INC_DIR),-I$d) $< -o $@
+
+.PHONY: clean-host
+clean-host:
+	$(Q)$(ECHO) "Removing host build..."
+	$(Q)rm -rf $(OBJ_DIR)/host $(OUT_DIR)/host
+
+-include $(HOST_OBJ:%.o=%.d)
+
 ################################################################################
 # Compile source files                                                         #
 ################################################################################
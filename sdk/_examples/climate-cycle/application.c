@@ -0,0 +1,372 @@
+#include <application.h>
+#include <stdio.h>
+#include <math.h>
+#include <inttypes.h>
+
+// Interval of measurement cycles
+#define INTERVAL 5000
+
+// Two conversions of barometer (altitude and pressure) bound the cycle
+#define BAROMETER_TIME 3000
+
+// Barometer is initialized 1500 ms after start and 1500 ms later it is ready to measure
+#define BAROMETER_READY 3000
+
+// Allowed time of I2C transfers and of conversions of other sensors beyond barometer
+#define CYCLE_MARGIN 100
+
+// Clock stretching of hygrometer which exceeds its I2C timeout
+#define STRETCH 100
+
+// Values of simulated chips: 25 degrees, 50 %, 20 lux, 300 m, 101325 Pa
+#define TEMPERATURE 0x1900
+#define HUMIDITY 0x72b0
+#define TEMPERATURE_SHT20 0x6860
+#define ILLUMINANCE 0x21f4
+#define ALTITUDE 0x012c00
+#define PRESSURE 0x62f340
+
+typedef enum
+{
+    STEP_FIRST = 0,
+    STEP_SYNCHRONIZED = 1,
+    STEP_STRETCH = 2,
+    STEP_RECOVER = 3,
+    STEP_PER_SENSOR = 4
+
+} step_t;
+
+// Ticks at which steps are checked, the last cycle of each step is over by then
+static const bc_tick_t step_tick[] = { 9000, 24000, 39000, 54000, 64000 };
+
+static struct
+{
+    int all;
+    int update;
+    int error_hygrometer;
+    int error_other;
+    int snapshot_wrong;
+    int ticks;
+    bc_tick_t tick_last;
+    bc_tick_t duration_min;
+    bc_tick_t duration_max;
+    bool humidity_valid;
+
+} phase;
+
+static step_t step;
+
+static int failures;
+
+static uint8_t tmp112_config;
+
+static uint8_t sht20_command;
+
+static uint16_t opt3001_config;
+
+static uint8_t mpl3115a2_control;
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        printf("FAIL %s\n", name);
+
+        failures++;
+    }
+}
+
+static void put_16(void *buffer, size_t length, uint16_t value)
+{
+    uint8_t data[2] = { value >> 8, value };
+
+    memcpy(buffer, data, length < 2 ? length : 2);
+}
+
+// One-shot conversion of TMP112 is finished when OS and SD bits are read back
+static bool tmp112_handler(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param)
+{
+    (void) param;
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_WRITE) && (memory_address == 0x01))
+    {
+        tmp112_config = *(uint8_t *) buffer;
+
+        return true;
+    }
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_READ) && (memory_address == 0x01))
+    {
+        put_16(buffer, length, tmp112_config << 8 | 0xa0);
+
+        return true;
+    }
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_READ) && (memory_address == 0x00))
+    {
+        put_16(buffer, length, TEMPERATURE);
+
+        return true;
+    }
+
+    return false;
+}
+
+// SHT20 returns result of the last measure command (0xf5 humidity, 0xf3 temperature)
+static bool sht20_handler(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param)
+{
+    (void) memory_address;
+    (void) param;
+
+    if (operation == BC_HOST_I2C_OPERATION_WRITE)
+    {
+        sht20_command = *(uint8_t *) buffer;
+
+        return true;
+    }
+
+    if (operation == BC_HOST_I2C_OPERATION_READ)
+    {
+        if ((sht20_command != 0xf5) && (sht20_command != 0xf3))
+        {
+            return false;
+        }
+
+        put_16(buffer, length, sht20_command == 0xf5 ? HUMIDITY : TEMPERATURE_SHT20);
+
+        return true;
+    }
+
+    return false;
+}
+
+// Single shot conversion of OPT3001 sets CRF and returns to shutdown
+static bool opt3001_handler(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param)
+{
+    (void) param;
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_WRITE) && (memory_address == 0x01) && (length == 2))
+    {
+        opt3001_config = ((uint8_t *) buffer)[0] << 8 | ((uint8_t *) buffer)[1];
+
+        return true;
+    }
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_READ) && (memory_address == 0x01))
+    {
+        put_16(buffer, length, (opt3001_config & ~0x0600) | 0x0080);
+
+        return true;
+    }
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_READ) && (memory_address == 0x00))
+    {
+        put_16(buffer, length, ILLUMINANCE);
+
+        return true;
+    }
+
+    return false;
+}
+
+// MPL3115A2 returns altitude or pressure by ALT bit of CTRL_REG1, status has data ready flags set
+static bool mpl3115a2_handler(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param)
+{
+    (void) param;
+    uint32_t value;
+    if (operation == BC_HOST_I2C_OPERATION_MEMORY_WRITE)
+    {
+        if (memory_address == 0x26)
+        {
+            mpl3115a2_control = *(uint8_t *) buffer;
+        }
+
+        return (memory_address == 0x26) || (memory_address == 0x13);
+    }
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_READ) && (memory_address == 0x00) && (length == 1))
+    {
+        *(uint8_t *) buffer = 0x0e;
+
+        return true;
+    }
+
+    if ((operation == BC_HOST_I2C_OPERATION_MEMORY_READ) && (memory_address == 0x01) && (length == 5))
+    {
+        value = (mpl3115a2_control & 0x80) != 0 ? ALTITUDE : PRESSURE;
+
+        uint8_t data[5] = { value >> 16, value >> 8, value, 25, 0 };
+
+        memcpy(buffer, data, sizeof(data));
+
+        return true;
+    }
+
+    return false;
+}
+
+static bool value_check(bool valid, float value, float expected)
+{
+    return valid && (fabsf(value - expected) < 0.01f);
+}
+
+static void climate_event_handler(bc_module_climate_event_t event, void *event_param)
+{
+    (void) event_param;
+    bc_tick_t tick_now = bc_tick_get();
+    bc_tick_t duration = tick_now % INTERVAL;
+    bc_module_climate_snapshot_t snapshot;
+
+    if (tick_now != phase.tick_last)
+    {
+        phase.ticks++;
+
+        phase.tick_last = tick_now;
+    }
+
+    if (event == BC_MODULE_CLIMATE_EVENT_ERROR_HYGROMETER)
+    {
+        phase.error_hygrometer++;
+    }
+    else if (event <= BC_MODULE_CLIMATE_EVENT_ERROR_BAROMETER)
+    {
+        phase.error_other++;
+    }
+    else if (event != BC_MODULE_CLIMATE_EVENT_UPDATE_ALL_SENSORS)
+    {
+        phase.update++;
+    }
+    else
+    {
+        phase.all++;
+
+        phase.duration_min = duration < phase.duration_min ? duration : phase.duration_min;
+        phase.duration_max = duration > phase.duration_max ? duration : phase.duration_max;
+
+        if (!bc_module_climate_get_snapshot(&snapshot) ||
+                !value_check(snapshot.temperature_valid, snapshot.temperature_celsius, 25.f) ||
+                (snapshot.humidity_valid != phase.humidity_valid) ||
+                (phase.humidity_valid && !value_check(snapshot.humidity_valid, snapshot.humidity_percentage, 50.f)) ||
+                !value_check(snapshot.illuminance_valid, snapshot.illuminance_lux, 20.f) ||
+                !value_check(snapshot.altitude_valid, snapshot.altitude_meter, 300.f) ||
+                !value_check(snapshot.pressure_valid, snapshot.pressure_pascal, 101325.f))
+        {
+            phase.snapshot_wrong++;
+        }
+    }
+}
+
+static void phase_reset(bool humidity_valid)
+{
+    memset(&phase, 0, sizeof(phase));
+
+    phase.tick_last = BC_TICK_INFINITY;
+    phase.duration_min = BC_TICK_INFINITY;
+    phase.humidity_valid = humidity_valid;
+}
+
+// Three cycles of synchronized mode, each raises one combined event bounded by barometer
+static void cycles_check(const char *name, int error_hygrometer)
+{
+    printf("%-12s %d cycles in %" PRIu64 " to %" PRIu64 " ms, %d handler calls, %d hygrometer errors\n",
+           name, phase.all, phase.duration_min, phase.duration_max, phase.ticks, phase.error_hygrometer);
+
+    check(phase.all == 3, name);
+    check(phase.update == 0, name);
+    check(phase.error_hygrometer == error_hygrometer, name);
+    check(phase.error_other == 0, name);
+    check(phase.snapshot_wrong == 0, name);
+    check(phase.ticks == 3 + error_hygrometer, name);
+    check(phase.duration_min >= BAROMETER_TIME, name);
+    check(phase.duration_max < BAROMETER_TIME + CYCLE_MARGIN, name);
+}
+
+static void step_task(void *param)
+{
+    (void) param;
+
+    switch (step)
+    {
+        case STEP_FIRST:
+        {
+            printf("%-12s 1 cycle in %" PRIu64 " ms\n", "first", phase.tick_last);
+
+            // Cycle started by bc_module_climate_set_update_interval_synchronized waits for initialization of barometer,
+            // the interval task at 5000 ms does not start another cycle while this one is pending
+            check(phase.all == 1, "first");
+            check(phase.update + phase.error_hygrometer + phase.error_other == 0, "first");
+            check(phase.snapshot_wrong == 0, "first");
+            check(phase.tick_last >= BAROMETER_READY + BAROMETER_TIME, "first");
+
+            phase_reset(true);
+
+            break;
+        }
+        case STEP_SYNCHRONIZED:
+        {
+            cycles_check("synchronized", 0);
+
+            bc_host_i2c_set_delay(BC_I2C_I2C0, 0x40, STRETCH);
+
+            phase_reset(false);
+
+            break;
+        }
+        case STEP_STRETCH:
+        {
+            cycles_check("stretch", 3);
+
+            bc_host_i2c_set_delay(BC_I2C_I2C0, 0x40, 0);
+
+            phase_reset(true);
+
+            break;
+        }
+        case STEP_RECOVER:
+        {
+            cycles_check("recover", 0);
+
+            bc_module_climate_set_update_interval_all_sensors(INTERVAL);
+
+            phase_reset(true);
+
+            break;
+        }
+        case STEP_PER_SENSOR:
+        default:
+        {
+            printf("%-12s %d updates, %d handler calls\n", "per sensor", phase.update, phase.ticks);
+
+            // Sensors finish at their own ticks and every one wakes the application
+            check(phase.all == 0, "per sensor");
+            check(phase.update == 2 * 4, "per sensor");
+            check(phase.error_hygrometer + phase.error_other == 0, "per sensor");
+            check(phase.ticks == phase.update, "per sensor");
+
+            printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+
+            exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+
+    step++;
+
+    bc_scheduler_plan_current_absolute(step_tick[step]);
+}
+
+void application_init(void)
+{
+    bc_module_climate_init();
+
+    bc_host_i2c_attach(BC_I2C_I2C0, 0x48, tmp112_handler, NULL);
+    bc_host_i2c_attach(BC_I2C_I2C0, 0x40, sht20_handler, NULL);
+    bc_host_i2c_attach(BC_I2C_I2C0, 0x44, opt3001_handler, NULL);
+    bc_host_i2c_attach(BC_I2C_I2C0, 0x60, mpl3115a2_handler, NULL);
+
+    phase_reset(true);
+
+    bc_module_climate_set_event_handler(climate_event_handler, NULL);
+    bc_module_climate_set_update_interval_synchronized(INTERVAL);
+
+    bc_scheduler_register(step_task, NULL, step_tick[STEP_FIRST]);
+}
@@ -0,0 +1,219 @@
+#include <application.h>
+#include <stdio.h>
+#include <time.h>
+
+// Default number of samples fed per window size
+#define SAMPLES 200000
+
+// Number of window sizes, they double from the smallest one
+#define WINDOW_COUNT 6
+
+// Smallest window size
+#define WINDOW_MIN 8
+
+// Percentile checked against the copy of old code
+#define PERCENTILE 90
+
+// Data stream which sorts a copy of the window on every query (bc_data_stream did so before sorted window)
+typedef struct
+{
+    float *feed;
+    float *sort;
+    int number_of_samples;
+    int counter;
+    int feed_head;
+
+} qsort_stream_t;
+
+// Sum of medians so that queries cannot be optimized out
+static double checksum;
+
+static int qsort_stream_compare(const void *a, const void *b)
+{
+    // Old comparator returned difference truncated to int, samples closer than 1 compared as equal
+    float difference = *(const float *) a - *(const float *) b;
+
+    return (difference > 0) - (difference < 0);
+}
+
+static void qsort_stream_init(qsort_stream_t *stream, int number_of_samples)
+{
+    stream->feed = malloc(number_of_samples * sizeof(float));
+    stream->sort = malloc(number_of_samples * sizeof(float));
+    stream->number_of_samples = number_of_samples;
+    stream->counter = 0;
+    stream->feed_head = 0;
+}
+
+static void qsort_stream_free(qsort_stream_t *stream)
+{
+    free(stream->feed);
+    free(stream->sort);
+}
+
+static void qsort_stream_feed(qsort_stream_t *stream, float value)
+{
+    stream->feed[stream->feed_head] = value;
+
+    stream->feed_head = (stream->feed_head + 1) % stream->number_of_samples;
+
+    stream->counter++;
+}
+
+static int qsort_stream_sort(qsort_stream_t *stream)
+{
+    int length = stream->counter > stream->number_of_samples ? stream->number_of_samples : stream->counter;
+
+    memcpy(stream->sort, stream->feed, length * sizeof(float));
+
+    qsort(stream->sort, length, sizeof(float), qsort_stream_compare);
+
+    return length;
+}
+
+static float qsort_stream_get_median(qsort_stream_t *stream)
+{
+    int length = qsort_stream_sort(stream);
+
+    if (length % 2 == 0)
+    {
+        return (stream->sort[(length - 2) / 2] + stream->sort[length / 2]) / 2;
+    }
+
+    return stream->sort[(length - 1) / 2];
+}
+
+static float qsort_stream_get_percentile(qsort_stream_t *stream, float percentile)
+{
+    int length = qsort_stream_sort(stream);
+
+    float rank = percentile / 100 * (length - 1);
+
+    int index = rank;
+
+    float fraction = rank - index;
+
+    if (length == 1)
+    {
+        return stream->sort[0];
+    }
+
+    if (index == length - 1)
+    {
+        index--;
+
+        fraction = 1;
+    }
+
+    return stream->sort[index] + (stream->sort[index + 1] - stream->sort[index]) * fraction;
+}
+
+// Temperature like samples with noise below one degree
+static float sample_get(long i)
+{
+    static uint32_t state = 1;
+
+    state = state * 1103515245 + 12345;
+
+    return 21.5f + (float) ((i / 1000) % 40) / 10 + (float) (state >> 16) / 65536;
+}
+
+static double elapsed_get(clock_t start, long samples)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC * 1e9 / samples;
+}
+
+void application_init(void)
+{
+    const char *text = getenv("SAMPLES");
+    long samples = text != NULL ? atol(text) : SAMPLES;
+    float *values = malloc(samples * sizeof(float));
+    long mismatches = 0;
+
+    for (long i = 0; i < samples; i++)
+    {
+        values[i] = sample_get(i);
+    }
+
+    printf("window    qsort ns   sorted ns   (one feed and one median query per sample)\n");
+
+    for (int number_of_samples = WINDOW_MIN; number_of_samples < WINDOW_MIN << WINDOW_COUNT; number_of_samples *= 2)
+    {
+        qsort_stream_t qsort_stream;
+
+        qsort_stream_init(&qsort_stream, number_of_samples);
+
+        clock_t start = clock();
+
+        for (long i = 0; i < samples; i++)
+        {
+            qsort_stream_feed(&qsort_stream, values[i]);
+
+            checksum += qsort_stream_get_median(&qsort_stream);
+        }
+
+        double qsort_ns = elapsed_get(start, samples);
+
+        bc_data_stream_buffer_t buffer = {
+                .feed = malloc(number_of_samples * sizeof(float)),
+                .sort = malloc(number_of_samples * sizeof(float)),
+                .number_of_samples = number_of_samples,
+                .type = BC_DATA_STREAM_TYPE_FLOAT
+        };
+        bc_data_stream_t stream;
+        float median;
+
+        bc_data_stream_init(&stream, 1, &buffer);
+
+        start = clock();
+
+        for (long i = 0; i < samples; i++)
+        {
+            bc_data_stream_feed(&stream, &values[i]);
+
+            bc_data_stream_get_median(&stream, &median);
+
+            checksum += median;
+        }
+
+        double sorted_ns = elapsed_get(start, samples);
+
+        printf("%6d %11.1f %11.1f\n", number_of_samples, qsort_ns, sorted_ns);
+
+        // Untimed pass checks that both give the same median and percentile after every sample
+        qsort_stream.counter = 0;
+        qsort_stream.feed_head = 0;
+
+        bc_data_stream_reset(&stream);
+
+        for (long i = 0; i < samples; i++)
+        {
+            float percentile;
+
+            qsort_stream_feed(&qsort_stream, values[i]);
+
+            bc_data_stream_feed(&stream, &values[i]);
+
+            bc_data_stream_get_median(&stream, &median);
+
+            bc_data_stream_get_percentile(&stream, PERCENTILE, &percentile);
+
+            if ((median != qsort_stream_get_median(&qsort_stream)) ||
+                (percentile != qsort_stream_get_percentile(&qsort_stream, PERCENTILE)))
+            {
+                mismatches++;
+            }
+        }
+
+        qsort_stream_free(&qsort_stream);
+
+        free(buffer.feed);
+        free(buffer.sort);
+    }
+
+    free(values);
+
+    printf("%ld mismatches of median or %d. percentile (checksum %.1f)\n", mismatches, PERCENTILE, checksum);
+
+    exit(mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,272 @@
+#include <application.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+// Default number of random appends and removes
+#define OPERATIONS 200000
+
+// Default number of slots of log area
+#define SLOTS 64
+
+// Default interval of operations which are interrupted by power cut
+#define CUT_INTERVAL 20
+
+// Operations after which the probability of append and remove is swapped, so the log is filled and drained
+#define PHASE 5000
+
+typedef struct
+{
+    uint32_t *id;
+    int size;
+    int head;
+    int count;
+
+} model_t;
+
+static int failures;
+
+static uint32_t random_state = 1;
+
+static uint32_t random_get(uint32_t range)
+{
+    random_state = random_state * 1103515245 + 12345;
+
+    return (random_state >> 8) % range;
+}
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        if (failures < 10)
+        {
+            printf("FAIL %s\n", name);
+        }
+
+        failures++;
+    }
+}
+
+static uint32_t model_front(model_t *model)
+{
+    return model->id[(model->head + model->size - model->count) % model->size];
+}
+
+static void model_push(model_t *model, uint32_t id)
+{
+    model->id[model->head] = id;
+    model->head = (model->head + 1) % model->size;
+    model->count++;
+}
+
+// Record is its id followed by 0 to 6 bytes derived from it
+static size_t record_create(uint32_t id, uint8_t *buffer)
+{
+    size_t length = 4 + id % (BC_EEPROM_LOG_RECORD_SIZE - 3);
+
+    memcpy(buffer, &id, 4);
+
+    for (size_t i = 4; i < length; i++)
+    {
+        buffer[i] = id * 7 + i;
+    }
+
+    return length;
+}
+
+// The oldest record must be the front of model
+static void record_check(bc_eeprom_log_t *log, model_t *model)
+{
+    uint8_t buffer[BC_EEPROM_LOG_RECORD_SIZE];
+    uint8_t expected[BC_EEPROM_LOG_RECORD_SIZE];
+    size_t length;
+
+    check(bc_eeprom_log_get_count(log) == model->count, "count");
+
+    if (model->count == 0)
+    {
+        check(!bc_eeprom_log_peek(log, buffer, &length), "empty log");
+
+        return;
+    }
+
+    check(bc_eeprom_log_peek(log, buffer, &length), "peek");
+
+    check((length == record_create(model_front(model), expected)) && (memcmp(buffer, expected, length) == 0), "oldest record");
+}
+
+static void run(uint32_t seed, int operations, int slots, int cut_interval)
+{
+    uint32_t address = bc_eeprom_get_size() - BC_RADIO_EEPROM_RESERVED - slots * BC_EEPROM_LOG_SLOT_SIZE;
+    model_t model = { .id = malloc(slots * sizeof(uint32_t)), .size = slots };
+    bc_eeprom_log_t log;
+    uint8_t buffer[BC_EEPROM_LOG_RECORD_SIZE];
+    uint32_t id = 0;
+    int cuts = 0;
+    int lost = 0;
+    int repeated = 0;
+
+    random_state = seed;
+
+    srand(seed);
+
+    memset(bc_host_eeprom_get_buffer(), 0, bc_eeprom_get_size());
+
+    check(bc_eeprom_log_init(&log, address, slots * BC_EEPROM_LOG_SLOT_SIZE), "init");
+
+    for (int i = 0; i < operations; i++)
+    {
+        bool cut = (i % cut_interval) == cut_interval - 1;
+        bool append = (random_get(100) < ((i / PHASE) % 2 == 0 ? 60 : 40)) || (model.count == 0);
+        bool overwrite = append && (model.count == slots);
+        bool result;
+
+        if (cut)
+        {
+            bc_host_eeprom_set_power_cut(random_get(BC_EEPROM_LOG_SLOT_SIZE));
+        }
+
+        if (append)
+        {
+            // The oldest record is overwritten when log is full
+            if (overwrite)
+            {
+                model.count--;
+            }
+
+            result = bc_eeprom_log_append(&log, buffer, record_create(id, buffer));
+
+            if (result)
+            {
+                model_push(&model, id);
+            }
+
+            id++;
+        }
+        else
+        {
+            result = bc_eeprom_log_remove(&log);
+
+            if (result)
+            {
+                model.count--;
+            }
+        }
+
+        if (!cut)
+        {
+            check(result, "operation without power cut");
+
+            record_check(&log, &model);
+
+            continue;
+        }
+
+        cuts++;
+
+        // Reset after power cut, the log is recovered from EEPROM
+        bc_host_eeprom_set_power_cut(SIZE_MAX);
+
+        check(bc_eeprom_log_init(&log, address, slots * BC_EEPROM_LOG_SLOT_SIZE), "init after power cut");
+
+        if (!result && !append && (bc_eeprom_log_get_count(&log) == model.count))
+        {
+            // Removal was lost, the record is returned once more
+            repeated++;
+        }
+        else if (!result && !append)
+        {
+            model.count--;
+        }
+        else if (!result && (bc_eeprom_log_get_count(&log) == model.count + 1))
+        {
+            uint8_t expected[BC_EEPROM_LOG_RECORD_SIZE];
+            size_t length;
+
+            // Record was appended, or the oldest record survived because power was cut before its slot was changed
+            if (overwrite && bc_eeprom_log_peek(&log, buffer, &length) &&
+                    (length == record_create(model.id[model.head], expected)) && (memcmp(buffer, expected, length) == 0))
+            {
+                model.count++;
+            }
+            else
+            {
+                model_push(&model, id - 1);
+            }
+        }
+        else if (!result)
+        {
+            lost++;
+        }
+
+        record_check(&log, &model);
+    }
+
+    // Drain the log in order
+    while (model.count != 0)
+    {
+        record_check(&log, &model);
+
+        check(bc_eeprom_log_remove(&log), "remove");
+
+        model.count--;
+    }
+
+    check(bc_eeprom_log_get_count(&log) == 0, "drained log");
+
+    const uint32_t *write_count = bc_host_eeprom_get_write_count();
+    uint32_t wear_min = UINT32_MAX;
+    uint32_t wear_max = 0;
+
+    for (size_t i = address + slots * BC_EEPROM_LOG_SLOT_SIZE; i < bc_eeprom_get_size(); i++)
+    {
+        check(write_count[i] == 0, "peer table area untouched");
+    }
+
+    // Wear of slot is wear of its most written byte
+    for (int i = 0; i < slots; i++)
+    {
+        uint32_t wear = 0;
+
+        for (int j = 0; j < BC_EEPROM_LOG_SLOT_SIZE; j++)
+        {
+            wear = write_count[address + i * BC_EEPROM_LOG_SLOT_SIZE + j] > wear ? write_count[address + i * BC_EEPROM_LOG_SLOT_SIZE + j] : wear;
+        }
+
+        wear_min = wear < wear_min ? wear : wear_min;
+        wear_max = wear > wear_max ? wear : wear_max;
+    }
+
+    // Every slot is written once per turn of the ring (short runs are not checked)
+    check((wear_min < 100) || (wear_max * 10 <= wear_min * 11), "wear levelled within 10 %");
+
+    printf("seed %" PRIu32 ", %d slots: %" PRIu32 " appends, %d power cuts, %d appends lost by cut, %d records returned again, "
+           "writes per slot %" PRIu32 " to %" PRIu32 "\n", seed, slots, id, cuts, lost, repeated, wear_min, wear_max);
+
+    free(model.id);
+}
+
+void application_init(void)
+{
+    char *text = getenv("SEED");
+    uint32_t seed = text != NULL ? strtoul(text, NULL, 10) : 1;
+    text = getenv("OPERATIONS");
+    int operations = text != NULL ? atoi(text) : OPERATIONS;
+    text = getenv("SLOTS");
+    int slots = text != NULL ? atoi(text) : SLOTS;
+    text = getenv("CUT_INTERVAL");
+    int cut_interval = text != NULL ? atoi(text) : CUT_INTERVAL;
+
+    if ((slots < 2) || ((size_t) slots * BC_EEPROM_LOG_SLOT_SIZE > bc_eeprom_get_size() - BC_RADIO_EEPROM_RESERVED) || (cut_interval < 1))
+    {
+        printf("Invalid SLOTS or CUT_INTERVAL\n");
+
+        exit(EXIT_FAILURE);
+    }
+
+    run(seed, operations, slots, cut_interval);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
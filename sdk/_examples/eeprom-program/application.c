@@ -0,0 +1,164 @@
+#define _GNU_SOURCE
+
+#include <application.h>
+#include <stdio.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+
+// Trap flag of x86 makes the core stop after the next instruction
+#define EFLAGS_TF 0x100
+
+// Program time of one word used by async write of bc_eeprom
+#define PROGRAM_TIME 4
+
+#define EEPROM_SIZE (DATA_EEPROM_BANK2_END - DATA_EEPROM_BASE + 1)
+
+#define EEPROM_PAGES ((EEPROM_SIZE + 0xfff) & ~0xfff)
+
+static volatile uint32_t program_count;
+
+static int failures;
+
+static uint8_t async_buffer[64];
+
+static bc_tick_t async_tick_start;
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        printf("FAIL %s\n", name);
+
+        failures++;
+    }
+}
+
+// Store to write protected EEPROM is one program operation, it is let through for one instruction
+static void segv_handler(int signal, siginfo_t *info, void *context)
+{
+    uintptr_t address = (uintptr_t) info->si_addr;
+
+    if ((address < DATA_EEPROM_BASE) || (address > DATA_EEPROM_BANK2_END))
+    {
+        (void) signal;
+
+        abort();
+    }
+
+    program_count++;
+
+    mprotect((void *) DATA_EEPROM_BASE, EEPROM_PAGES, PROT_READ | PROT_WRITE);
+
+    ((ucontext_t *) context)->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TF;
+}
+
+static void trap_handler(int signal, siginfo_t *info, void *context)
+{
+    (void) signal;
+    (void) info;
+
+    mprotect((void *) DATA_EEPROM_BASE, EEPROM_PAGES, PROT_READ);
+
+    ((ucontext_t *) context)->uc_mcontext.gregs[REG_EFL] &= ~EFLAGS_TF;
+}
+
+static void registers_map(void)
+{
+    struct sigaction action;
+
+    if ((mmap((void *) (FLASH_R_BASE & ~0xfff), 0x1000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) == MAP_FAILED) ||
+            (mmap((void *) DATA_EEPROM_BASE, EEPROM_PAGES, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) == MAP_FAILED))
+    {
+        printf("Cannot map FLASH registers and data EEPROM\n");
+
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&action, 0, sizeof(action));
+
+    action.sa_flags = SA_SIGINFO;
+
+    action.sa_sigaction = segv_handler;
+    sigaction(SIGSEGV, &action, NULL);
+
+    action.sa_sigaction = trap_handler;
+    sigaction(SIGTRAP, &action, NULL);
+}
+
+static void write_check(uint32_t address, const uint8_t *buffer, size_t length, uint32_t expected, const char *name)
+{
+    uint8_t read[64];
+
+    program_count = 0;
+
+    check(bc_eeprom_write(address, buffer, length), name);
+
+    check(bc_eeprom_read(address, read, length) && (memcmp(read, buffer, length) == 0), name);
+
+    printf("%-28s %2zu bytes at %4" PRIu32 ": %2" PRIu32 " programs\n", name, length, address, program_count);
+
+    check(program_count == expected, name);
+}
+
+static void async_event_handler(bc_eeprom_event_t event, void *event_param)
+{
+    (void) event_param;
+    uint8_t read[sizeof(async_buffer)];
+    bc_tick_t duration = bc_tick_get() - async_tick_start;
+
+    printf("%-28s %2zu bytes at %4d: %2" PRIu32 " programs in %" PRIu64 " ms\n", "async write", sizeof(async_buffer), 2, program_count, duration);
+
+    check(event == BC_EEPROM_EVENT_ASYNC_WRITE_DONE, "async write done");
+
+    check(bc_eeprom_read(2, read, sizeof(read)) && (memcmp(read, async_buffer, sizeof(read)) == 0), "async write data");
+
+    // Two bytes at each unaligned end and 15 words
+    check(program_count == 19, "async write programs");
+
+    // Task waits program time after each program operation
+    check(duration >= 18 * PROGRAM_TIME, "async write does not block");
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+void application_init(void)
+{
+    uint8_t buffer[24];
+
+    registers_map();
+
+    for (size_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = i + 1;
+    }
+
+    write_check(0, buffer, sizeof(buffer), 6, "aligned words");
+
+    write_check(0, buffer, sizeof(buffer), 0, "the same data again");
+
+    buffer[5] ^= 0xff;
+
+    write_check(0, buffer, sizeof(buffer), 1, "one changed byte");
+
+    write_check(101, buffer, sizeof(buffer), 9, "unaligned");
+
+    write_check(EEPROM_SIZE - 3, buffer, 3, 3, "bytes at end of EEPROM");
+
+    check(!bc_eeprom_write(EEPROM_SIZE - 2, buffer, 3), "write beyond EEPROM fails");
+
+    for (size_t i = 0; i < sizeof(async_buffer); i++)
+    {
+        async_buffer[i] = 0xa0 + i;
+    }
+
+    program_count = 0;
+
+    async_tick_start = bc_tick_get();
+
+    check(bc_eeprom_async_write(2, async_buffer, sizeof(async_buffer), async_event_handler, NULL), "async write");
+
+    check(!bc_eeprom_write(200, buffer, 4) && !bc_eeprom_async_write(200, buffer, 4, NULL, NULL), "write fails while async write runs");
+}
@@ -0,0 +1,7 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+#include <stm32l0xx.h>
+
+#endif // _APPLICATION_H
@@ -0,0 +1,179 @@
+#include <application.h>
+#include <stdio.h>
+#include <time.h>
+
+// Default number of bytes which go through FIFO in every test
+#define BYTES 100000000
+
+// Default size of FIFO buffer
+#define FIFO_SIZE 256
+
+// Default number of bytes written and read by one call
+#define CHUNK 64
+
+typedef struct
+{
+    const char *name;
+    size_t (*write)(bc_fifo_t *fifo, const void *buffer, size_t length);
+    size_t (*read)(bc_fifo_t *fifo, void *buffer, size_t length);
+
+} variant_t;
+
+// Sum of read bytes so that copying cannot be optimized out
+static uint32_t checksum;
+
+// Copy of bc_fifo_write before it copied contiguous spans, one byte per iteration with interrupts disabled
+static size_t bytewise_fifo_write(bc_fifo_t *fifo, const void *buffer, size_t length)
+{
+    bc_irq_disable();
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if ((fifo->head + 1) == fifo->tail)
+        {
+            bc_irq_enable();
+
+            return i;
+        }
+
+        if (((fifo->head + 1) == fifo->size) && (fifo->tail == 0))
+        {
+            bc_irq_enable();
+
+            return i;
+        }
+
+        *((uint8_t *) fifo->buffer + fifo->head) = *(uint8_t *) buffer;
+
+        buffer = (uint8_t *) buffer + 1;
+
+        fifo->head++;
+
+        if (fifo->head == fifo->size)
+        {
+            fifo->head = 0;
+        }
+    }
+
+    bc_irq_enable();
+
+    return length;
+}
+
+// Copy of bc_fifo_read before it copied contiguous spans
+static size_t bytewise_fifo_read(bc_fifo_t *fifo, void *buffer, size_t length)
+{
+    bc_irq_disable();
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (fifo->tail != fifo->head)
+        {
+            *(uint8_t *) buffer = *((uint8_t *) fifo->buffer + fifo->tail);
+
+            buffer = (uint8_t *) buffer + 1;
+
+            fifo->tail++;
+
+            if (fifo->tail == fifo->size)
+            {
+                fifo->tail = 0;
+            }
+        }
+        else
+        {
+            bc_irq_enable();
+
+            return i;
+        }
+    }
+
+    bc_irq_enable();
+
+    return length;
+}
+
+static const variant_t variants[] =
+{
+    { "bytewise", bytewise_fifo_write, bytewise_fifo_read },
+    { "bc_fifo", bc_fifo_write, bc_fifo_read },
+};
+
+static size_t getenv_size(const char *name, size_t value)
+{
+    const char *text = getenv(name);
+
+    return text != NULL ? (size_t) atol(text) : value;
+}
+
+static void run(const variant_t *variant, size_t bytes, size_t fifo_size, size_t write_chunk, size_t read_chunk)
+{
+    uint8_t *storage = malloc(fifo_size);
+    uint8_t source[CHUNK * 4];
+    uint8_t destination[CHUNK * 4];
+    bc_fifo_t fifo;
+    size_t done = 0;
+    size_t offset = 0;
+
+    for (size_t i = 0; i < sizeof(source); i++)
+    {
+        source[i] = i * 13;
+    }
+
+    bc_fifo_init(&fifo, storage, fifo_size);
+
+    bc_host_irq_reset_stats();
+
+    clock_t start = clock();
+
+    // Writer and reader take turns, the FIFO never stays full or empty for long
+    while (done < bytes)
+    {
+        offset += variant->write(&fifo, source + offset % CHUNK, write_chunk);
+
+        size_t length;
+
+        while ((length = variant->read(&fifo, destination, read_chunk)) != 0)
+        {
+            checksum += destination[length - 1];
+
+            done += length;
+        }
+    }
+
+    double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    bc_host_irq_stats_t stats;
+
+    bc_host_irq_get_stats(&stats);
+
+    printf("%-9s write %3zu read %3zu: %7.1f MB/s, %" PRIu32 " masked windows, %.1f ns each (checksum %08x)\n",
+           variant->name, write_chunk, read_chunk, done / elapsed / 1e6, stats.count, (double) stats.total / stats.count, checksum);
+
+    free(storage);
+}
+
+void application_init(void)
+{
+    size_t bytes = getenv_size("BYTES", BYTES);
+    size_t fifo_size = getenv_size("SIZE", FIFO_SIZE);
+    size_t chunk = getenv_size("CHUNK", CHUNK);
+
+    if ((chunk < 1) || (chunk > CHUNK * 3))
+    {
+        fprintf(stderr, "CHUNK must be from 1 to %d\n", CHUNK * 3);
+
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < sizeof(variants) / sizeof(variants[0]); i++)
+    {
+        // Bulk transfer (e.g. UART or radio data)
+        run(&variants[i], bytes, fifo_size, chunk, chunk);
+
+        // Reader takes one byte per call as bc_usb_cdc_read does
+        run(&variants[i], bytes / 10, fifo_size, chunk, 1);
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,153 @@
+#define _DEFAULT_SOURCE
+
+#include <application.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+// Default number of bytes which go through FIFO
+#define BYTES 200000000
+
+// Default size of FIFO buffer (small size makes head and tail meet often)
+#define FIFO_SIZE 61
+
+// Maximum number of bytes written or read by one call
+#define MAX_CHUNK 97
+
+static bc_fifo_t fifo;
+
+static size_t bytes;
+
+// Every byte of stream is derived from its position so that consumer can check it
+static inline uint8_t stream_byte(size_t position)
+{
+    return position * 31 + (position >> 9);
+}
+
+// Lengths of calls vary so that copies wrap around the end of buffer at every position
+static inline size_t chunk_length(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return 1 + *state % MAX_CHUNK;
+}
+
+static void *producer(void *param)
+{
+    (void) param;
+
+    uint8_t buffer[MAX_CHUNK];
+    uint32_t state = 1;
+    size_t position = 0;
+
+    while (position < bytes)
+    {
+        size_t length = chunk_length(&state);
+
+        if (length > bytes - position)
+        {
+            length = bytes - position;
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            buffer[i] = stream_byte(position + i);
+        }
+
+        // Bytes which do not fit are offered again with the next call
+        size_t written = bc_fifo_spsc_write(&fifo, buffer, length);
+
+        // Consumer gets the CPU when there is only one
+        if (written == 0)
+        {
+            sched_yield();
+        }
+
+        position += written;
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *param)
+{
+    size_t *errors = param;
+    uint8_t buffer[MAX_CHUNK];
+    uint32_t state = 2;
+    size_t position = 0;
+
+    while (position < bytes)
+    {
+        size_t length = bc_fifo_spsc_read(&fifo, buffer, chunk_length(&state));
+
+        if (length == 0)
+        {
+            sched_yield();
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            if (buffer[i] != stream_byte(position + i))
+            {
+                if (*errors == 0)
+                {
+                    fprintf(stderr, "byte %zu is %02x instead of %02x\n", position + i, buffer[i], stream_byte(position + i));
+                }
+
+                (*errors)++;
+            }
+        }
+
+        position += length;
+    }
+
+    return NULL;
+}
+
+void application_init(void)
+{
+    const char *text = getenv("BYTES");
+    bytes = text != NULL ? (size_t) atol(text) : BYTES;
+    text = getenv("SIZE");
+    size_t size = text != NULL ? (size_t) atol(text) : FIFO_SIZE;
+    size_t errors = 0;
+    pthread_t threads[2];
+    struct timespec start;
+    struct timespec end;
+
+    if (size < 2)
+    {
+        fprintf(stderr, "SIZE must be at least 2\n");
+
+        exit(EXIT_FAILURE);
+    }
+
+    bc_fifo_init(&fifo, malloc(size), size);
+
+    bc_host_irq_reset_stats();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pthread_create(&threads[0], NULL, producer, NULL);
+    pthread_create(&threads[1], NULL, consumer, &errors);
+
+    pthread_join(threads[0], NULL);
+    pthread_join(threads[1], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    bc_host_irq_stats_t stats;
+
+    bc_host_irq_get_stats(&stats);
+
+    printf("%zu bytes through FIFO of %zu bytes in %.3f s (%.1f MB/s), %zu corrupted, %" PRIu32 " masked windows\n",
+           bytes, size, elapsed, bytes / elapsed / 1e6, errors, stats.count);
+
+    // Neither side may disable interrupts and the FIFO has to be empty at the end
+    exit((errors == 0) && (stats.count == 0) && bc_fifo_is_empty(&fifo) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,8 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+#include <bc_fifo.h>
+#include <bc_host.h>
+
+#endif // _APPLICATION_H
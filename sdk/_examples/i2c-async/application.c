@@ -0,0 +1,656 @@
+#define _DEFAULT_SOURCE
+
+#include <application.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+
+// TXDR holds a value which does not fit in byte until driver writes data
+#define TXDR_EMPTY 0x100
+
+// Time given to every step of the test
+#define STEP_INTERVAL 200
+
+// Clock stretching of device in timeout step (timeout of short transfer is 15 ms)
+#define STRETCH 40
+
+#define DEVICE_MEMORY_SIZE 512
+
+typedef struct
+{
+    bc_i2c_channel_t channel;
+    uint8_t address;
+    size_t address_length;
+    bc_tick_t stretch;
+    uint8_t memory[DEVICE_MEMORY_SIZE];
+    uint16_t pointer;
+    size_t received;
+
+} device_t;
+
+typedef struct
+{
+    I2C_TypeDef *i2c;
+    IRQn_Type irqn;
+    void (*irq_handler)(void);
+    bc_i2c_channel_t channel;
+    bool active;
+    device_t *device;
+    bc_tick_t tick_release;
+
+} bus_t;
+
+typedef struct request_t
+{
+    int id;
+    bc_i2c_channel_t channel;
+    uint8_t address;
+    uint32_t memory_address;
+    uint8_t buffer[4];
+    size_t length;
+    bool read;
+    bc_i2c_event_t expected;
+    uint8_t data[4];
+    bool done;
+    bc_i2c_event_t event;
+    bc_tick_t tick_request;
+    bc_tick_t tick_event;
+    struct request_t *next;
+
+} request_t;
+
+void I2C1_IRQHandler(void);
+
+void I2C2_IRQHandler(void);
+
+// Devices present on the buses, missing addresses are NACKed
+static device_t device_table[] =
+{
+    { .channel = BC_I2C_I2C0, .address = 0x40, .address_length = 1 },
+    { .channel = BC_I2C_I2C0, .address = 0x41, .address_length = 1 },
+    { .channel = BC_I2C_I2C0, .address = 0x50, .address_length = 2 },
+    { .channel = BC_I2C_I2C1, .address = 0x40, .address_length = 1 }
+};
+
+static bus_t bus_table[] =
+{
+    { .i2c = I2C2, .irqn = I2C2_IRQn, .irq_handler = I2C2_IRQHandler, .channel = BC_I2C_I2C0 },
+    { .i2c = I2C1, .irqn = I2C1_IRQn, .irq_handler = I2C1_IRQHandler, .channel = BC_I2C_I2C1 }
+};
+
+static request_t *order[16];
+static int order_length;
+static int failures;
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        printf("FAIL %s\n", name);
+
+        failures++;
+    }
+}
+
+static device_t *device_find(bc_i2c_channel_t channel, uint8_t address)
+{
+    for (size_t i = 0; i < sizeof(device_table) / sizeof(device_table[0]); i++)
+    {
+        if ((device_table[i].channel == channel) && (device_table[i].address == address))
+        {
+            return &device_table[i];
+        }
+    }
+
+    return NULL;
+}
+
+// Bytes of write set register pointer first, then they are stored from it
+static void device_write(device_t *device, uint8_t value)
+{
+    if (device->received < device->address_length)
+    {
+        device->pointer = device->received == 0 ? value : (device->pointer << 8) | value;
+    }
+    else
+    {
+        device->memory[device->pointer++ % DEVICE_MEMORY_SIZE] = value;
+    }
+
+    device->received++;
+}
+
+static uint8_t device_read(device_t *device)
+{
+    return device->memory[device->pointer++ % DEVICE_MEMORY_SIZE];
+}
+
+static uint32_t bus_interrupt_enable(uint32_t flag)
+{
+    switch (flag)
+    {
+        case I2C_ISR_TXIS:
+        {
+            return I2C_CR1_TXIE;
+        }
+        case I2C_ISR_RXNE:
+        {
+            return I2C_CR1_RXIE;
+        }
+        case I2C_ISR_TC:
+        {
+            return I2C_CR1_TCIE;
+        }
+        case I2C_ISR_NACKF:
+        {
+            return I2C_CR1_NACKIE;
+        }
+        case I2C_ISR_STOPF:
+        default:
+        {
+            return I2C_CR1_STOPIE;
+        }
+    }
+}
+
+// Flag is set by peripheral, false is returned if core does not take the interrupt
+static bool bus_raise(bus_t *bus, uint32_t flag)
+{
+    I2C_TypeDef *i2c = bus->i2c;
+
+    i2c->ISR |= flag;
+
+    if (((i2c->CR1 & bus_interrupt_enable(flag)) == 0) || ((NVIC->ISER[0] & (1UL << bus->irqn)) == 0))
+    {
+        return false;
+    }
+
+    bus->irq_handler();
+
+    // Bits of ICR clear the same bits of ISR
+    i2c->ISR &= ~i2c->ICR;
+    i2c->ICR = 0;
+
+    return true;
+}
+
+// Runs phases of transfer until STOP, transfer which is not served by interrupt is left to driver timeout
+static void bus_transfer(bus_t *bus)
+{
+    I2C_TypeDef *i2c = bus->i2c;
+
+    while (true)
+    {
+        bool read = (i2c->CR2 & I2C_CR2_RD_WRN) != 0;
+        size_t length = (i2c->CR2 & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos;
+        device_t *device = bus->device;
+
+        if (device == NULL)
+        {
+            if (!bus_raise(bus, I2C_ISR_NACKF))
+            {
+                return;
+            }
+
+            // STOP follows NACK in AUTOEND mode, otherwise it is requested by software
+            if (((i2c->CR2 & I2C_CR2_AUTOEND) == 0) && ((i2c->CR2 & I2C_CR2_STOP) == 0))
+            {
+                return;
+            }
+
+            i2c->CR2 &= ~I2C_CR2_STOP;
+
+            bus_raise(bus, I2C_ISR_STOPF);
+
+            return;
+        }
+
+        if (!read)
+        {
+            device->received = 0;
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            if (read)
+            {
+                i2c->RXDR = device_read(device);
+
+                if (!bus_raise(bus, I2C_ISR_RXNE))
+                {
+                    return;
+                }
+
+                // Flag is cleared by reading RXDR
+                i2c->ISR &= ~I2C_ISR_RXNE;
+            }
+            else
+            {
+                i2c->TXDR = TXDR_EMPTY;
+
+                if (!bus_raise(bus, I2C_ISR_TXIS) || (i2c->TXDR == TXDR_EMPTY))
+                {
+                    return;
+                }
+
+                // Flag is cleared by writing TXDR
+                i2c->ISR &= ~I2C_ISR_TXIS;
+
+                device_write(device, i2c->TXDR);
+            }
+        }
+
+        if ((i2c->CR2 & I2C_CR2_AUTOEND) != 0)
+        {
+            bus_raise(bus, I2C_ISR_STOPF);
+
+            return;
+        }
+
+        if (!bus_raise(bus, I2C_ISR_TC))
+        {
+            return;
+        }
+
+        if ((i2c->CR2 & I2C_CR2_START) == 0)
+        {
+            if ((i2c->CR2 & I2C_CR2_STOP) != 0)
+            {
+                i2c->CR2 &= ~I2C_CR2_STOP;
+
+                bus_raise(bus, I2C_ISR_STOPF);
+            }
+
+            return;
+        }
+
+        // Repeated start clears TC
+        i2c->CR2 &= ~I2C_CR2_START;
+        i2c->ISR &= ~I2C_ISR_TC;
+
+        bus->device = device_find(bus->channel, (i2c->CR2 & I2C_CR2_SADD) >> 1);
+    }
+}
+
+static void bus_run(bus_t *bus)
+{
+    I2C_TypeDef *i2c = bus->i2c;
+
+    i2c->ISR &= ~i2c->ICR;
+    i2c->ICR = 0;
+
+    while ((i2c->CR1 & I2C_CR1_PE) != 0)
+    {
+        // START while device still stretches clock means that driver has reset peripheral and given up the transfer
+        if ((i2c->CR2 & I2C_CR2_START) != 0)
+        {
+            i2c->CR2 &= ~I2C_CR2_START;
+
+            bus->device = device_find(bus->channel, (i2c->CR2 & I2C_CR2_SADD) >> 1);
+
+            bus->tick_release = bc_tick_get() + (bus->device != NULL ? bus->device->stretch : 0);
+
+            bus->active = true;
+        }
+
+        if (!bus->active || (bc_tick_get() < bus->tick_release))
+        {
+            return;
+        }
+
+        bus->active = false;
+
+        bus_transfer(bus);
+    }
+}
+
+// Peripherals are served once per scheduler spin, every spin advances simulated time by one RTC wake-up period
+static void bus_task(void *param)
+{
+    (void) param;
+
+    for (size_t i = 0; i < sizeof(bus_table) / sizeof(bus_table[0]); i++)
+    {
+        bus_run(&bus_table[i]);
+    }
+
+    bc_scheduler_plan_current_now();
+}
+
+static void registers_map(void)
+{
+    static const uintptr_t page_table[] = { I2C1_BASE, RCC_BASE, GPIOB_BASE, SCS_BASE };
+
+    for (size_t i = 0; i < sizeof(page_table) / sizeof(page_table[0]); i++)
+    {
+        void *page = (void *) (page_table[i] & ~(uintptr_t) 0xfff);
+
+        if (mmap(page, 0x1000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != page)
+        {
+            printf("Cannot map registers at %p\n", page);
+
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Pins read high, so bus restore does not wait for released SDA
+    GPIOB->IDR = 0xffff;
+}
+
+static void event_handler(bc_i2c_event_t event, void *event_param);
+
+static bool submit(request_t *request)
+{
+    request->done = false;
+    request->tick_request = bc_tick_get();
+
+    if (request->memory_address != 0)
+    {
+        bc_i2c_memory_transfer_t transfer = { .device_address = request->address, .memory_address = request->memory_address, .buffer = request->buffer, .length = request->length };
+
+        if (request->read)
+        {
+            return bc_i2c_async_memory_read(request->channel, &transfer, event_handler, request);
+        }
+
+        return bc_i2c_async_memory_write(request->channel, &transfer, event_handler, request);
+    }
+
+    bc_i2c_transfer_t transfer = { .device_address = request->address, .buffer = request->buffer, .length = request->length };
+
+    if (request->read)
+    {
+        return bc_i2c_async_read(request->channel, &transfer, event_handler, request);
+    }
+
+    return bc_i2c_async_write(request->channel, &transfer, event_handler, request);
+}
+
+static void event_handler(bc_i2c_event_t event, void *event_param)
+{
+    request_t *request = event_param;
+
+    request->done = true;
+    request->event = event;
+    request->tick_event = bc_tick_get();
+
+    if (order_length < (int) (sizeof(order) / sizeof(order[0])))
+    {
+        order[order_length++] = request;
+    }
+
+    // Transfer queued from event handler joins the running batch
+    if (request->next != NULL)
+    {
+        check(submit(request->next), "submit from event handler");
+    }
+}
+
+static void order_check(request_t *request_table, int count, const int *expected, const char *name)
+{
+    bool ok = order_length == count;
+
+    printf("%-8s", name);
+
+    for (int i = 0; i < order_length; i++)
+    {
+        printf(" %d%s", order[i]->id, order[i]->event == BC_I2C_EVENT_DONE ? "" : "(error)");
+
+        ok = ok && (order[i]->id == expected[i]);
+    }
+
+    printf("\n");
+
+    check(ok, name);
+
+    for (int i = 0; i < count; i++)
+    {
+        request_t *request = &request_table[i];
+
+        check(request->done && (request->event == request->expected), "event of transfer");
+
+        if (request->done && (request->expected == BC_I2C_EVENT_DONE) && request->read)
+        {
+            check(memcmp(request->buffer, request->data, request->length) == 0, "data of transfer");
+        }
+    }
+
+    order_length = 0;
+}
+
+// Mixed transfers, one of them to missing device, are delivered in submission order
+static request_t order_table[] =
+{
+    { .id = 0, .address = 0x40, .memory_address = 0x01, .buffer = { 0x11, 0x22 }, .length = 2 },
+    { .id = 1, .address = 0x40, .memory_address = 0x01, .length = 2, .read = true, .data = { 0x11, 0x22 }, .next = &order_table[8] },
+    { .id = 2, .address = 0x41, .buffer = { 0x05 }, .length = 1 },
+    { .id = 3, .address = 0x41, .length = 2, .read = true, .data = { 0x55, 0x66 } },
+    { .id = 4, .address = 0x51, .memory_address = 0x01, .length = 1, .read = true, .expected = BC_I2C_EVENT_ERROR },
+    { .id = 5, .address = 0x50, .memory_address = 0x0123 | BC_I2C_MEMORY_ADDRESS_16_BIT, .buffer = { 0xa5 }, .length = 1 },
+    { .id = 6, .address = 0x50, .memory_address = 0x0123 | BC_I2C_MEMORY_ADDRESS_16_BIT, .length = 1, .read = true, .data = { 0xa5 } },
+    { .id = 7, .address = 0x40, .length = 0 },
+    { .id = 8, .address = 0x40, .memory_address = 0x02, .length = 1, .read = true, .data = { 0x22 } }
+};
+
+// Transfer to stretching device times out and the next one succeeds
+static request_t timeout_table[] =
+{
+    { .id = 0, .address = 0x41, .length = 1, .read = true, .expected = BC_I2C_EVENT_ERROR },
+    { .id = 1, .address = 0x40, .memory_address = 0x01, .length = 2, .read = true, .data = { 0x11, 0x22 } },
+    { .id = 2, .channel = BC_I2C_I2C1, .address = 0x40, .memory_address = 0x03, .length = 1, .read = true, .data = { 0x77 } }
+};
+
+// Device which has stretched is accessible again after bus restore
+static request_t recover_table[] =
+{
+    { .id = 0, .address = 0x41, .length = 1, .read = true, .data = { 0x55 } }
+};
+
+// Queued as low, normal, high, normal, missing and high priority device
+static request_t priority_table[] =
+{
+    { .id = 0, .address = 0x50, .memory_address = 0x0123 | BC_I2C_MEMORY_ADDRESS_16_BIT, .length = 1, .read = true, .data = { 0xa5 } },
+    { .id = 1, .address = 0x41, .length = 1, .read = true, .data = { 0x55 } },
+    { .id = 2, .address = 0x40, .memory_address = 0x01, .length = 1, .read = true, .data = { 0x11 } },
+    { .id = 3, .address = 0x41, .length = 1, .read = true, .data = { 0x66 } },
+    { .id = 4, .address = 0x52, .length = 1, .read = true, .expected = BC_I2C_EVENT_ERROR },
+    { .id = 5, .address = 0x40, .memory_address = 0x02, .length = 1, .read = true, .data = { 0x22 } }
+};
+
+void bc_ds28e17_init(bc_ds28e17_t *self, bc_gpio_channel_t channel, uint64_t device_number)
+{
+    (void) self;
+    (void) channel;
+    (void) device_number;
+}
+
+bool bc_ds28e17_set_speed(bc_ds28e17_t *self, bc_i2c_speed_t speed)
+{
+    (void) self;
+    (void) speed;
+
+    return false;
+}
+
+bool bc_ds28e17_write(bc_ds28e17_t *self, const bc_i2c_transfer_t *transfer)
+{
+    (void) self;
+    (void) transfer;
+
+    return false;
+}
+
+bool bc_ds28e17_read(bc_ds28e17_t *self, const bc_i2c_transfer_t *transfer)
+{
+    (void) self;
+    (void) transfer;
+
+    return false;
+}
+
+bool bc_ds28e17_memory_write(bc_ds28e17_t *self, const bc_i2c_memory_transfer_t *transfer)
+{
+    (void) self;
+    (void) transfer;
+
+    return false;
+}
+
+bool bc_ds28e17_memory_read(bc_ds28e17_t *self, const bc_i2c_memory_transfer_t *transfer)
+{
+    (void) self;
+    (void) transfer;
+
+    return false;
+}
+
+bool bc_module_sensor_init(void)
+{
+    return true;
+}
+
+bool bc_module_sensor_set_pull(bc_module_sensor_channel_t channel, bc_module_sensor_pull_t pull)
+{
+    (void) channel;
+    (void) pull;
+
+    return true;
+}
+
+// Host library attaches ATSHA204 of radio medium through these, radio is not used here
+bool bc_host_i2c_attach(bc_i2c_channel_t channel, uint8_t device_address, bool (*handler)(bc_host_i2c_operation_t, uint32_t, void *, size_t, void *), void *param)
+{
+    (void) channel;
+    (void) device_address;
+    (void) handler;
+    (void) param;
+
+    return false;
+}
+
+bool bc_host_i2c_set_delay(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t delay)
+{
+    (void) channel;
+    (void) device_address;
+    (void) delay;
+
+    return false;
+}
+
+void application_init(void)
+{
+    registers_map();
+
+    device_table[1].memory[5] = 0x55;
+    device_table[1].memory[6] = 0x66;
+    device_table[3].memory[3] = 0x77;
+
+    bc_i2c_init(BC_I2C_I2C0, BC_I2C_SPEED_400_KHZ);
+    bc_i2c_init(BC_I2C_I2C1, BC_I2C_SPEED_400_KHZ);
+
+    bc_scheduler_register(bus_task, NULL, 0);
+}
+
+void application_task(void *param)
+{
+    (void) param;
+
+    static int step;
+
+    switch (step++)
+    {
+        case 0:
+        {
+            // The last transfer is submitted from event handler
+            for (size_t i = 0; i < sizeof(order_table) / sizeof(order_table[0]) - 1; i++)
+            {
+                check(submit(&order_table[i]), "submit");
+            }
+
+            request_t overflow = { .address = 0x40, .length = 1 };
+
+            check(!submit(&overflow), "full queue refuses transfer");
+
+            break;
+        }
+        case 1:
+        {
+            static const int expected[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+
+            order_check(order_table, sizeof(order_table) / sizeof(order_table[0]), expected, "order");
+
+            device_table[1].stretch = STRETCH;
+
+            for (size_t i = 0; i < sizeof(timeout_table) / sizeof(timeout_table[0]); i++)
+            {
+                check(submit(&timeout_table[i]), "submit");
+            }
+
+            break;
+        }
+        case 2:
+        {
+            // Transfer of the other channel is not held up
+            static const int expected[] = { 2, 0, 1 };
+
+            order_check(timeout_table, sizeof(timeout_table) / sizeof(timeout_table[0]), expected, "timeout");
+
+            bc_tick_t latency = timeout_table[0].tick_event - timeout_table[0].tick_request;
+
+            printf("timeout  error after %" PRIu64 " ms, device stretches for %d ms\n", latency, STRETCH);
+
+            check((latency >= 15) && (latency < STRETCH), "error at timeout");
+
+            device_table[1].stretch = 0;
+            device_table[1].pointer = 5;
+
+            check(submit(&recover_table[0]), "submit");
+
+            break;
+        }
+        case 3:
+        {
+            static const int expected[] = { 0 };
+
+            order_check(recover_table, sizeof(recover_table) / sizeof(recover_table[0]), expected, "recover");
+
+            bc_i2c_set_device_priority(BC_I2C_I2C0, 0x40, BC_I2C_PRIORITY_HIGH);
+            bc_i2c_set_device_priority(BC_I2C_I2C0, 0x50, BC_I2C_PRIORITY_LOW);
+
+            device_table[1].pointer = 5;
+
+            for (size_t i = 0; i < sizeof(priority_table) / sizeof(priority_table[0]); i++)
+            {
+                check(submit(&priority_table[i]), "submit");
+            }
+
+            break;
+        }
+        default:
+        {
+            static const int expected[] = { 2, 5, 1, 3, 4, 0 };
+            bc_i2c_device_stats_t stats;
+
+            order_check(priority_table, sizeof(priority_table) / sizeof(priority_table[0]), expected, "priority");
+
+            // Next transfer is started from interrupt of the previous one, so the batch is done within one spin
+            for (size_t i = 1; i < sizeof(priority_table) / sizeof(priority_table[0]); i++)
+            {
+                check(priority_table[i].tick_event == priority_table[0].tick_event, "batch in one spin");
+            }
+
+            check(bc_i2c_get_device_stats(BC_I2C_I2C0, 0x52, &stats) && (stats.transfer_count == 1) && (stats.error_count == 1), "statistics of missing device");
+
+            // Two transfers of order step, timed out one, recovery and two of priority step
+            check(bc_i2c_get_device_stats(BC_I2C_I2C0, 0x41, &stats) && (stats.transfer_count == 6) && (stats.error_count == 1), "statistics of stretching device");
+
+            printf("stats    0x41: %" PRIu32 " transfers, %" PRIu32 " errors, latency max %" PRIu64 " ms\n", stats.transfer_count, stats.error_count, stats.latency_max);
+
+            printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+
+            exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+    }
+
+    bc_scheduler_plan_current_relative(STEP_INTERVAL);
+}
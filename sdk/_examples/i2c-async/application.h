@@ -0,0 +1,10 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+#include <bc_host.h>
+#include <bc_ds28e17.h>
+#include <bc_module_sensor.h>
+#include <stm32l0xx.h>
+
+#endif // _APPLICATION_H
@@ -0,0 +1,230 @@
+#include <application.h>
+#include <stdio.h>
+#include <time.h>
+
+// Default number of passes over the workload
+#define PASSES 100000
+
+// Default size of queue, the same as queues of bc_radio
+#define QUEUE_SIZE 128
+
+// Number of item lengths in the workload
+#define WORKLOAD_LENGTH 8
+
+// Number of items put to full queue in every pass, the oldest items are taken to make room for them
+#define STEADY 32
+
+// Queue which moves remaining items to the start of buffer after every get (bc_queue did so before ring buffer)
+typedef struct
+{
+    uint8_t *buffer;
+    size_t size;
+    size_t length;
+
+} memmove_queue_t;
+
+static const size_t workload[WORKLOAD_LENGTH] = { 12, 30, 7, 45, 20, 9, 33, 16 };
+
+// Sum of dequeued bytes so that copying cannot be optimized out
+static uint32_t checksum;
+
+// Number of bytes moved by memmove, it does not depend on speed of host
+static long moved;
+
+// Number of items taken from start of buffer after the end of buffer was skipped (bc_queue only)
+static long wrapped;
+
+// Item taken last from bc_queue, to find items which wrapped
+static const uint8_t *last;
+
+static uint8_t item[BC_RADIO_MAX_BUFFER_SIZE];
+
+static void memmove_queue_init(memmove_queue_t *queue, void *buffer, size_t size)
+{
+    queue->buffer = buffer;
+    queue->size = size;
+    queue->length = 0;
+}
+
+static bool memmove_queue_put(memmove_queue_t *queue, const void *buffer, size_t length)
+{
+    if (sizeof(length) + length > queue->size - queue->length)
+    {
+        return false;
+    }
+
+    memcpy(queue->buffer + queue->length, &length, sizeof(length));
+
+    memcpy(queue->buffer + queue->length + sizeof(length), buffer, length);
+
+    queue->length += sizeof(length) + length;
+
+    return true;
+}
+
+static bool memmove_queue_get(memmove_queue_t *queue, void *buffer, size_t *length)
+{
+    if (queue->length == 0)
+    {
+        return false;
+    }
+
+    memcpy(length, queue->buffer, sizeof(*length));
+
+    memcpy(buffer, queue->buffer + sizeof(*length), *length);
+
+    queue->length -= sizeof(*length) + *length;
+
+    memmove(queue->buffer, queue->buffer + sizeof(*length) + *length, queue->length);
+
+    moved += queue->length;
+
+    return true;
+}
+
+static bool memmove_queue_put_item(void *queue, size_t length)
+{
+    return memmove_queue_put(queue, item, length);
+}
+
+static bool bc_queue_put_item(void *queue, size_t length)
+{
+    return bc_queue_put(queue, item, length);
+}
+
+static void memmove_queue_take(void *queue)
+{
+    size_t length;
+
+    if (!memmove_queue_get(queue, item, &length))
+    {
+        return;
+    }
+
+    checksum += item[length - 1] + length;
+}
+
+static void bc_queue_take(void *queue)
+{
+    size_t length;
+
+    if (!bc_queue_get(queue, item, &length))
+    {
+        return;
+    }
+
+    checksum += item[length - 1] + length;
+}
+
+// Item is used in place as bc_radio does with received frames
+static void bc_queue_take_in_place(void *queue)
+{
+    const void *pointer;
+    size_t length;
+
+    if (!bc_queue_peek(queue, &pointer, &length))
+    {
+        return;
+    }
+
+    checksum += ((const uint8_t *) pointer)[length - 1] + length;
+
+    wrapped += (const uint8_t *) pointer < last ? 1 : 0;
+
+    last = pointer;
+
+    bc_queue_remove(queue);
+}
+
+// Every pass fills queue as far as it goes, puts more items as the oldest ones are taken and then empties it
+static void run(const char *name, long passes, void *queue, bool (*put)(void *, size_t), void (*take)(void *))
+{
+    long items = 0;
+    int high_water = 0;
+
+    clock_t start = clock();
+
+    for (long pass = 0; pass < passes; pass++)
+    {
+        int count = 0;
+
+        while (put(queue, workload[(pass + count) % WORKLOAD_LENGTH]))
+        {
+            count++;
+        }
+
+        high_water = count > high_water ? count : high_water;
+
+        for (int i = 0; i < STEADY; i++)
+        {
+            while (!put(queue, workload[(pass + i) % WORKLOAD_LENGTH]))
+            {
+                take(queue);
+
+                count--;
+                items++;
+            }
+
+            count++;
+        }
+
+        items += count;
+
+        while (count-- != 0)
+        {
+            take(queue);
+        }
+
+        last = NULL;
+    }
+
+    double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%-13s %ld items in %.3f s, %.1f ns per put and get, up to %d items queued (checksum %08x)\n",
+           name, items, elapsed, elapsed * 1e9 / items, high_water, checksum);
+
+    if (moved != 0)
+    {
+        printf("%-13s %.1f bytes moved per get\n", "", (double) moved / items);
+    }
+
+    if (wrapped != 0)
+    {
+        printf("%-13s %.1f %% of items wrapped around end of buffer\n", "", 100. * wrapped / items);
+    }
+
+    checksum = 0;
+    moved = 0;
+    wrapped = 0;
+}
+
+void application_init(void)
+{
+    const char *text = getenv("PASSES");
+    long passes = text != NULL ? atol(text) : PASSES;
+    text = getenv("SIZE");
+    size_t size = text != NULL ? (size_t) atol(text) : QUEUE_SIZE;
+    uint8_t *storage = malloc(size);
+    memmove_queue_t memmove_queue;
+    bc_queue_t queue;
+
+    for (size_t i = 0; i < sizeof(item); i++)
+    {
+        item[i] = i * 7;
+    }
+
+    // The same items are moved by all variants
+    memmove_queue_init(&memmove_queue, storage, size);
+
+    run("memmove", passes, &memmove_queue, memmove_queue_put_item, memmove_queue_take);
+
+    bc_queue_init(&queue, storage, size);
+
+    run("bc_queue", passes, &queue, bc_queue_put_item, bc_queue_take);
+
+    bc_queue_init(&queue, storage, size);
+
+    run("bc_queue peek", passes, &queue, bc_queue_put_item, bc_queue_take_in_place);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,7 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+#include <bc_queue.h>
+
+#endif // _APPLICATION_H
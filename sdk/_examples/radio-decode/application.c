@@ -0,0 +1,181 @@
+#include <application.h>
+#include <stdio.h>
+#include <time.h>
+
+// Default number of passes over the trace
+#define PASSES 100000
+
+// Number of frames in the trace
+#define TRACE_LENGTH 16
+
+typedef struct
+{
+    uint8_t buffer[BC_RADIO_MAX_BUFFER_SIZE];
+    size_t length;
+
+} frame_t;
+
+static frame_t trace[TRACE_LENGTH];
+
+// Sum of decoded values so that decoding cannot be optimized out
+static uint32_t checksum;
+
+static uint32_t received_custom;
+
+void bc_radio_pub_on_event_count(uint64_t *id, uint8_t event_id, uint16_t *event_count) { (void) id; checksum += event_id + *event_count; }
+void bc_radio_pub_on_temperature(uint64_t *id, uint8_t channel, float *celsius) { (void) id; checksum += channel + (uint32_t) *celsius; }
+void bc_radio_pub_on_humidity(uint64_t *id, uint8_t channel, float *percentage) { (void) id; checksum += channel + (uint32_t) *percentage; }
+void bc_radio_pub_on_lux_meter(uint64_t *id, uint8_t channel, float *illuminance) { (void) id; checksum += channel + (uint32_t) *illuminance; }
+void bc_radio_pub_on_barometer(uint64_t *id, uint8_t channel, float *pressure, float *altitude) { (void) id; checksum += channel + (uint32_t) *pressure + (uint32_t) *altitude; }
+void bc_radio_pub_on_battery(uint64_t *id, float *voltage) { (void) id; checksum += (uint32_t) (*voltage * 100); }
+void bc_radio_pub_on_state(uint64_t *id, uint8_t state_id, bool *state) { (void) id; checksum += state_id + (state != NULL && *state); }
+void bc_radio_pub_on_int(uint64_t *id, char *subtopic, int *value) { (void) id; checksum += subtopic[0] + *value; }
+void bc_radio_pub_on_float(uint64_t *id, char *subtopic, float *value) { (void) id; checksum += subtopic[0] + (uint32_t) *value; }
+void bc_radio_pub_on_string(uint64_t *id, char *subtopic, char *value) { (void) id; checksum += subtopic[0] + value[0]; }
+void bc_radio_node_on_state_set(uint64_t *id, uint8_t state_id, bool *state) { (void) id; checksum += state_id + (state != NULL && *state); }
+void bc_radio_node_on_led_strip_color_set(uint64_t *id, uint32_t *color) { (void) id; checksum += *color; }
+
+static void custom_handler(uint64_t *id, const uint8_t *buffer, size_t length, void *param)
+{
+    (void) id;
+    (void) param;
+
+    checksum += buffer[0] + length;
+
+    received_custom++;
+}
+
+static void trace_add(const void *buffer, size_t length)
+{
+    static int i;
+
+    memcpy(trace[i].buffer, buffer, length);
+
+    trace[i++].length = length;
+}
+
+static void trace_add_float(uint8_t header, uint8_t channel, float value)
+{
+    uint8_t buffer[2 + sizeof(float)] = { header, channel };
+
+    memcpy(buffer + 2, &value, sizeof(value));
+
+    trace_add(buffer, sizeof(buffer));
+}
+
+static void trace_add_topic_int(const char *subtopic, int value)
+{
+    uint8_t buffer[BC_RADIO_MAX_BUFFER_SIZE] = { BC_RADIO_HEADER_PUB_TOPIC_INT };
+
+    bc_radio_int_to_buffer(&value, buffer + 1);
+
+    strcpy((char *) buffer + 5, subtopic);
+
+    trace_add(buffer, 5 + strlen(subtopic) + 1);
+}
+
+static void trace_init(void)
+{
+    uint64_t id = 0x123456789abc;
+
+    // Climate and battery of sleeping nodes
+    trace_add_float(BC_RADIO_HEADER_PUB_TEMPERATURE, 0, 21.5f);
+    trace_add_float(BC_RADIO_HEADER_PUB_HUMIDITY, 0, 45.f);
+    trace_add_float(BC_RADIO_HEADER_PUB_LUX_METER, 0, 320.f);
+    trace_add_float(BC_RADIO_HEADER_PUB_TEMPERATURE, 1, 4.25f);
+
+    float barometer[2] = { 98000.f, 250.f };
+    uint8_t buffer[BC_RADIO_MAX_BUFFER_SIZE] = { BC_RADIO_HEADER_PUB_BAROMETER, 0 };
+    memcpy(buffer + 2, barometer, sizeof(barometer));
+    trace_add(buffer, 2 + sizeof(barometer));
+
+    float voltage = 2.95f;
+    buffer[0] = BC_RADIO_HEADER_PUB_BATTERY;
+    memcpy(buffer + 1, &voltage, sizeof(voltage));
+    trace_add(buffer, 1 + sizeof(voltage));
+
+    uint16_t event_count = 42;
+    buffer[0] = BC_RADIO_HEADER_PUB_EVENT_COUNT;
+    buffer[1] = BC_RADIO_PUB_EVENT_PUSH_BUTTON;
+    memcpy(buffer + 2, &event_count, sizeof(event_count));
+    trace_add(buffer, 2 + sizeof(event_count));
+
+    buffer[0] = BC_RADIO_HEADER_PUB_STATE;
+    buffer[1] = 1;
+    buffer[2] = true;
+    trace_add(buffer, 3);
+
+    // Topics with subtopic strings
+    trace_add_topic_int("bat-pct", 87);
+    trace_add_topic_int("thermometer/0:0/alarm", 0);
+
+    float value = 1013.25f;
+    buffer[0] = BC_RADIO_HEADER_PUB_TOPIC_FLOAT;
+    memcpy(buffer + 1, &value, sizeof(value));
+    strcpy((char *) buffer + 5, "barometer/0:0/hpa");
+    trace_add(buffer, 5 + strlen("barometer/0:0/hpa") + 1);
+
+    buffer[0] = BC_RADIO_HEADER_PUB_TOPIC_STRING;
+    strcpy((char *) buffer + 1, "fw");
+    strcpy((char *) buffer + 4, "v1.2.0");
+    trace_add(buffer, 4 + strlen("v1.2.0") + 1);
+
+    // Multi frame with two entries
+    uint8_t multi[BC_RADIO_MAX_BUFFER_SIZE] = { BC_RADIO_HEADER_PUB_MULTI, 2 };
+    size_t length = 2;
+    multi[length++] = trace[0].length;
+    memcpy(multi + length, trace[0].buffer, trace[0].length);
+    length += trace[0].length;
+    multi[length++] = trace[5].length;
+    memcpy(multi + length, trace[5].buffer, trace[5].length);
+    length += trace[5].length;
+    trace_add(multi, length);
+
+    // Commands for nodes of gateway
+    buffer[0] = BC_RADIO_HEADER_NODE_STATE_SET;
+    bc_radio_id_to_buffer(&id, buffer + 1);
+    buffer[7] = 2;
+    buffer[8] = false;
+    trace_add(buffer, 9);
+
+    uint32_t color = 0xff000000;
+    buffer[0] = BC_RADIO_HEADER_NODE_LED_STRIP_COLOR_SET;
+    memcpy(buffer + 7, &color, sizeof(color));
+    trace_add(buffer, 7 + sizeof(color));
+
+    // Frame of application protocol
+    buffer[0] = BC_RADIO_HEADER_CUSTOM_FIRST;
+    memset(buffer + 1, 0x55, 10);
+    trace_add(buffer, 11);
+}
+
+void application_init(void)
+{
+    const char *text = getenv("PASSES");
+    long passes = text != NULL ? atol(text) : PASSES;
+    uint64_t id = 0x123456789abc;
+
+    trace_init();
+
+    bc_radio_pub_register_custom_handler(BC_RADIO_HEADER_CUSTOM_FIRST, BC_RADIO_HEADER_CUSTOM_FIRST + 0x0f, custom_handler, NULL);
+
+    clock_t start = clock();
+
+    for (long pass = 0; pass < passes; pass++)
+    {
+        for (int i = 0; i < TRACE_LENGTH; i++)
+        {
+            // Same as _bc_radio_task does for every received frame
+            bc_radio_pub_decode(&id, trace[i].buffer, trace[i].length);
+
+            bc_radio_node_decode(&id, trace[i].buffer, trace[i].length);
+        }
+    }
+
+    double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%ld frames in %.3f s, %.1f ns per frame (checksum %08x, %u custom)\n",
+           passes * TRACE_LENGTH, elapsed, elapsed * 1e9 / (passes * TRACE_LENGTH), checksum, received_custom);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,6 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+
+#endif // _APPLICATION_H
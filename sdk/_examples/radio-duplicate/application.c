@@ -0,0 +1,270 @@
+#include <application.h>
+#include <stdio.h>
+
+// Time given to gateway to process frame and send its ACK
+#define STEP_INTERVAL 100
+
+// Time after which peer acknowledges frame sent by gateway
+#define ACK_DELAY 20
+
+// Peer device which sends all frames
+#define PEER_ID 0x123456789abcULL
+
+#define PAIRING 0x10000
+
+typedef struct
+{
+    // Message ID of frame or PAIRING for pairing request
+    uint32_t message_id;
+
+    // Frame is expected to be delivered to application, otherwise it is only acknowledged as duplicate
+    bool delivered;
+
+} frame_t;
+
+static const frame_t frames[] =
+{
+    // Messages in order, the last one is retransmitted because its ACK has been lost
+    { 1, true }, { 2, true }, { 3, true }, { 4, true }, { 4, false },
+
+    // Node has restarted and its message IDs start again below the last one
+    { 1, true }, { 2, true }, { 2, false }, { 3, true },
+
+    // Trace of the first test of duplicates, IDs jump back and forth and wrap around
+    { 5, true }, { 6, true }, { 5, true }, { 4, true }, { 7, true }, { 6, true }, { 4, true }, { 3, true },
+    { 1000, true }, { 999, true }, { 1000, true }, { 5, true }, { 5, false }, { 0xfffe, true }, { 0xffff, true },
+    { 0, true }, { 1, true }, { 0xffff, true }, { 2, true }, { 0, true },
+
+    // Pairing request after restart, the next message is new even with the last message ID
+    { PAIRING, false }, { 0, true }, { 0, false }
+};
+
+static int step;
+
+static int failures;
+
+static int delivered;
+
+static uint8_t delivered_index;
+
+static int acknowledged;
+
+static uint16_t acknowledged_message_id;
+
+static uint8_t peer_ack[BC_RADIO_HEAD_SIZE + 1];
+
+static bc_scheduler_task_id_t peer_ack_task_id;
+
+static uint8_t atsha204_address;
+
+static uint16_t crc16(const uint8_t *buffer, size_t length)
+{
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        for (uint8_t shift_register = 0x01; shift_register != 0x00; shift_register <<= 1)
+        {
+            uint8_t data_bit = (buffer[i] & shift_register) ? 1 : 0;
+            uint8_t crc_bit = crc >> 15;
+
+            crc <<= 1;
+
+            if (data_bit != crc_bit)
+            {
+                crc ^= 0x8005;
+            }
+        }
+    }
+
+    return crc;
+}
+
+// Serial number of ATSHA204 gives radio ID of gateway, the same as in radio medium of host library
+static bool atsha204_handler(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param)
+{
+    (void) memory_address;
+    (void) param;
+    uint8_t *data = buffer;
+
+    if (operation == BC_HOST_I2C_OPERATION_WRITE)
+    {
+        // Read command with word address in parameter 1
+        if ((length == 8) && (data[2] == 0x02))
+        {
+            atsha204_address = data[4];
+        }
+
+        return true;
+    }
+
+    if ((operation != BC_HOST_I2C_OPERATION_READ) || (length != 7))
+    {
+        return false;
+    }
+
+    data[0] = 7;
+
+    if (atsha204_address == 0)
+    {
+        data[1] = 0x01;
+        data[2] = 0x23;
+        data[3] = 0x00;
+        data[4] = 0xbc;
+    }
+    else
+    {
+        data[1] = 0x01;
+        data[2] = 0x00;
+        data[3] = 0x00;
+        data[4] = 0x00;
+    }
+
+    uint16_t crc = crc16(data, 5);
+
+    data[5] = crc;
+    data[6] = crc >> 8;
+
+    return true;
+}
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        printf("FAIL step %d: %s\n", step, name);
+
+        failures++;
+    }
+}
+
+static void custom_handler(uint64_t *id, const uint8_t *buffer, size_t length, void *param)
+{
+    (void) param;
+
+    check((*id == PEER_ID) && (length == 2), "delivered frame");
+
+    delivered++;
+
+    delivered_index = buffer[1];
+}
+
+static void tx_handler(const void *buffer, size_t length, void *param)
+{
+    (void) param;
+    const uint8_t *p = buffer;
+
+    if ((length >= BC_RADIO_HEAD_SIZE + 1) && (p[BC_RADIO_HEAD_SIZE] == BC_RADIO_HEADER_ACK))
+    {
+        acknowledged++;
+
+        acknowledged_message_id = p[6] | p[7] << 8;
+
+        return;
+    }
+
+    // Frame of gateway for peer (attach after bc_radio_peer_device_add) is acknowledged by peer
+    memcpy(peer_ack, buffer, BC_RADIO_HEAD_SIZE);
+
+    peer_ack[BC_RADIO_HEAD_SIZE] = BC_RADIO_HEADER_ACK;
+
+    bc_scheduler_plan_relative(peer_ack_task_id, ACK_DELAY);
+}
+
+static void peer_ack_task(void *param)
+{
+    (void) param;
+
+    bc_host_spirit1_receive(peer_ack, sizeof(peer_ack));
+}
+
+static void frame_send(int index)
+{
+    uint8_t buffer[BC_RADIO_HEAD_SIZE + 2];
+    uint64_t id = PEER_ID;
+    uint16_t message_id = frames[index].message_id;
+
+    bc_radio_id_to_buffer(&id, buffer);
+
+    buffer[6] = message_id;
+    buffer[7] = message_id >> 8;
+
+    // Pairing request without firmware name is just its header
+    if (frames[index].message_id == PAIRING)
+    {
+        buffer[BC_RADIO_HEAD_SIZE] = BC_RADIO_HEADER_PAIRING;
+
+        check(bc_host_spirit1_receive(buffer, BC_RADIO_HEAD_SIZE + 1), "receiver ready");
+
+        return;
+    }
+
+    buffer[BC_RADIO_HEAD_SIZE] = BC_RADIO_HEADER_CUSTOM_FIRST;
+    buffer[BC_RADIO_HEAD_SIZE + 1] = index;
+
+    check(bc_host_spirit1_receive(buffer, sizeof(buffer)), "receiver ready");
+}
+
+static void step_task(void *param)
+{
+    (void) param;
+    static int delivered_last;
+    static int acknowledged_last;
+
+    if (step > 0)
+    {
+        const frame_t *frame = &frames[step - 1];
+
+        printf("%5x %s\n", frame->message_id, frame->message_id == PAIRING ? "pairing" : delivered != delivered_last ? "delivered" : "duplicate");
+
+        // Every frame is acknowledged (ACK is sent twice), also duplicates since the ACK sent before has been lost
+        check((acknowledged > acknowledged_last) && (acknowledged_message_id == (uint16_t) frame->message_id), "acknowledged");
+
+        check(delivered == delivered_last + (frame->delivered ? 1 : 0), frame->delivered ? "delivered" : "not delivered again");
+
+        check(!frame->delivered || (delivered_index == step - 1), "delivered frame");
+
+        delivered_last = delivered;
+        acknowledged_last = acknowledged;
+    }
+
+    if (step == sizeof(frames) / sizeof(frames[0]))
+    {
+        bc_radio_link_stats_t link_stats;
+        int duplicates = 0;
+
+        for (size_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+        {
+            duplicates += (frames[i].message_id != PAIRING) && !frames[i].delivered ? 1 : 0;
+        }
+
+        check(bc_radio_get_link_stats(PEER_ID, &link_stats) && (link_stats.rx_duplicates == (uint32_t) duplicates), "duplicates counted");
+
+        printf("%d frames delivered, %d duplicates\n", delivered, duplicates);
+
+        printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+
+        exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    frame_send(step++);
+
+    bc_scheduler_plan_current_relative(STEP_INTERVAL);
+}
+
+void application_init(void)
+{
+    bc_host_i2c_attach(BC_I2C_I2C0, 0x64, atsha204_handler, NULL);
+
+    bc_radio_init(BC_RADIO_MODE_GATEWAY);
+
+    bc_radio_peer_device_add(PEER_ID);
+
+    bc_radio_pub_register_custom_handler(BC_RADIO_HEADER_CUSTOM_FIRST, BC_RADIO_HEADER_CUSTOM_FIRST, custom_handler, NULL);
+
+    bc_host_spirit1_set_tx_handler(tx_handler, NULL);
+
+    peer_ack_task_id = bc_scheduler_register(peer_ack_task, NULL, BC_TICK_INFINITY);
+
+    bc_scheduler_register(step_task, NULL, STEP_INTERVAL);
+}
@@ -0,0 +1,7 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+#include <bc_host.h>
+
+#endif // _APPLICATION_H
@@ -0,0 +1,199 @@
+#include <application.h>
+#include <bc_host.h>
+
+// Default period of publishing on every node in milliseconds
+#define PUBLISH_PERIOD 10000
+
+// Index of simulated node (the first ones are gateways)
+int node;
+
+int gateway_count;
+
+bc_tick_t publish_period;
+
+bc_tick_t stats_interval;
+
+bool telemetry;
+
+bool dictionary;
+
+// Number of telemetry frames or values with subtopic decoded by gateway
+int decoded;
+
+// Number of battery voltages decoded by gateway (they share multi frame with values with subtopic)
+int decoded_battery;
+
+static int getenv_int(const char *name, int value)
+{
+    const char *text = getenv(name);
+
+    return text != NULL ? atoi(text) : value;
+}
+
+static void decoded_print(void)
+{
+    if (telemetry)
+    {
+        fprintf(stderr, "gateway %d: %d telemetry frames decoded\n", node, decoded);
+    }
+    else
+    {
+        fprintf(stderr, "gateway %d: %d values with subtopic and %d battery voltages decoded\n", node, decoded, decoded_battery);
+    }
+}
+
+static void stats_start_task(void *param)
+{
+    (void) param;
+
+    bc_radio_set_stats_interval(stats_interval);
+
+    bc_scheduler_unregister(bc_scheduler_get_current_task_id());
+}
+
+void application_init(void)
+{
+    gateway_count = getenv_int("GATEWAYS", 1);
+
+    bc_host_radio_medium_config_t config =
+    {
+        .node_count = gateway_count + getenv_int("NODES", 4),
+        .gateway_count = gateway_count,
+        .datarate = getenv_int("DATARATE", 0),
+        .loss = getenv_int("LOSS", 0) / 100.f,
+        .collision = getenv_int("COLLISION", BC_HOST_RADIO_MEDIUM_COLLISION_DESTRUCTIVE),
+        .seed = getenv_int("SEED", 1)
+    };
+
+    bc_radio_retry_policy_t retry_policy = getenv_int("RETRY", BC_RADIO_RETRY_POLICY_FIXED);
+
+    publish_period = getenv_int("PERIOD", PUBLISH_PERIOD);
+
+    stats_interval = getenv_int("STATS", 0);
+
+    int channels = getenv_int("CHANNELS", 1);
+
+    bool lbt = getenv_int("LBT", 0) != 0;
+
+    telemetry = getenv_int("TELEMETRY", 0) != 0;
+
+    dictionary = getenv_int("DICTIONARY", 0) != 0;
+
+    node = bc_host_radio_medium_start(&config);
+
+    if (node < gateway_count)
+    {
+        bc_radio_init_retry_policy(BC_RADIO_MODE_GATEWAY, retry_policy);
+
+        // Gateways are spread over channels in order, nodes search for them
+        bc_radio_set_channel(node % channels);
+
+        bc_radio_automatic_pairing_start();
+
+        // Gateway process ends when simulation ends
+        if (telemetry || dictionary)
+        {
+            atexit(decoded_print);
+        }
+    }
+    else
+    {
+        bc_radio_init_retry_policy(BC_RADIO_MODE_NODE_SLEEPING, retry_policy);
+
+        bc_radio_set_channel_set((1 << channels) - 1);
+
+        bc_radio_pub_set_topic_dictionary(dictionary);
+
+        // Nodes do not publish statistics at the same time
+        if (stats_interval != 0)
+        {
+            bc_scheduler_register(stats_start_task, NULL, rand() % stats_interval);
+        }
+    }
+
+    bc_radio_set_lbt(lbt);
+}
+
+void bc_radio_pub_on_radio_stats(uint64_t *id, bc_radio_stats_t *stats)
+{
+    fprintf(stderr, "%012" PRIx64 ": %" PRIu32 " frames, %" PRIu32 " retransmissions, %" PRIu32 " ACK timeouts, %" PRIu64 " ms TX, %" PRIu64 " ms RX, queue %" PRIu16 " B\n",
+            *id, stats->tx_frames, stats->tx_retransmissions, stats->tx_ack_timeouts, stats->tx_airtime, stats->rx_airtime, stats->pub_queue_high_water);
+}
+
+void bc_radio_pub_on_telemetry(uint64_t *id, int32_t *values, int count)
+{
+    (void) id;
+    (void) values;
+    (void) count;
+
+    decoded++;
+}
+
+void bc_radio_pub_on_float(uint64_t *id, char *subtopic, float *value)
+{
+    (void) id;
+    (void) subtopic;
+    (void) value;
+
+    decoded++;
+}
+
+void bc_radio_pub_on_battery(uint64_t *id, float *voltage)
+{
+    (void) id;
+    (void) voltage;
+
+    decoded_battery++;
+}
+
+void application_task(void *param)
+{
+    (void) param;
+
+    static bool started = false;
+    static float celsius = 20.f;
+
+    // Gateways only listen
+    if (node < gateway_count)
+    {
+        return;
+    }
+
+    // Nodes do not start at the same time
+    if (!started)
+    {
+        started = true;
+
+        bc_scheduler_plan_current_relative(rand() % publish_period);
+
+        return;
+    }
+
+    celsius += (rand() % 11 - 5) / 100.f;
+
+    if (telemetry)
+    {
+        int32_t values[] = { celsius * 100, 1000 - (int32_t) celsius };
+
+        bc_radio_pub_telemetry(values, 2);
+    }
+    else if (dictionary)
+    {
+        float voltage = 3.f;
+
+        // Battery goes with the value in one multi frame the same as in meteosonda
+        bc_radio_pub_multi_begin();
+
+        bc_radio_pub_float("temperature", &celsius);
+
+        bc_radio_pub_battery(&voltage);
+
+        bc_radio_pub_multi_end();
+    }
+    else
+    {
+        bc_radio_pub_temperature(BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_ALTERNATE, &celsius);
+    }
+
+    bc_scheduler_plan_current_relative(publish_period);
+}
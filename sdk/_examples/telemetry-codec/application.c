@@ -0,0 +1,334 @@
+#define _DEFAULT_SOURCE
+
+#include <application.h>
+#include <stdio.h>
+
+// Default number of days of generated series
+#define DAYS 30
+
+// Samples per day, climate module of meteosonda is read every 2 minutes
+#define SAMPLES_PER_DAY (24 * 30)
+
+// Values in frame: temperature, humidity, illuminance and pressure
+#define COUNT 4
+
+// Keyframe interval used by bc_radio_pub_telemetry
+#define KEYFRAME_INTERVAL 16
+
+// Length of meteosonda frame with packed int16, uint8, uint16 and uint16 values
+#define PACKED_LENGTH 7
+
+// Default loss of frames and acknowledgements in percent
+#define LOSS 10
+#define ACK_LOSS 5
+
+// Default probability in per mille that gateway evicts decoder of node before frame arrives
+#define EVICT 5
+
+typedef struct
+{
+    long frames;
+    long bytes;
+    long keyframes;
+    long lost;
+    long refused;
+    long decoded;
+    long mismatches;
+
+} result_t;
+
+static int failures;
+
+static uint32_t random_state = 1;
+
+static uint32_t random_get(uint32_t range)
+{
+    random_state = random_state * 1103515245 + 12345;
+
+    return (random_state >> 8) % range;
+}
+
+// Signed noise of given amplitude
+static int noise_get(int amplitude)
+{
+    return (int) random_get(2 * amplitude + 1) - amplitude;
+}
+
+// Series in units of meteosonda frame: centidegrees, percent, lux and pascal above 900 hPa
+static int32_t (*series_generate(long samples))[COUNT]
+{
+    int32_t (*series)[COUNT] = malloc(samples * sizeof(*series));
+    double pressure = 1013;
+    double cloud = 1;
+
+    for (long i = 0; i < samples; i++)
+    {
+        double phase = 2 * M_PI * (i % SAMPLES_PER_DAY) / SAMPLES_PER_DAY;
+        double day = -cos(phase);
+
+        pressure += noise_get(10) / 1000.0;
+
+        cloud += noise_get(20) / 1000.0;
+        cloud = cloud < 0.2 ? 0.2 : cloud > 1 ? 1 : cloud;
+
+        double temperature = 14 + 6 * day + 3 * cloud;
+        double lux = day > 0 ? 30000 * day * cloud : 0;
+
+        series[i][0] = temperature * 100 + noise_get(3);
+        series[i][1] = 70 - 15 * day + noise_get(1);
+        series[i][2] = lux > 0 ? lux + noise_get(lux / 100 + 1) : 0;
+        series[i][3] = (pressure - 900) * 100 + noise_get(3);
+    }
+
+    return series;
+}
+
+// Recorded series is read from file with four comma separated values per line
+static int32_t (*series_read(const char *path, long *samples))[COUNT]
+{
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    long size = 1024;
+    int32_t (*series)[COUNT] = malloc(size * sizeof(*series));
+    int32_t *values;
+
+    *samples = 0;
+
+    for (;;)
+    {
+        if (*samples == size)
+        {
+            size *= 2;
+
+            series = realloc(series, size * sizeof(*series));
+        }
+
+        values = series[*samples];
+
+        if (fscanf(file, "%d,%d,%d,%d", &values[0], &values[1], &values[2], &values[3]) != COUNT)
+        {
+            break;
+        }
+
+        (*samples)++;
+    }
+
+    fclose(file);
+
+    return series;
+}
+
+static void check(bool condition, const char *name)
+{
+    if (!condition)
+    {
+        printf("FAIL %s\n", name);
+
+        failures++;
+    }
+}
+
+static bool values_equal(const int32_t *a, const int32_t *b, int count)
+{
+    return memcmp(a, b, count * sizeof(int32_t)) == 0;
+}
+
+// Frames which cannot be decoded in isolation must be refused rather than decoded to wrong values
+static void edge_cases_test(void)
+{
+    static const int32_t extremes[2][BC_TELEMETRY_CODEC_MAX_VALUES] =
+    {
+        { INT32_MIN, INT32_MAX, 0, -1, 1, 63, -64, 64 },
+        { INT32_MAX, INT32_MIN, -1, 0, -64, 64, 63, INT32_MIN }
+    };
+    bc_telemetry_codec_encoder_t encoder;
+    bc_telemetry_codec_decoder_t decoder;
+    uint8_t buffer[BC_TELEMETRY_CODEC_MAX_FRAME_SIZE];
+    int32_t values[BC_TELEMETRY_CODEC_MAX_VALUES];
+    int count;
+
+    bc_telemetry_codec_encoder_init(&encoder, BC_TELEMETRY_CODEC_MAX_VALUES, 0);
+    bc_telemetry_codec_decoder_init(&decoder);
+
+    size_t length = bc_telemetry_codec_encode(&encoder, extremes[0], buffer, sizeof(buffer));
+
+    check(bc_telemetry_codec_is_keyframe(buffer, length), "first frame is keyframe");
+    check(bc_telemetry_codec_decode(&decoder, buffer, length, values, &count), "keyframe decodes");
+    check((count == BC_TELEMETRY_CODEC_MAX_VALUES) && values_equal(values, extremes[0], count), "keyframe of extreme values");
+
+    bc_telemetry_codec_acknowledge(&encoder, buffer, length);
+
+    // Differences between extremes wrap around
+    length = bc_telemetry_codec_encode(&encoder, extremes[1], buffer, sizeof(buffer));
+
+    check(!bc_telemetry_codec_is_keyframe(buffer, length), "frame after acknowledgement is delta");
+    check(length <= BC_TELEMETRY_CODEC_MAX_FRAME_SIZE, "delta frame fits maximum size");
+
+    for (size_t i = 0; i < length; i++)
+    {
+        check(!bc_telemetry_codec_decode(&decoder, buffer, i, values, &count), "truncated frame is refused");
+    }
+
+    check(bc_telemetry_codec_decoder_has_reference(&decoder, buffer, length), "reference of delta is known");
+    check(bc_telemetry_codec_decode(&decoder, buffer, length, values, &count), "delta decodes");
+    check(values_equal(values, extremes[1], count), "delta of extreme values");
+
+    // Decoder which has not seen the reference must not decode the delta
+    bc_telemetry_codec_decoder_init(&decoder);
+
+    check(!bc_telemetry_codec_decoder_has_reference(&decoder, buffer, length), "fresh decoder has no reference");
+    check(!bc_telemetry_codec_decode(&decoder, buffer, length, values, &count), "fresh decoder refuses delta");
+
+    // Delta against acknowledged keyframe is zero for every value, one byte each
+    check(bc_telemetry_codec_encode(&encoder, extremes[0], buffer, BC_TELEMETRY_CODEC_MAX_VALUES) == 0, "short buffer is refused");
+    check(bc_telemetry_codec_encode(&encoder, extremes[0], buffer, 1 + BC_TELEMETRY_CODEC_MAX_VALUES) == 1 + BC_TELEMETRY_CODEC_MAX_VALUES, "failed encode keeps reference");
+
+    // Head has room for reference at most 4 frames back, 2 frames have been sent since the keyframe
+    for (int i = 0; i < 2; i++)
+    {
+        length = bc_telemetry_codec_encode(&encoder, extremes[0], buffer, sizeof(buffer));
+
+        check(!bc_telemetry_codec_is_keyframe(buffer, length), "delta up to 4 frames after reference");
+    }
+
+    length = bc_telemetry_codec_encode(&encoder, extremes[0], buffer, sizeof(buffer));
+
+    check(bc_telemetry_codec_is_keyframe(buffer, length), "keyframe 5 frames after reference");
+}
+
+static void run(int32_t (*series)[COUNT], long samples, int loss, int ack_loss, int evict, result_t *result)
+{
+    bc_telemetry_codec_encoder_t encoder;
+    bc_telemetry_codec_decoder_t decoder;
+    uint8_t buffer[BC_TELEMETRY_CODEC_MAX_FRAME_SIZE];
+    int32_t values[BC_TELEMETRY_CODEC_MAX_VALUES];
+    int count;
+
+    memset(result, 0, sizeof(*result));
+
+    bc_telemetry_codec_encoder_init(&encoder, COUNT, KEYFRAME_INTERVAL);
+    bc_telemetry_codec_decoder_init(&decoder);
+
+    for (long i = 0; i < samples; i++)
+    {
+        // Refused frame is sent once more as keyframe, the same as bc_radio_pub_refusal does
+        for (int attempt = 0; attempt < 2; attempt++)
+        {
+            size_t length = bc_telemetry_codec_encode(&encoder, series[i], buffer, sizeof(buffer));
+
+            result->frames++;
+            result->bytes += length;
+            result->keyframes += bc_telemetry_codec_is_keyframe(buffer, length);
+
+            // Frame lost after all retransmissions, bc_radio reports it as not delivered
+            if (random_get(100) < (uint32_t) loss)
+            {
+                bc_telemetry_codec_force_keyframe(&encoder);
+
+                result->lost++;
+
+                break;
+            }
+
+            if (random_get(1000) < (uint32_t) evict)
+            {
+                bc_telemetry_codec_decoder_init(&decoder);
+            }
+
+            if (!bc_telemetry_codec_decoder_has_reference(&decoder, buffer, length))
+            {
+                bc_telemetry_codec_force_keyframe(&encoder);
+
+                result->refused++;
+
+                continue;
+            }
+
+            if (bc_telemetry_codec_decode(&decoder, buffer, length, values, &count))
+            {
+                result->decoded++;
+
+                result->mismatches += (count != COUNT) || !values_equal(values, series[i], COUNT);
+            }
+            else
+            {
+                result->mismatches++;
+            }
+
+            // Gateway has decoded frame but node has not received acknowledgement
+            if (random_get(100) < (uint32_t) ack_loss)
+            {
+                bc_telemetry_codec_force_keyframe(&encoder);
+            }
+            else
+            {
+                bc_telemetry_codec_acknowledge(&encoder, buffer, length);
+            }
+
+            break;
+        }
+    }
+}
+
+static void result_print(const char *name, const result_t *result)
+{
+    printf("%-9s %ld frames, %.2f B per frame (%.0f %% of packed %d B), %.1f %% keyframes, "
+           "%ld lost, %ld refused, %ld decoded, %ld mismatches\n",
+           name, result->frames, (double) result->bytes / result->frames,
+           100.0 * result->bytes / result->frames / PACKED_LENGTH, PACKED_LENGTH,
+           100.0 * result->keyframes / result->frames, result->lost, result->refused, result->decoded, result->mismatches);
+}
+
+void application_init(void)
+{
+    const char *text = getenv("DAYS");
+    long samples = (text != NULL ? atol(text) : DAYS) * SAMPLES_PER_DAY;
+    text = getenv("LOSS");
+    int loss = text != NULL ? atoi(text) : LOSS;
+    text = getenv("ACK_LOSS");
+    int ack_loss = text != NULL ? atoi(text) : ACK_LOSS;
+    text = getenv("EVICT");
+    int evict = text != NULL ? atoi(text) : EVICT;
+    int32_t (*series)[COUNT];
+    result_t result;
+
+    text = getenv("RECORD");
+
+    series = text != NULL ? series_read(text, &samples) : series_generate(samples);
+
+    if (series == NULL)
+    {
+        printf("Cannot read %s\n", text);
+
+        exit(EXIT_FAILURE);
+    }
+
+    edge_cases_test();
+
+    run(series, samples, 0, 0, 0, &result);
+
+    check((result.decoded == samples) && (result.mismatches == 0), "lossless round trip");
+
+    check(result.bytes < result.frames * PACKED_LENGTH, "frames shorter than packed frame");
+
+    result_print("lossless", &result);
+
+    run(series, samples, loss, ack_loss, evict, &result);
+
+    check(result.mismatches == 0, "lossy round trip");
+
+    check(result.decoded + result.lost == samples, "every sample is decoded or lost");
+
+    result_print("lossy", &result);
+
+    free(series);
+
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
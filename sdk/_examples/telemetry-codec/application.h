@@ -0,0 +1,7 @@
+#ifndef _APPLICATION_H
+#define _APPLICATION_H
+
+#include <bcl.h>
+#include <bc_telemetry_codec.h>
+
+#endif // _APPLICATION_H
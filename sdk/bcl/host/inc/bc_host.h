@@ -0,0 +1,203 @@
+#ifndef _BC_HOST_H
+#define _BC_HOST_H
+
+#include <bc_tick.h>
+#include <bc_i2c.h>
+#include <bc_gpio.h>
+
+//! @addtogroup bc_host bc_host
+//! @brief Simulation hooks of the host (x86-64 Linux) build
+//! @{
+
+//! @brief Operation requested from simulated I2C device
+
+typedef enum
+{
+    //! @brief Plain write transfer
+    BC_HOST_I2C_OPERATION_WRITE = 0,
+
+    //! @brief Plain read transfer
+    BC_HOST_I2C_OPERATION_READ = 1,
+
+    //! @brief Memory write transfer
+    BC_HOST_I2C_OPERATION_MEMORY_WRITE = 2,
+
+    //! @brief Memory read transfer
+    BC_HOST_I2C_OPERATION_MEMORY_READ = 3
+
+} bc_host_i2c_operation_t;
+
+//! @brief Collision model of simulated radio medium
+
+typedef enum
+{
+    //! @brief Overlapping frames do not interfere
+    BC_HOST_RADIO_MEDIUM_COLLISION_NONE = 0,
+
+    //! @brief Overlapping frames are lost at all receivers
+    BC_HOST_RADIO_MEDIUM_COLLISION_DESTRUCTIVE = 1
+
+} bc_host_radio_medium_collision_t;
+
+//! @brief Configuration of simulated radio medium
+
+typedef struct
+{
+    //! @brief Number of simulated nodes (processes) sharing the medium
+    int node_count;
+
+    //! @brief Number of the first nodes which are counted as gateways in statistics (0 is the same as 1)
+    int gateway_count;
+
+    //! @brief Modem data rate in bits per second which determines airtime of frames (0 keeps 19200)
+    uint32_t datarate;
+
+    //! @brief Probability that receiver loses frame regardless of collisions (0 to 1)
+    float loss;
+
+    //! @brief Collision model
+    bc_host_radio_medium_collision_t collision;
+
+    //! @brief Seed of random generators of medium and nodes
+    unsigned int seed;
+
+} bc_host_radio_medium_config_t;
+
+//! @brief Statistics of windows in which interrupts are disabled (measured in host time)
+
+typedef struct
+{
+    //! @brief Number of windows (nested bc_irq_disable is part of outer window)
+    uint32_t count;
+
+    //! @brief Total length of windows in nanoseconds
+    uint64_t total;
+
+    //! @brief Length of the longest window in nanoseconds
+    uint64_t max;
+
+} bc_host_irq_stats_t;
+
+//! @brief Set tick at which simulation ends (process prints wake-up statistics and exits with success)
+//! @param[in] tick Absolute tick, BC_TICK_INFINITY runs forever
+
+void bc_host_set_run_time(bc_tick_t tick);
+
+//! @brief Get number of simulated RTC wake-ups since start
+//! @return Number of wake-ups
+
+uint32_t bc_host_get_wakeup_count(void);
+
+//! @brief Get average number of simulated RTC wake-ups per simulated hour since start
+//! @return Number of wake-ups per hour
+
+uint32_t bc_host_get_wakeup_count_per_hour(void);
+
+//! @brief Get statistics of windows in which interrupts have been disabled since start or since the last reset
+//! @param[out] stats Statistics
+
+void bc_host_irq_get_stats(bc_host_irq_stats_t *stats);
+
+//! @brief Reset statistics of windows in which interrupts have been disabled
+
+void bc_host_irq_reset_stats(void);
+
+//! @brief Attach simulated device to I2C channel
+//! @param[in] channel I2C channel
+//! @param[in] device_address 7-bit I2C device address
+//! @param[in] handler Function called for every transfer addressed to device (return false to NACK)
+//! @param[in] param Optional parameter passed to handler (can be NULL)
+//! @return true On success
+//! @return false On failure (device table is full)
+
+bool bc_host_i2c_attach(bc_i2c_channel_t channel, uint8_t device_address, bool (*handler)(bc_host_i2c_operation_t, uint32_t, void *, size_t, void *), void *param);
+
+//! @brief Set time for which simulated device stretches clock in every transfer
+//! @details Asynchronous transfer is completed after its bus time and delay, transfer which does not complete before
+//! timeout fails with BC_I2C_EVENT_ERROR. Blocking transfer fails immediately if delay exceeds timeout.
+//! @param[in] channel I2C channel
+//! @param[in] device_address 7-bit I2C device address
+//! @param[in] delay Delay in milliseconds
+//! @return true On success
+//! @return false On failure (device is not attached)
+
+bool bc_host_i2c_set_delay(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t delay);
+
+//! @brief Set input level of GPIO channel
+//! @param[in] channel GPIO channel
+//! @param[in] state Input level
+
+void bc_host_gpio_set_input(bc_gpio_channel_t channel, int state);
+
+//! @brief Get simulated EEPROM content
+//! @return Pointer to memory of size bc_eeprom_get_size()
+
+uint8_t *bc_host_eeprom_get_buffer(void);
+
+//! @brief Get number of times every byte of simulated EEPROM has been written
+//! @return Pointer to array of bc_eeprom_get_size() counters
+
+const uint32_t *bc_host_eeprom_get_write_count(void);
+
+//! @brief Get number of program operations (word or byte) of simulated EEPROM
+//! @return Number of program operations
+
+uint32_t bc_host_eeprom_get_program_count(void);
+
+//! @brief Cut power of simulated EEPROM after specified number of bytes is written
+//! @details Byte written at the moment of power cut gets random value, following writes fail until power cut is changed.
+//! @param[in] length Number of bytes which are written successfully or SIZE_MAX to never cut power
+
+void bc_host_eeprom_set_power_cut(size_t length);
+
+//! @brief Set function called with every frame transmitted by Spirit1
+//! @param[in] handler Function address
+//! @param[in] param Optional parameter passed to handler (can be NULL)
+
+void bc_host_spirit1_set_tx_handler(void (*handler)(const void *, size_t, void *), void *param);
+
+//! @brief Set function which senses carrier on channel before frame is transmitted with listen before talk
+//! @param[in] handler Function address (returns true if channel is busy)
+//! @param[in] param Optional parameter passed to handler (can be NULL)
+
+void bc_host_spirit1_set_carrier_sense_handler(bool (*handler)(uint8_t, void *), void *param);
+
+//! @brief Deliver frame to Spirit1 receiver
+//! @param[in] buffer Frame content
+//! @param[in] length Frame length
+//! @return true If frame was accepted (receiver is in RX state)
+//! @return false If frame was lost
+
+bool bc_host_spirit1_receive(const void *buffer, size_t length);
+
+//! @brief Set modem data rate used for airtime of frames
+//! @param[in] datarate Data rate in bits per second
+
+void bc_host_spirit1_set_datarate(uint32_t datarate);
+
+//! @brief Get airtime of frame
+//! @param[in] length Frame length
+//! @return Airtime in milliseconds
+
+bc_tick_t bc_host_spirit1_get_airtime(size_t length);
+
+//! @brief Start simulation of nodes sharing one radio medium (call it from application_init before bc_radio_init)
+//! @param[in] config Medium configuration
+//! @return Index of node (0 to node_count - 1) in which execution continues
+//!
+//! Every node runs in its own forked process with its own simulated peripherals and unique ATSHA204 serial number.
+//! Calling process coordinates simulated time of nodes, delivers their frames with respect to airtime, loss and
+//! collisions and it never returns. Frames are heard and collide only on the channel of sender. When all nodes exit,
+//! it prints statistics of medium and exits.
+
+int bc_host_radio_medium_start(const bc_host_radio_medium_config_t *config);
+
+//! @brief Internal function for bc_system.c which waits in simulated radio medium
+//! @param[in] tick Absolute tick at which node wants to wake up
+//! @return Absolute tick at which node wakes up (earlier if frame is received)
+
+bc_tick_t bc_host_radio_medium_sleep(bc_tick_t tick);
+
+//! @}
+
+#endif // _BC_HOST_H
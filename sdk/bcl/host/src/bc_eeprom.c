@@ -0,0 +1,239 @@
+#include <bc_eeprom.h>
+#include <bc_scheduler.h>
+#include <bc_host.h>
+
+// Size of data EEPROM of STM32L083CZ (both banks)
+#define _BC_EEPROM_SIZE 6144
+
+// Programming of one word including automatic erase takes up to 3.2 ms
+#define _BC_EEPROM_PROGRAM_TIME 4
+
+static uint8_t _bc_eeprom[_BC_EEPROM_SIZE];
+
+static uint32_t _bc_eeprom_write_count[_BC_EEPROM_SIZE];
+
+static uint32_t _bc_eeprom_program_count;
+
+// Number of bytes which can be written before power cut
+static size_t _bc_eeprom_power_cut = SIZE_MAX;
+
+static bool _bc_eeprom_power_off;
+
+static struct
+{
+    bool initialized;
+    bool running;
+    uint32_t address;
+    const uint8_t *buffer;
+    size_t length;
+    size_t position;
+    bc_scheduler_task_id_t task_id;
+    void (*event_handler)(bc_eeprom_event_t, void *);
+    void *event_param;
+
+} _bc_eeprom_async;
+
+static int _bc_eeprom_program(uint32_t address, const uint8_t *buffer, size_t length, size_t *position);
+static void _bc_eeprom_async_task(void *param);
+
+bool bc_eeprom_write(uint32_t address, const void *buffer, size_t length)
+{
+    size_t position = 0;
+    int result;
+
+    // If user attempts to write outside EEPROM area...
+    if ((address + length) > _BC_EEPROM_SIZE)
+    {
+        // Indicate failure
+        return false;
+    }
+
+    if (_bc_eeprom_async.running)
+    {
+        return false;
+    }
+
+    while ((result = _bc_eeprom_program(address, buffer, length, &position)) > 0)
+    {
+        continue;
+    }
+
+    // Indicate success
+    return result == 0;
+}
+
+bool bc_eeprom_async_write(uint32_t address, const void *buffer, size_t length, void (*event_handler)(bc_eeprom_event_t, void *), void *event_param)
+{
+    // If user attempts to write outside EEPROM area...
+    if ((address + length) > _BC_EEPROM_SIZE)
+    {
+        // Indicate failure
+        return false;
+    }
+
+    if (_bc_eeprom_async.running)
+    {
+        return false;
+    }
+
+    if (!_bc_eeprom_async.initialized)
+    {
+        _bc_eeprom_async.task_id = bc_scheduler_register(_bc_eeprom_async_task, NULL, BC_TICK_INFINITY);
+
+        _bc_eeprom_async.initialized = true;
+    }
+
+    _bc_eeprom_async.running = true;
+    _bc_eeprom_async.address = address;
+    _bc_eeprom_async.buffer = buffer;
+    _bc_eeprom_async.length = length;
+    _bc_eeprom_async.position = 0;
+    _bc_eeprom_async.event_handler = event_handler;
+    _bc_eeprom_async.event_param = event_param;
+
+    bc_scheduler_plan_now(_bc_eeprom_async.task_id);
+
+    return true;
+}
+
+void bc_eeprom_async_cancel(void)
+{
+    if (!_bc_eeprom_async.running)
+    {
+        return;
+    }
+
+    _bc_eeprom_async.running = false;
+
+    bc_scheduler_plan_absolute(_bc_eeprom_async.task_id, BC_TICK_INFINITY);
+}
+
+bool bc_eeprom_is_ready(void)
+{
+    return !_bc_eeprom_async.running;
+}
+
+bool bc_eeprom_read(uint32_t address, void *buffer, size_t length)
+{
+    // If user attempts to read outside of EEPROM boundary...
+    if ((address + length) > _BC_EEPROM_SIZE)
+    {
+        // Indicate failure
+        return false;
+    }
+
+    memcpy(buffer, _bc_eeprom + address, length);
+
+    // Indicate success
+    return true;
+}
+
+size_t bc_eeprom_get_size(void)
+{
+    return _BC_EEPROM_SIZE;
+}
+
+uint8_t *bc_host_eeprom_get_buffer(void)
+{
+    return _bc_eeprom;
+}
+
+const uint32_t *bc_host_eeprom_get_write_count(void)
+{
+    return _bc_eeprom_write_count;
+}
+
+uint32_t bc_host_eeprom_get_program_count(void)
+{
+    return _bc_eeprom_program_count;
+}
+
+void bc_host_eeprom_set_power_cut(size_t length)
+{
+    _bc_eeprom_power_cut = length;
+    _bc_eeprom_power_off = false;
+}
+
+// Program the next word or byte which differs from buffer the same way as STM32L0 does (1 programmed, 0 done, -1 power cut)
+static int _bc_eeprom_program(uint32_t address, const uint8_t *buffer, size_t length, size_t *position)
+{
+    while (*position < length)
+    {
+        uint32_t destination = address + *position;
+        size_t unit = (((destination & 3) == 0) && ((length - *position) >= 4)) ? 4 : 1;
+
+        *position += unit;
+
+        if (memcmp(_bc_eeprom + destination, buffer + *position - unit, unit) == 0)
+        {
+            continue;
+        }
+
+        if (_bc_eeprom_power_off)
+        {
+            return -1;
+        }
+
+        _bc_eeprom_program_count++;
+
+        for (size_t i = 0; i < unit; i++)
+        {
+            _bc_eeprom_write_count[destination + i]++;
+
+            if (_bc_eeprom_power_cut == 0)
+            {
+                // Byte being programmed at the moment of power cut is left undefined
+                _bc_eeprom[destination + i] = rand();
+
+                _bc_eeprom_power_off = true;
+
+                return -1;
+            }
+
+            if (_bc_eeprom_power_cut != SIZE_MAX)
+            {
+                _bc_eeprom_power_cut--;
+            }
+
+            _bc_eeprom[destination + i] = buffer[*position - unit + i];
+        }
+
+        return 1;
+    }
+
+    return 0;
+}
+
+static void _bc_eeprom_async_task(void *param)
+{
+    (void) param;
+    int result;
+
+    if (!_bc_eeprom_async.running)
+    {
+        return;
+    }
+
+    result = _bc_eeprom_program(_bc_eeprom_async.address, _bc_eeprom_async.buffer, _bc_eeprom_async.length, &_bc_eeprom_async.position);
+
+    if (result > 0)
+    {
+        bc_scheduler_plan_current_from_now(_BC_EEPROM_PROGRAM_TIME);
+
+        return;
+    }
+
+    _bc_eeprom_async.running = false;
+
+    if (_bc_eeprom_async.event_handler != NULL)
+    {
+        if ((result < 0) || (memcmp(_bc_eeprom_async.buffer, _bc_eeprom + _bc_eeprom_async.address, _bc_eeprom_async.length) != 0))
+        {
+            _bc_eeprom_async.event_handler(BC_EEPROM_EVENT_ASYNC_WRITE_ERROR, _bc_eeprom_async.event_param);
+        }
+        else
+        {
+            _bc_eeprom_async.event_handler(BC_EEPROM_EVENT_ASYNC_WRITE_DONE, _bc_eeprom_async.event_param);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include <bc_gpio.h>
+#include <bc_host.h>
+
+static struct
+{
+    bc_gpio_mode_t mode;
+    bc_gpio_pull_t pull;
+    int input;
+    int output;
+
+} _bc_gpio[BC_GPIO_BUTTON + 1];
+
+void bc_gpio_init(bc_gpio_channel_t channel)
+{
+    (void) channel;
+}
+
+void bc_gpio_set_pull(bc_gpio_channel_t channel, bc_gpio_pull_t pull)
+{
+    _bc_gpio[channel].pull = pull;
+}
+
+bc_gpio_pull_t bc_gpio_get_pull(bc_gpio_channel_t channel)
+{
+    return _bc_gpio[channel].pull;
+}
+
+void bc_gpio_set_mode(bc_gpio_channel_t channel, bc_gpio_mode_t mode)
+{
+    _bc_gpio[channel].mode = mode;
+}
+
+bc_gpio_mode_t bc_gpio_get_mode(bc_gpio_channel_t channel)
+{
+    return _bc_gpio[channel].mode;
+}
+
+int bc_gpio_get_input(bc_gpio_channel_t channel)
+{
+    return _bc_gpio[channel].input;
+}
+
+void bc_gpio_set_output(bc_gpio_channel_t channel, int state)
+{
+    _bc_gpio[channel].output = state != 0 ? 1 : 0;
+}
+
+int bc_gpio_get_output(bc_gpio_channel_t channel)
+{
+    return _bc_gpio[channel].output;
+}
+
+void bc_gpio_toggle_output(bc_gpio_channel_t channel)
+{
+    _bc_gpio[channel].output ^= 1;
+}
+
+void bc_host_gpio_set_input(bc_gpio_channel_t channel, int state)
+{
+    _bc_gpio[channel].input = state != 0 ? 1 : 0;
+}
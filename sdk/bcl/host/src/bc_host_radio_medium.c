@@ -0,0 +1,690 @@
+#define _DEFAULT_SOURCE
+
+#include <bc_host.h>
+#include <bc_spirit1.h>
+#include <bc_tick.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+// Frames which can be on air at the same time
+#define _BC_HOST_RADIO_MEDIUM_MAX_FRAMES 256
+
+// I2C address of ATSHA204 used by bc_radio
+#define _BC_HOST_RADIO_MEDIUM_ATSHA204_ADDRESS 0x64
+
+// Offset of radio header in frame (ID and message ID)
+#define _BC_HOST_RADIO_MEDIUM_HEADER_OFFSET 8
+
+// Same value as BC_RADIO_HEADER_ACK
+#define _BC_HOST_RADIO_MEDIUM_HEADER_ACK 0xaa
+
+typedef enum
+{
+    // Node transmits frame (node to medium)
+    _BC_HOST_RADIO_MEDIUM_MESSAGE_TX = 0,
+
+    // Node sleeps until tick (node to medium)
+    _BC_HOST_RADIO_MEDIUM_MESSAGE_SLEEP = 1,
+
+    // Node wakes up at tick, optionally with received frame (medium to node)
+    _BC_HOST_RADIO_MEDIUM_MESSAGE_WAKE = 2,
+
+    // Node senses carrier on channel (node to medium), medium answers whether channel is busy (medium to node)
+    _BC_HOST_RADIO_MEDIUM_MESSAGE_CARRIER_SENSE = 3
+
+} _bc_host_radio_medium_message_type_t;
+
+typedef struct
+{
+    _bc_host_radio_medium_message_type_t type;
+    bc_tick_t tick;
+    bool received;
+    uint8_t channel;
+    size_t length;
+    uint8_t buffer[BC_SPIRIT1_MAX_PACKET_SIZE];
+
+} _bc_host_radio_medium_message_t;
+
+typedef enum
+{
+    _BC_HOST_RADIO_MEDIUM_NODE_RUNNING = 0,
+    _BC_HOST_RADIO_MEDIUM_NODE_SLEEPING = 1,
+    _BC_HOST_RADIO_MEDIUM_NODE_EXITED = 2
+
+} _bc_host_radio_medium_node_state_t;
+
+typedef struct
+{
+    int fd;
+    _bc_host_radio_medium_node_state_t state;
+    bc_tick_t tick_wakeup;
+    bool received;
+    uint8_t channel;
+
+    uint32_t tx_count;
+    uint32_t message_count;
+    uint16_t message_id;
+    uint16_t message_id_delivered;
+    uint16_t message_id_acknowledged;
+    bool message_id_valid;
+    bool message_id_delivered_valid;
+    bool message_id_acknowledged_valid;
+
+} _bc_host_radio_medium_node_t;
+
+typedef struct
+{
+    int sender;
+    uint8_t channel;
+    bc_tick_t tick_start;
+    bc_tick_t tick_end;
+    bool collided;
+    size_t length;
+    uint8_t buffer[BC_SPIRIT1_MAX_PACKET_SIZE];
+
+} _bc_host_radio_medium_frame_t;
+
+static struct
+{
+    bc_host_radio_medium_config_t config;
+
+    // Node side
+    int fd;
+    int index;
+    bool received;
+    uint8_t serial_number_address;
+
+    // Medium side
+    _bc_host_radio_medium_node_t *nodes;
+    _bc_host_radio_medium_frame_t frames[_BC_HOST_RADIO_MEDIUM_MAX_FRAMES];
+    int frames_length;
+    bc_tick_t tick;
+
+    struct
+    {
+        uint32_t frames;
+        uint32_t ack_frames;
+        uint32_t collided;
+        uint32_t lost;
+        uint32_t carrier_sense;
+        uint32_t carrier_busy;
+        uint32_t delivered;
+        uint32_t delivered_bytes;
+        uint32_t acknowledged;
+        bc_tick_t airtime;
+
+    } stats;
+
+} _bc_host_radio_medium = { .fd = -1 };
+
+static void _bc_host_radio_medium_run(void) __attribute__((noreturn));
+static void _bc_host_radio_medium_receive(int index);
+static void _bc_host_radio_medium_transmit(int index, _bc_host_radio_medium_message_t *message);
+static void _bc_host_radio_medium_carrier_sense(int index, _bc_host_radio_medium_message_t *message);
+static void _bc_host_radio_medium_deliver(_bc_host_radio_medium_frame_t *frame);
+static bool _bc_host_radio_medium_wake(int index, const _bc_host_radio_medium_frame_t *frame);
+static void _bc_host_radio_medium_report(void) __attribute__((noreturn));
+static void _bc_host_radio_medium_tx_handler(const void *buffer, size_t length, void *param);
+static bool _bc_host_radio_medium_carrier_sense_handler(uint8_t channel, void *param);
+static bool _bc_host_radio_medium_atsha204(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param);
+static uint16_t _bc_host_radio_medium_crc16(const uint8_t *buffer, size_t length);
+
+int bc_host_radio_medium_start(const bc_host_radio_medium_config_t *config)
+{
+    _bc_host_radio_medium.config = *config;
+
+    if (_bc_host_radio_medium.config.gateway_count == 0)
+    {
+        _bc_host_radio_medium.config.gateway_count = 1;
+    }
+
+    if (config->datarate != 0)
+    {
+        bc_host_spirit1_set_datarate(config->datarate);
+    }
+
+    _bc_host_radio_medium.nodes = calloc(config->node_count, sizeof(_bc_host_radio_medium_node_t));
+
+    if (_bc_host_radio_medium.nodes == NULL)
+    {
+        abort();
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    for (int i = 0; i < config->node_count; i++)
+    {
+        int fd[2];
+
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fd) != 0)
+        {
+            abort();
+        }
+
+        pid_t pid = fork();
+
+        if (pid < 0)
+        {
+            abort();
+        }
+
+        if (pid == 0)
+        {
+            close(fd[0]);
+
+            // Sockets of previously forked nodes belong to medium only
+            for (int j = 0; j < i; j++)
+            {
+                close(_bc_host_radio_medium.nodes[j].fd);
+            }
+
+            free(_bc_host_radio_medium.nodes);
+
+            _bc_host_radio_medium.nodes = NULL;
+            _bc_host_radio_medium.fd = fd[1];
+            _bc_host_radio_medium.index = i;
+
+            srand(config->seed + i);
+
+            bc_host_spirit1_set_tx_handler(_bc_host_radio_medium_tx_handler, NULL);
+
+            bc_host_spirit1_set_carrier_sense_handler(_bc_host_radio_medium_carrier_sense_handler, NULL);
+
+            bc_host_i2c_attach(BC_I2C_I2C0, _BC_HOST_RADIO_MEDIUM_ATSHA204_ADDRESS, _bc_host_radio_medium_atsha204, NULL);
+
+            return i;
+        }
+
+        close(fd[1]);
+
+        _bc_host_radio_medium.nodes[i].fd = fd[0];
+        _bc_host_radio_medium.nodes[i].state = _BC_HOST_RADIO_MEDIUM_NODE_RUNNING;
+    }
+
+    srand(config->seed);
+
+    _bc_host_radio_medium_run();
+}
+
+bc_tick_t bc_host_radio_medium_sleep(bc_tick_t tick)
+{
+    if (_bc_host_radio_medium.fd < 0)
+    {
+        return tick;
+    }
+
+    // Medium learns whether the last frame has been accepted by receiver
+    _bc_host_radio_medium_message_t message = { .type = _BC_HOST_RADIO_MEDIUM_MESSAGE_SLEEP, .tick = tick, .received = _bc_host_radio_medium.received, .channel = bc_spirit1_get_channel() };
+
+    if (send(_bc_host_radio_medium.fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    // Medium is gone when simulation has ended
+    if (recv(_bc_host_radio_medium.fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        exit(EXIT_SUCCESS);
+    }
+
+    _bc_host_radio_medium.received = (message.length != 0) && bc_host_spirit1_receive(message.buffer, message.length);
+
+    return message.tick;
+}
+
+static void _bc_host_radio_medium_run(void)
+{
+    while (true)
+    {
+        // Nodes run at the same simulated time until all of them sleep
+        for (int i = 0; i < _bc_host_radio_medium.config.node_count; i++)
+        {
+            while (_bc_host_radio_medium.nodes[i].state == _BC_HOST_RADIO_MEDIUM_NODE_RUNNING)
+            {
+                _bc_host_radio_medium_receive(i);
+            }
+        }
+
+        // The earliest event is end of frame or wake-up of node, end of frame goes first
+        _bc_host_radio_medium_frame_t *frame = NULL;
+        bc_tick_t tick = BC_TICK_INFINITY;
+        bool sleeping = false;
+
+        for (int i = 0; i < _bc_host_radio_medium.config.node_count; i++)
+        {
+            if (_bc_host_radio_medium.nodes[i].state == _BC_HOST_RADIO_MEDIUM_NODE_SLEEPING)
+            {
+                sleeping = true;
+
+                if (_bc_host_radio_medium.nodes[i].tick_wakeup < tick)
+                {
+                    tick = _bc_host_radio_medium.nodes[i].tick_wakeup;
+                }
+            }
+        }
+
+        for (int i = 0; i < _bc_host_radio_medium.frames_length; i++)
+        {
+            if (_bc_host_radio_medium.frames[i].tick_end <= tick)
+            {
+                frame = &_bc_host_radio_medium.frames[i];
+
+                tick = frame->tick_end;
+            }
+        }
+
+        // All nodes have exited or nothing will ever happen
+        if (!sleeping || (tick == BC_TICK_INFINITY))
+        {
+            _bc_host_radio_medium_report();
+        }
+
+        _bc_host_radio_medium.tick = tick;
+
+        if (frame != NULL)
+        {
+            _bc_host_radio_medium_deliver(frame);
+
+            *frame = _bc_host_radio_medium.frames[--_bc_host_radio_medium.frames_length];
+
+            continue;
+        }
+
+        for (int i = 0; i < _bc_host_radio_medium.config.node_count; i++)
+        {
+            if ((_bc_host_radio_medium.nodes[i].state == _BC_HOST_RADIO_MEDIUM_NODE_SLEEPING) && (_bc_host_radio_medium.nodes[i].tick_wakeup == tick))
+            {
+                _bc_host_radio_medium_wake(i, NULL);
+            }
+        }
+    }
+}
+
+static void _bc_host_radio_medium_receive(int index)
+{
+    _bc_host_radio_medium_node_t *node = &_bc_host_radio_medium.nodes[index];
+    _bc_host_radio_medium_message_t message;
+
+    if (recv(node->fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        close(node->fd);
+
+        node->state = _BC_HOST_RADIO_MEDIUM_NODE_EXITED;
+
+        return;
+    }
+
+    if (message.type == _BC_HOST_RADIO_MEDIUM_MESSAGE_TX)
+    {
+        _bc_host_radio_medium_transmit(index, &message);
+    }
+    else if (message.type == _BC_HOST_RADIO_MEDIUM_MESSAGE_SLEEP)
+    {
+        node->state = _BC_HOST_RADIO_MEDIUM_NODE_SLEEPING;
+        node->tick_wakeup = message.tick;
+        node->received = message.received;
+        node->channel = message.channel;
+    }
+    else if (message.type == _BC_HOST_RADIO_MEDIUM_MESSAGE_CARRIER_SENSE)
+    {
+        _bc_host_radio_medium_carrier_sense(index, &message);
+    }
+}
+
+static void _bc_host_radio_medium_transmit(int index, _bc_host_radio_medium_message_t *message)
+{
+    _bc_host_radio_medium_node_t *node = &_bc_host_radio_medium.nodes[index];
+
+    if ((_bc_host_radio_medium.frames_length == _BC_HOST_RADIO_MEDIUM_MAX_FRAMES) || (message->length > BC_SPIRIT1_MAX_PACKET_SIZE))
+    {
+        abort();
+    }
+
+    _bc_host_radio_medium_frame_t *frame = &_bc_host_radio_medium.frames[_bc_host_radio_medium.frames_length++];
+
+    frame->sender = index;
+    frame->channel = message->channel;
+    frame->tick_start = message->tick;
+    frame->tick_end = message->tick + bc_host_spirit1_get_airtime(message->length);
+    frame->collided = false;
+    frame->length = message->length;
+
+    memcpy(frame->buffer, message->buffer, message->length);
+
+    _bc_host_radio_medium.stats.frames++;
+    _bc_host_radio_medium.stats.airtime += frame->tick_end - frame->tick_start;
+
+    if (_bc_host_radio_medium.config.collision == BC_HOST_RADIO_MEDIUM_COLLISION_DESTRUCTIVE)
+    {
+        // Every frame on air overlaps with the new one, frames on other channels do not interfere
+        for (int i = 0; i < _bc_host_radio_medium.frames_length - 1; i++)
+        {
+            if ((_bc_host_radio_medium.frames[i].tick_end > frame->tick_start) && (_bc_host_radio_medium.frames[i].channel == frame->channel))
+            {
+                if (!_bc_host_radio_medium.frames[i].collided)
+                {
+                    _bc_host_radio_medium.frames[i].collided = true;
+
+                    _bc_host_radio_medium.stats.collided++;
+                }
+
+                if (!frame->collided)
+                {
+                    frame->collided = true;
+
+                    _bc_host_radio_medium.stats.collided++;
+                }
+            }
+        }
+    }
+
+    if (frame->length <= _BC_HOST_RADIO_MEDIUM_HEADER_OFFSET)
+    {
+        return;
+    }
+
+    if (frame->buffer[_BC_HOST_RADIO_MEDIUM_HEADER_OFFSET] == _BC_HOST_RADIO_MEDIUM_HEADER_ACK)
+    {
+        _bc_host_radio_medium.stats.ack_frames++;
+
+        return;
+    }
+
+    uint16_t message_id = frame->buffer[6] | (uint16_t) frame->buffer[7] << 8;
+
+    node->tx_count++;
+
+    // Retransmissions keep message ID
+    if (!node->message_id_valid || (node->message_id != message_id))
+    {
+        node->message_id = message_id;
+        node->message_id_valid = true;
+        node->message_count++;
+    }
+}
+
+static void _bc_host_radio_medium_carrier_sense(int index, _bc_host_radio_medium_message_t *message)
+{
+    _bc_host_radio_medium_node_t *node = &_bc_host_radio_medium.nodes[index];
+
+    // Frame which starts at the same tick is not heard yet
+    message->received = false;
+
+    for (int i = 0; i < _bc_host_radio_medium.frames_length; i++)
+    {
+        _bc_host_radio_medium_frame_t *frame = &_bc_host_radio_medium.frames[i];
+
+        if ((frame->channel == message->channel) && (frame->tick_start < message->tick) && (frame->tick_end > message->tick))
+        {
+            message->received = true;
+
+            break;
+        }
+    }
+
+    _bc_host_radio_medium.stats.carrier_sense++;
+
+    if (message->received)
+    {
+        _bc_host_radio_medium.stats.carrier_busy++;
+    }
+
+    if (send(node->fd, message, sizeof(*message), 0) != sizeof(*message))
+    {
+        close(node->fd);
+
+        node->state = _BC_HOST_RADIO_MEDIUM_NODE_EXITED;
+    }
+}
+
+static void _bc_host_radio_medium_deliver(_bc_host_radio_medium_frame_t *frame)
+{
+    bool ack = (frame->length > _BC_HOST_RADIO_MEDIUM_HEADER_OFFSET) && (frame->buffer[_BC_HOST_RADIO_MEDIUM_HEADER_OFFSET] == _BC_HOST_RADIO_MEDIUM_HEADER_ACK);
+    uint16_t message_id = frame->buffer[6] | (uint16_t) frame->buffer[7] << 8;
+
+    for (int i = 0; i < _bc_host_radio_medium.config.node_count; i++)
+    {
+        _bc_host_radio_medium_node_t *node = &_bc_host_radio_medium.nodes[i];
+
+        if ((i == frame->sender) || (node->state == _BC_HOST_RADIO_MEDIUM_NODE_EXITED) || (node->channel != frame->channel) || frame->collided)
+        {
+            continue;
+        }
+
+        if ((_bc_host_radio_medium.config.loss > 0) && (rand() < _bc_host_radio_medium.config.loss * ((float) RAND_MAX + 1)))
+        {
+            _bc_host_radio_medium.stats.lost++;
+
+            continue;
+        }
+
+        // Receiver which is not listening (e.g. it transmits) misses frame
+        if (!_bc_host_radio_medium_wake(i, frame) || (frame->length <= _BC_HOST_RADIO_MEDIUM_HEADER_OFFSET))
+        {
+            continue;
+        }
+
+        if (ack)
+        {
+            // ACK carries ID and message ID of acknowledged frame
+            uint64_t id = 0;
+
+            memcpy(&id, frame->buffer, 6);
+
+            if ((id == (uint64_t) 0xbc00 + ((uint64_t) (i + 1) << 16)) && (!node->message_id_acknowledged_valid || (node->message_id_acknowledged != message_id)))
+            {
+                node->message_id_acknowledged = message_id;
+                node->message_id_acknowledged_valid = true;
+
+                _bc_host_radio_medium.stats.acknowledged++;
+            }
+        }
+        else if (i < _bc_host_radio_medium.config.gateway_count)
+        {
+            // The first nodes are gateways
+            _bc_host_radio_medium_node_t *sender = &_bc_host_radio_medium.nodes[frame->sender];
+
+            if (!sender->message_id_delivered_valid || (sender->message_id_delivered != message_id))
+            {
+                sender->message_id_delivered = message_id;
+                sender->message_id_delivered_valid = true;
+
+                _bc_host_radio_medium.stats.delivered++;
+                _bc_host_radio_medium.stats.delivered_bytes += frame->length - _BC_HOST_RADIO_MEDIUM_HEADER_OFFSET;
+            }
+        }
+    }
+}
+
+static bool _bc_host_radio_medium_wake(int index, const _bc_host_radio_medium_frame_t *frame)
+{
+    _bc_host_radio_medium_node_t *node = &_bc_host_radio_medium.nodes[index];
+    _bc_host_radio_medium_message_t message = { .type = _BC_HOST_RADIO_MEDIUM_MESSAGE_WAKE, .tick = _bc_host_radio_medium.tick };
+
+    if (node->state != _BC_HOST_RADIO_MEDIUM_NODE_SLEEPING)
+    {
+        return false;
+    }
+
+    if (frame != NULL)
+    {
+        message.length = frame->length;
+
+        memcpy(message.buffer, frame->buffer, frame->length);
+    }
+
+    if (send(node->fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        close(node->fd);
+
+        node->state = _BC_HOST_RADIO_MEDIUM_NODE_EXITED;
+
+        return false;
+    }
+
+    node->state = _BC_HOST_RADIO_MEDIUM_NODE_RUNNING;
+
+    // Node handles frame before the next one is delivered
+    while (node->state == _BC_HOST_RADIO_MEDIUM_NODE_RUNNING)
+    {
+        _bc_host_radio_medium_receive(index);
+    }
+
+    return (node->state == _BC_HOST_RADIO_MEDIUM_NODE_SLEEPING) && node->received;
+}
+
+static void _bc_host_radio_medium_report(void)
+{
+    uint32_t tx_count = 0;
+    uint32_t message_count = 0;
+
+    for (int i = 0; i < _bc_host_radio_medium.config.node_count; i++)
+    {
+        if (_bc_host_radio_medium.nodes[i].state != _BC_HOST_RADIO_MEDIUM_NODE_EXITED)
+        {
+            close(_bc_host_radio_medium.nodes[i].fd);
+        }
+
+        tx_count += _bc_host_radio_medium.nodes[i].tx_count;
+        message_count += _bc_host_radio_medium.nodes[i].message_count;
+    }
+
+    while (wait(NULL) > 0)
+    {
+        continue;
+    }
+
+    bc_tick_t tick = _bc_host_radio_medium.tick;
+
+    fprintf(stderr, "bc_host: radio medium with %d nodes, %" PRIu64 " ms\n", _bc_host_radio_medium.config.node_count, tick);
+
+    fprintf(stderr, "bc_host: %" PRIu32 " frames (%" PRIu32 " ACK), %" PRIu32 " retransmissions, %" PRIu32 " collided, %" PRIu32 " lost\n",
+            _bc_host_radio_medium.stats.frames, _bc_host_radio_medium.stats.ack_frames, tx_count - message_count,
+            _bc_host_radio_medium.stats.collided, _bc_host_radio_medium.stats.lost);
+
+    if (_bc_host_radio_medium.stats.carrier_sense != 0)
+    {
+        fprintf(stderr, "bc_host: %" PRIu32 " carrier senses, %" PRIu32 " found busy channel\n",
+                _bc_host_radio_medium.stats.carrier_sense, _bc_host_radio_medium.stats.carrier_busy);
+    }
+
+    fprintf(stderr, "bc_host: %" PRIu32 " of %" PRIu32 " messages delivered (%.2f per second), %" PRIu32 " acknowledged, %.2f transmissions per message\n",
+            _bc_host_radio_medium.stats.delivered, message_count, tick != 0 ? _bc_host_radio_medium.stats.delivered * 1000.f / tick : 0.f,
+            _bc_host_radio_medium.stats.acknowledged, message_count != 0 ? (float) tx_count / message_count : 0.f);
+
+    fprintf(stderr, "bc_host: %" PRIu64 " ms airtime (%.1f %% of time), %.2f ms per delivered byte\n",
+            _bc_host_radio_medium.stats.airtime, tick != 0 ? _bc_host_radio_medium.stats.airtime * 100.f / tick : 0.f,
+            _bc_host_radio_medium.stats.delivered_bytes != 0 ? (float) _bc_host_radio_medium.stats.airtime / _bc_host_radio_medium.stats.delivered_bytes : 0.f);
+
+    exit(EXIT_SUCCESS);
+}
+
+static void _bc_host_radio_medium_tx_handler(const void *buffer, size_t length, void *param)
+{
+    (void) param;
+
+    _bc_host_radio_medium_message_t message = { .type = _BC_HOST_RADIO_MEDIUM_MESSAGE_TX, .tick = bc_tick_get(), .channel = bc_spirit1_get_channel(), .length = length };
+
+    memcpy(message.buffer, buffer, length);
+
+    if (send(_bc_host_radio_medium.fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        exit(EXIT_FAILURE);
+    }
+}
+
+static bool _bc_host_radio_medium_carrier_sense_handler(uint8_t channel, void *param)
+{
+    (void) param;
+
+    _bc_host_radio_medium_message_t message = { .type = _BC_HOST_RADIO_MEDIUM_MESSAGE_CARRIER_SENSE, .tick = bc_tick_get(), .channel = channel };
+
+    if (send(_bc_host_radio_medium.fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    // Medium is gone when simulation has ended
+    if (recv(_bc_host_radio_medium.fd, &message, sizeof(message), 0) != sizeof(message))
+    {
+        exit(EXIT_SUCCESS);
+    }
+
+    return message.received;
+}
+
+static bool _bc_host_radio_medium_atsha204(bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length, void *param)
+{
+    (void) memory_address;
+    (void) param;
+
+    uint8_t *data = buffer;
+
+    if (operation == BC_HOST_I2C_OPERATION_WRITE)
+    {
+        // Read command with word address in parameter 1
+        if ((length == 8) && (data[2] == 0x02))
+        {
+            _bc_host_radio_medium.serial_number_address = data[4];
+        }
+
+        return true;
+    }
+
+    if ((operation != BC_HOST_I2C_OPERATION_READ) || (length != 7))
+    {
+        return false;
+    }
+
+    // Serial number gives radio ID 0x00NNNN00bc00 where NNNN is node index increased by one
+    uint32_t node = _bc_host_radio_medium.index + 1;
+
+    data[0] = 7;
+
+    if (_bc_host_radio_medium.serial_number_address == 0)
+    {
+        data[1] = 0x01;
+        data[2] = 0x23;
+        data[3] = 0x00;
+        data[4] = 0xbc;
+    }
+    else
+    {
+        data[1] = node;
+        data[2] = node >> 8;
+        data[3] = 0x00;
+        data[4] = 0x00;
+    }
+
+    uint16_t crc = _bc_host_radio_medium_crc16(data, 5);
+
+    data[5] = crc;
+    data[6] = crc >> 8;
+
+    return true;
+}
+
+static uint16_t _bc_host_radio_medium_crc16(const uint8_t *buffer, size_t length)
+{
+    uint16_t crc16 = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        for (uint8_t shift_register = 0x01; shift_register != 0x00; shift_register <<= 1)
+        {
+            uint8_t data_bit = (buffer[i] & shift_register) ? 1 : 0;
+            uint8_t crc_bit = crc16 >> 15;
+
+            crc16 <<= 1;
+
+            if (data_bit != crc_bit)
+            {
+                crc16 ^= 0x8005;
+            }
+        }
+    }
+
+    return crc16;
+}
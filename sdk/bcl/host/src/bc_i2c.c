@@ -0,0 +1,552 @@
+#include <bc_i2c.h>
+#include <bc_scheduler.h>
+#include <bc_host.h>
+
+// Queue of this file is a model of bcl/src/bc_i2c.c for simulated devices, the interrupt driven engine of target is run
+// on host by example i2c-async
+#define _BC_I2C_DEVICE_COUNT 16
+
+// Same timeout as on target (1.5 times transfer time with 10 ms margin)
+#define _BC_I2C_TIMEOUT_ADJUST_FACTOR 1.5
+#define _BC_I2C_BYTE_TRANSFER_TIME_US_100 80
+#define _BC_I2C_BYTE_TRANSFER_TIME_US_400 20
+
+#define _BC_I2C_ASYNC_MAX_LENGTH 253
+
+typedef struct
+{
+    bc_i2c_channel_t channel;
+    uint8_t device_address;
+    bool (*handler)(bc_host_i2c_operation_t, uint32_t, void *, size_t, void *);
+    void *param;
+    bc_tick_t delay;
+
+} _bc_i2c_device_t;
+
+typedef enum
+{
+    _BC_I2C_ASYNC_STATE_IDLE = 0,
+    _BC_I2C_ASYNC_STATE_RUNNING = 1,
+    _BC_I2C_ASYNC_STATE_DONE = 2,
+    _BC_I2C_ASYNC_STATE_ERROR = 3
+
+} _bc_i2c_async_state_t;
+
+typedef struct
+{
+    bc_i2c_channel_t channel;
+    uint8_t device_address;
+    bc_i2c_priority_t priority;
+    bc_i2c_device_stats_t stats;
+
+} _bc_i2c_client_t;
+
+typedef struct
+{
+    bc_host_i2c_operation_t operation;
+    bc_i2c_priority_t priority;
+    uint8_t device_address;
+    uint32_t memory_address;
+    void *buffer;
+    size_t length;
+    void (*event_handler)(bc_i2c_event_t, void *);
+    void *event_param;
+    bc_tick_t tick_request;
+
+} _bc_i2c_async_transfer_t;
+
+static struct
+{
+    struct
+    {
+        bool initialized;
+        bc_i2c_speed_t speed;
+        bool async_initialized;
+        bc_scheduler_task_id_t async_task_id;
+        _bc_i2c_async_transfer_t async_queue[BC_I2C_ASYNC_QUEUE_SIZE];
+        int async_queue_head;
+        int async_queue_length;
+        _bc_i2c_async_state_t async_state;
+        bc_tick_t async_tick_done;
+        bc_tick_t async_tick_timeout;
+
+    } channel[BC_I2C_I2C_1W + 1];
+
+    _bc_i2c_device_t device[_BC_I2C_DEVICE_COUNT];
+    int device_count;
+
+    // Priorities and statistics of devices as seen by application
+    _bc_i2c_client_t client[BC_I2C_DEVICE_COUNT];
+    int client_count;
+
+} _bc_i2c;
+
+static bool _bc_i2c_transfer(bc_i2c_channel_t channel, uint8_t device_address, bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length);
+static _bc_i2c_device_t *_bc_i2c_find_device(bc_i2c_channel_t channel, uint8_t device_address);
+static _bc_i2c_client_t *_bc_i2c_get_client(bc_i2c_channel_t channel, uint8_t device_address);
+static void _bc_i2c_update_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t tick_request, bool success);
+static bc_tick_t _bc_i2c_get_transfer_time(bc_i2c_channel_t channel, size_t length);
+static bc_tick_t _bc_i2c_get_timeout(bc_i2c_channel_t channel, size_t length);
+static bool _bc_i2c_async_submit(bc_i2c_channel_t channel, bc_host_i2c_operation_t operation, uint8_t device_address, uint32_t memory_address, void *buffer, size_t length, void (*event_handler)(bc_i2c_event_t, void *), void *event_param);
+static void _bc_i2c_async_task(void *param);
+static void _bc_i2c_async_start(bc_i2c_channel_t channel);
+static void _bc_i2c_async_complete(bc_i2c_channel_t channel);
+
+void bc_i2c_init(bc_i2c_channel_t channel, bc_i2c_speed_t speed)
+{
+    if (_bc_i2c.channel[channel].initialized)
+    {
+        return;
+    }
+
+    _bc_i2c.channel[channel].initialized = true;
+
+    bc_i2c_set_speed(channel, speed);
+}
+
+bc_i2c_speed_t bc_i2c_get_speed(bc_i2c_channel_t channel)
+{
+    return _bc_i2c.channel[channel].speed;
+}
+
+void bc_i2c_set_speed(bc_i2c_channel_t channel, bc_i2c_speed_t speed)
+{
+    _bc_i2c.channel[channel].speed = speed;
+}
+
+bool bc_i2c_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
+{
+    return _bc_i2c_transfer(channel, transfer->device_address, BC_HOST_I2C_OPERATION_WRITE, 0, transfer->buffer, transfer->length);
+}
+
+bool bc_i2c_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
+{
+    return _bc_i2c_transfer(channel, transfer->device_address, BC_HOST_I2C_OPERATION_READ, 0, transfer->buffer, transfer->length);
+}
+
+bool bc_i2c_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
+{
+    return _bc_i2c_transfer(channel, transfer->device_address, BC_HOST_I2C_OPERATION_MEMORY_WRITE, transfer->memory_address, transfer->buffer, transfer->length);
+}
+
+bool bc_i2c_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
+{
+    return _bc_i2c_transfer(channel, transfer->device_address, BC_HOST_I2C_OPERATION_MEMORY_READ, transfer->memory_address, transfer->buffer, transfer->length);
+}
+
+bool bc_i2c_memory_write_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t data)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = &data;
+    transfer.length = 1;
+
+    return bc_i2c_memory_write(channel, &transfer);
+}
+
+bool bc_i2c_memory_write_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t data)
+{
+    uint8_t buffer[2];
+
+    buffer[0] = data >> 8;
+    buffer[1] = data;
+
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = 2;
+
+    return bc_i2c_memory_write(channel, &transfer);
+}
+
+bool bc_i2c_memory_read_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t *data)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = data;
+    transfer.length = 1;
+
+    return bc_i2c_memory_read(channel, &transfer);
+}
+
+bool bc_i2c_memory_read_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t *data)
+{
+    uint8_t buffer[2];
+
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = 2;
+
+    if (!bc_i2c_memory_read(channel, &transfer))
+    {
+        return false;
+    }
+
+    *data = buffer[0] << 8 | buffer[1];
+
+    return true;
+}
+
+bool bc_i2c_async_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, BC_HOST_I2C_OPERATION_WRITE, transfer->device_address, 0, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_async_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, BC_HOST_I2C_OPERATION_READ, transfer->device_address, 0, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_async_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, BC_HOST_I2C_OPERATION_MEMORY_WRITE, transfer->device_address, transfer->memory_address, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_async_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, BC_HOST_I2C_OPERATION_MEMORY_READ, transfer->device_address, transfer->memory_address, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_is_ready(bc_i2c_channel_t channel)
+{
+    return (_bc_i2c.channel[channel].async_queue_length == 0);
+}
+
+bool bc_i2c_set_device_priority(bc_i2c_channel_t channel, uint8_t device_address, bc_i2c_priority_t priority)
+{
+    _bc_i2c_client_t *client = _bc_i2c_get_client(channel, device_address);
+
+    if (client == NULL)
+    {
+        return false;
+    }
+
+    client->priority = priority;
+
+    return true;
+}
+
+bool bc_i2c_get_device_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_i2c_device_stats_t *stats)
+{
+    for (int i = 0; i < _bc_i2c.client_count; i++)
+    {
+        if ((_bc_i2c.client[i].channel == channel) && (_bc_i2c.client[i].device_address == device_address))
+        {
+            *stats = _bc_i2c.client[i].stats;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool bc_host_i2c_attach(bc_i2c_channel_t channel, uint8_t device_address, bool (*handler)(bc_host_i2c_operation_t, uint32_t, void *, size_t, void *), void *param)
+{
+    if (_bc_i2c.device_count == _BC_I2C_DEVICE_COUNT)
+    {
+        return false;
+    }
+
+    _bc_i2c_device_t *device = &_bc_i2c.device[_bc_i2c.device_count++];
+
+    device->channel = channel;
+    device->device_address = device_address;
+    device->handler = handler;
+    device->param = param;
+    device->delay = 0;
+
+    return true;
+}
+
+bool bc_host_i2c_set_delay(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t delay)
+{
+    _bc_i2c_device_t *device = _bc_i2c_find_device(channel, device_address);
+
+    if (device == NULL)
+    {
+        return false;
+    }
+
+    device->delay = delay;
+
+    return true;
+}
+
+static bool _bc_i2c_transfer(bc_i2c_channel_t channel, uint8_t device_address, bc_host_i2c_operation_t operation, uint32_t memory_address, void *buffer, size_t length)
+{
+    bc_tick_t tick_request = bc_tick_get();
+    bool success = false;
+
+    if (!_bc_i2c.channel[channel].initialized)
+    {
+        return false;
+    }
+
+    // Blocking transfer waits until transfer running in background is finished
+    if (_bc_i2c.channel[channel].async_state == _BC_I2C_ASYNC_STATE_RUNNING)
+    {
+        _bc_i2c_async_complete(channel);
+
+        bc_scheduler_plan_now(_bc_i2c.channel[channel].async_task_id);
+    }
+
+    _bc_i2c_device_t *device = _bc_i2c_find_device(channel, device_address);
+
+    // Nobody acknowledged device address, device which stretches clock longer than timeout is abandoned
+    if ((device != NULL) && (device->delay <= _bc_i2c_get_timeout(channel, length) - _bc_i2c_get_transfer_time(channel, length)))
+    {
+        success = device->handler(operation, memory_address, buffer, length, device->param);
+    }
+
+    _bc_i2c_update_stats(channel, device_address, tick_request, success);
+
+    return success;
+}
+
+static _bc_i2c_device_t *_bc_i2c_find_device(bc_i2c_channel_t channel, uint8_t device_address)
+{
+    for (int i = 0; i < _bc_i2c.device_count; i++)
+    {
+        _bc_i2c_device_t *device = &_bc_i2c.device[i];
+
+        if ((device->channel == channel) && (device->device_address == device_address))
+        {
+            return device;
+        }
+    }
+
+    return NULL;
+}
+
+static _bc_i2c_client_t *_bc_i2c_get_client(bc_i2c_channel_t channel, uint8_t device_address)
+{
+    for (int i = 0; i < _bc_i2c.client_count; i++)
+    {
+        if ((_bc_i2c.client[i].channel == channel) && (_bc_i2c.client[i].device_address == device_address))
+        {
+            return &_bc_i2c.client[i];
+        }
+    }
+
+    if (_bc_i2c.client_count == BC_I2C_DEVICE_COUNT)
+    {
+        return NULL;
+    }
+
+    _bc_i2c_client_t *client = &_bc_i2c.client[_bc_i2c.client_count++];
+
+    memset(client, 0, sizeof(*client));
+
+    client->channel = channel;
+    client->device_address = device_address;
+    client->priority = BC_I2C_PRIORITY_NORMAL;
+
+    return client;
+}
+
+static void _bc_i2c_update_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t tick_request, bool success)
+{
+    _bc_i2c_client_t *client = _bc_i2c_get_client(channel, device_address);
+
+    if (client == NULL)
+    {
+        return;
+    }
+
+    bc_tick_t latency = bc_tick_get() - tick_request;
+
+    client->stats.transfer_count++;
+
+    if (!success)
+    {
+        client->stats.error_count++;
+    }
+
+    client->stats.latency_total += latency;
+
+    if (client->stats.latency_max < latency)
+    {
+        client->stats.latency_max = latency;
+    }
+}
+
+static bc_tick_t _bc_i2c_get_transfer_time(bc_i2c_channel_t channel, size_t length)
+{
+    uint32_t byte_time_us = _bc_i2c.channel[channel].speed == BC_I2C_SPEED_100_KHZ ? _BC_I2C_BYTE_TRANSFER_TIME_US_100 : _BC_I2C_BYTE_TRANSFER_TIME_US_400;
+
+    return (byte_time_us * (length + 3) + 999) / 1000;
+}
+
+static bc_tick_t _bc_i2c_get_timeout(bc_i2c_channel_t channel, size_t length)
+{
+    uint32_t byte_time_us = _bc_i2c.channel[channel].speed == BC_I2C_SPEED_100_KHZ ? _BC_I2C_BYTE_TRANSFER_TIME_US_100 : _BC_I2C_BYTE_TRANSFER_TIME_US_400;
+
+    return _BC_I2C_TIMEOUT_ADJUST_FACTOR * ((byte_time_us * (length + 3)) / 1000 + 10);
+}
+
+static bool _bc_i2c_async_submit(bc_i2c_channel_t channel, bc_host_i2c_operation_t operation, uint8_t device_address, uint32_t memory_address, void *buffer, size_t length, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    if (!_bc_i2c.channel[channel].initialized)
+    {
+        return false;
+    }
+
+    if ((_bc_i2c.channel[channel].async_queue_length == BC_I2C_ASYNC_QUEUE_SIZE) || (length > _BC_I2C_ASYNC_MAX_LENGTH))
+    {
+        return false;
+    }
+
+    if ((length == 0) && ((operation == BC_HOST_I2C_OPERATION_READ) || (operation == BC_HOST_I2C_OPERATION_MEMORY_READ)))
+    {
+        return false;
+    }
+
+    if (!_bc_i2c.channel[channel].async_initialized)
+    {
+        _bc_i2c.channel[channel].async_task_id = bc_scheduler_register(_bc_i2c_async_task, (void *) (size_t) channel, BC_TICK_INFINITY);
+
+        _bc_i2c.channel[channel].async_initialized = true;
+    }
+
+    _bc_i2c_client_t *client = _bc_i2c_get_client(channel, device_address);
+
+    _bc_i2c_async_transfer_t transfer;
+
+    transfer.operation = operation;
+    transfer.priority = client != NULL ? client->priority : BC_I2C_PRIORITY_NORMAL;
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = length;
+    transfer.event_handler = event_handler;
+    transfer.event_param = event_param;
+    transfer.tick_request = bc_tick_get();
+
+    // Transfer at head keeps its position until its event is delivered
+    int first = _bc_i2c.channel[channel].async_state != _BC_I2C_ASYNC_STATE_IDLE ? 1 : 0;
+    int i = _bc_i2c.channel[channel].async_queue_length;
+
+    // Transfer is placed behind all waiting transfers of the same or higher priority
+    while ((i > first) && (_bc_i2c.channel[channel].async_queue[(_bc_i2c.channel[channel].async_queue_head + i - 1) % BC_I2C_ASYNC_QUEUE_SIZE].priority < transfer.priority))
+    {
+        _bc_i2c.channel[channel].async_queue[(_bc_i2c.channel[channel].async_queue_head + i) % BC_I2C_ASYNC_QUEUE_SIZE] =
+                _bc_i2c.channel[channel].async_queue[(_bc_i2c.channel[channel].async_queue_head + i - 1) % BC_I2C_ASYNC_QUEUE_SIZE];
+
+        i--;
+    }
+
+    _bc_i2c.channel[channel].async_queue[(_bc_i2c.channel[channel].async_queue_head + i) % BC_I2C_ASYNC_QUEUE_SIZE] = transfer;
+
+    _bc_i2c.channel[channel].async_queue_length++;
+
+    if (_bc_i2c.channel[channel].async_state == _BC_I2C_ASYNC_STATE_IDLE)
+    {
+        bc_scheduler_plan_now(_bc_i2c.channel[channel].async_task_id);
+    }
+
+    return true;
+}
+
+static void _bc_i2c_async_task(void *param)
+{
+    bc_i2c_channel_t channel = (bc_i2c_channel_t) (size_t) param;
+
+    if (_bc_i2c.channel[channel].async_state == _BC_I2C_ASYNC_STATE_RUNNING)
+    {
+        bc_tick_t tick_now = bc_tick_get();
+
+        if ((tick_now < _bc_i2c.channel[channel].async_tick_done) && (tick_now < _bc_i2c.channel[channel].async_tick_timeout))
+        {
+            bc_scheduler_plan_current_absolute(_bc_i2c.channel[channel].async_tick_done < _bc_i2c.channel[channel].async_tick_timeout ?
+                    _bc_i2c.channel[channel].async_tick_done : _bc_i2c.channel[channel].async_tick_timeout);
+
+            return;
+        }
+
+        _bc_i2c_async_complete(channel);
+    }
+
+    if (_bc_i2c.channel[channel].async_state == _BC_I2C_ASYNC_STATE_IDLE)
+    {
+        if (_bc_i2c.channel[channel].async_queue_length != 0)
+        {
+            _bc_i2c_async_start(channel);
+        }
+
+        return;
+    }
+
+    _bc_i2c_async_transfer_t transfer = _bc_i2c.channel[channel].async_queue[_bc_i2c.channel[channel].async_queue_head];
+
+    bool success = _bc_i2c.channel[channel].async_state == _BC_I2C_ASYNC_STATE_DONE;
+
+    _bc_i2c.channel[channel].async_queue_head = (_bc_i2c.channel[channel].async_queue_head + 1) % BC_I2C_ASYNC_QUEUE_SIZE;
+    _bc_i2c.channel[channel].async_queue_length--;
+
+    _bc_i2c.channel[channel].async_state = _BC_I2C_ASYNC_STATE_IDLE;
+
+    if (_bc_i2c.channel[channel].async_queue_length != 0)
+    {
+        _bc_i2c_async_start(channel);
+    }
+
+    _bc_i2c_update_stats(channel, transfer.device_address, transfer.tick_request, success);
+
+    if (transfer.event_handler != NULL)
+    {
+        transfer.event_handler(success ? BC_I2C_EVENT_DONE : BC_I2C_EVENT_ERROR, transfer.event_param);
+    }
+}
+
+static void _bc_i2c_async_start(bc_i2c_channel_t channel)
+{
+    _bc_i2c_async_transfer_t *transfer = &_bc_i2c.channel[channel].async_queue[_bc_i2c.channel[channel].async_queue_head];
+    size_t length = transfer->length;
+    bc_tick_t tick_now = bc_tick_get();
+
+    if ((transfer->operation == BC_HOST_I2C_OPERATION_MEMORY_WRITE) || (transfer->operation == BC_HOST_I2C_OPERATION_MEMORY_READ))
+    {
+        length += (transfer->memory_address & BC_I2C_MEMORY_ADDRESS_16_BIT) != 0 ? 2 : 1;
+    }
+
+    _bc_i2c_device_t *device = _bc_i2c_find_device(channel, transfer->device_address);
+
+    // Device is accessed when its clock stretching ends, missing device NACKs right after address
+    _bc_i2c.channel[channel].async_tick_done = tick_now + _bc_i2c_get_transfer_time(channel, device != NULL ? length : 0) + (device != NULL ? device->delay : 0);
+    _bc_i2c.channel[channel].async_tick_timeout = tick_now + _bc_i2c_get_timeout(channel, length);
+
+    _bc_i2c.channel[channel].async_state = _BC_I2C_ASYNC_STATE_RUNNING;
+
+    bc_scheduler_plan_current_absolute(_bc_i2c.channel[channel].async_tick_done < _bc_i2c.channel[channel].async_tick_timeout ?
+            _bc_i2c.channel[channel].async_tick_done : _bc_i2c.channel[channel].async_tick_timeout);
+}
+
+static void _bc_i2c_async_complete(bc_i2c_channel_t channel)
+{
+    _bc_i2c_async_transfer_t *transfer = &_bc_i2c.channel[channel].async_queue[_bc_i2c.channel[channel].async_queue_head];
+    _bc_i2c_device_t *device = _bc_i2c_find_device(channel, transfer->device_address);
+
+    // If clock stretching of device exceeds timeout...
+    if ((device == NULL) || (_bc_i2c.channel[channel].async_tick_done > _bc_i2c.channel[channel].async_tick_timeout))
+    {
+        _bc_i2c.channel[channel].async_state = _BC_I2C_ASYNC_STATE_ERROR;
+    }
+    else if (device->handler(transfer->operation, transfer->memory_address, transfer->buffer, transfer->length, device->param))
+    {
+        _bc_i2c.channel[channel].async_state = _BC_I2C_ASYNC_STATE_DONE;
+    }
+    else
+    {
+        _bc_i2c.channel[channel].async_state = _BC_I2C_ASYNC_STATE_ERROR;
+    }
+}
@@ -0,0 +1,60 @@
+#define _DEFAULT_SOURCE
+
+#include <bc_irq.h>
+#include <bc_host.h>
+#include <time.h>
+
+// Simulated node runs in single thread, only the nesting is tracked
+static volatile uint32_t _bc_irq_disable = 0;
+
+// Start of the outermost window in which interrupts are disabled
+static uint64_t _bc_irq_disable_start;
+
+static bc_host_irq_stats_t _bc_irq_stats;
+
+static uint64_t _bc_irq_get_time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+void bc_irq_disable(void)
+{
+    if (_bc_irq_disable++ == 0)
+    {
+        _bc_irq_disable_start = _bc_irq_get_time();
+    }
+}
+
+void bc_irq_enable(void)
+{
+    if (_bc_irq_disable != 0)
+    {
+        if (--_bc_irq_disable == 0)
+        {
+            uint64_t length = _bc_irq_get_time() - _bc_irq_disable_start;
+
+            _bc_irq_stats.count++;
+
+            _bc_irq_stats.total += length;
+
+            if (length > _bc_irq_stats.max)
+            {
+                _bc_irq_stats.max = length;
+            }
+        }
+    }
+}
+
+void bc_host_irq_get_stats(bc_host_irq_stats_t *stats)
+{
+    *stats = _bc_irq_stats;
+}
+
+void bc_host_irq_reset_stats(void)
+{
+    memset(&_bc_irq_stats, 0, sizeof(_bc_irq_stats));
+}
@@ -0,0 +1,98 @@
+#include <bc_spi.h>
+#include <bc_scheduler.h>
+
+static struct
+{
+    bc_spi_mode_t mode;
+    bc_spi_speed_t speed;
+    void (*event_handler)(bc_spi_event_t event, void *event_param);
+    void *event_param;
+    bool pending_event_done;
+    bool initilized;
+    bc_scheduler_task_id_t task_id;
+
+} _bc_spi;
+
+static void _bc_spi_task(void *param);
+
+void bc_spi_init(bc_spi_speed_t speed, bc_spi_mode_t mode)
+{
+    if (_bc_spi.initilized)
+    {
+        return;
+    }
+
+    _bc_spi.speed = speed;
+    _bc_spi.mode = mode;
+    _bc_spi.task_id = bc_scheduler_register(_bc_spi_task, NULL, BC_TICK_INFINITY);
+    _bc_spi.initilized = true;
+}
+
+void bc_spi_set_speed(bc_spi_speed_t speed)
+{
+    _bc_spi.speed = speed;
+}
+
+bc_spi_speed_t bc_spi_get_speed(void)
+{
+    return _bc_spi.speed;
+}
+
+void bc_spi_set_mode(bc_spi_mode_t mode)
+{
+    _bc_spi.mode = mode;
+}
+
+bc_spi_mode_t bc_spi_get_mode(void)
+{
+    return _bc_spi.mode;
+}
+
+bool bc_spi_is_ready(void)
+{
+    return !_bc_spi.pending_event_done;
+}
+
+bool bc_spi_transfer(const void *source, void *destination, size_t length)
+{
+    (void) source;
+
+    // Nothing is attached to MISO, bus reads back zeros
+    if (destination != NULL)
+    {
+        memset(destination, 0, length);
+    }
+
+    return true;
+}
+
+bool bc_spi_async_transfer(const void *source, void *destination, size_t length, void (*event_handler)(bc_spi_event_t event, void *event_param), void (*event_param))
+{
+    (void) length;
+
+    // Only transmit is implemented on target
+    if (_bc_spi.pending_event_done || (source == NULL) || (destination != NULL))
+    {
+        return false;
+    }
+
+    _bc_spi.event_handler = event_handler;
+    _bc_spi.event_param = event_param;
+    _bc_spi.pending_event_done = true;
+
+    bc_scheduler_plan_now(_bc_spi.task_id);
+
+    return true;
+}
+
+static void _bc_spi_task(void *param)
+{
+    (void) param;
+
+    if (_bc_spi.event_handler != NULL)
+    {
+        _bc_spi.event_handler(BC_SPI_EVENT_DONE, _bc_spi.event_param);
+    }
+
+    _bc_spi.pending_event_done = false;
+}
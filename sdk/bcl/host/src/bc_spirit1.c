@@ -0,0 +1,423 @@
+#include <bc_spirit1.h>
+#include <bc_scheduler.h>
+#include <bc_host.h>
+
+// Listen before talk is a copy of state machine in bcl/src/bc_spirit1.c, the medium answers carrier sense instead of the chip
+// (changes have to be made in both files, the target one is not run on host)
+
+// Same modulation setup as SDK_Configuration_Common.h
+#define _BC_SPIRIT1_DATARATE 19200
+
+// Preamble (4 B), sync word (4 B), length field (1 B) and CRC (1 B)
+#define _BC_SPIRIT1_FRAME_OVERHEAD 10
+
+typedef enum
+{
+    BC_SPIRIT1_STATE_SLEEP = 0,
+    BC_SPIRIT1_STATE_TX = 1,
+    BC_SPIRIT1_STATE_RX = 2
+
+} bc_spirit1_state_t;
+
+typedef struct
+{
+    void (*event_handler)(bc_spirit1_event_t, void *);
+    void *event_param;
+    bc_scheduler_task_id_t task_id;
+    bc_spirit1_state_t desired_state;
+    bc_spirit1_state_t current_state;
+    uint8_t tx_buffer[BC_SPIRIT1_MAX_PACKET_SIZE];
+    size_t tx_length;
+    bc_tick_t tx_tick_done;
+    bool tx_backoff;
+    int tx_backoff_count;
+    bc_tick_t tx_tick_backoff;
+    uint8_t rx_buffer_internal[BC_SPIRIT1_MAX_PACKET_SIZE];
+    uint8_t *rx_buffer;
+    size_t rx_length;
+    bool rx_pending;
+    bc_tick_t rx_timeout;
+    bc_tick_t rx_tick_timeout;
+    uint8_t channel;
+    bool lbt;
+    uint32_t lbt_backoff_count;
+
+    void (*tx_handler)(const void *, size_t, void *);
+    void *tx_param;
+
+    bool (*carrier_sense_handler)(uint8_t, void *);
+    void *carrier_sense_param;
+
+} bc_spirit1_t;
+
+static bc_spirit1_t _bc_spirit1;
+
+static uint32_t _bc_spirit1_datarate = _BC_SPIRIT1_DATARATE;
+
+static void _bc_spirit1_enter_state_tx(void);
+static void _bc_spirit1_transmit(void);
+static void _bc_spirit1_check_state_tx(void);
+static void _bc_spirit1_enter_state_rx(void);
+static void _bc_spirit1_check_state_rx(void);
+static void _bc_spirit1_enter_state_sleep(void);
+static bool _bc_spirit1_carrier_sense(void);
+
+static void _bc_spirit1_task(void *param);
+
+void bc_spirit1_init(void)
+{
+    void (*tx_handler)(const void *, size_t, void *) = _bc_spirit1.tx_handler;
+    void *tx_param = _bc_spirit1.tx_param;
+    bool (*carrier_sense_handler)(uint8_t, void *) = _bc_spirit1.carrier_sense_handler;
+    void *carrier_sense_param = _bc_spirit1.carrier_sense_param;
+
+    memset(&_bc_spirit1, 0, sizeof(_bc_spirit1));
+
+    _bc_spirit1.rx_buffer = _bc_spirit1.rx_buffer_internal;
+
+    // Medium may be attached before radio is initialized
+    _bc_spirit1.tx_handler = tx_handler;
+    _bc_spirit1.tx_param = tx_param;
+    _bc_spirit1.carrier_sense_handler = carrier_sense_handler;
+    _bc_spirit1.carrier_sense_param = carrier_sense_param;
+
+    _bc_spirit1.task_id = bc_scheduler_register(_bc_spirit1_task, NULL, BC_TICK_INFINITY);
+
+    _bc_spirit1_enter_state_sleep();
+}
+
+void bc_spirit1_set_event_handler(void (*event_handler)(bc_spirit1_event_t, void *), void *event_param)
+{
+    _bc_spirit1.event_handler = event_handler;
+    _bc_spirit1.event_param = event_param;
+}
+
+void *bc_spirit1_get_tx_buffer(void)
+{
+    return _bc_spirit1.tx_buffer;
+}
+
+void bc_spirit1_set_tx_length(size_t length)
+{
+    _bc_spirit1.tx_length = length;
+}
+
+size_t bc_spirit1_get_tx_length(void)
+{
+    return _bc_spirit1.tx_length;
+}
+
+void *bc_spirit1_get_rx_buffer(void)
+{
+    return _bc_spirit1.rx_buffer;
+}
+
+void bc_spirit1_set_rx_buffer(void *buffer)
+{
+    _bc_spirit1.rx_buffer = buffer != NULL ? buffer : _bc_spirit1.rx_buffer_internal;
+}
+
+size_t bc_spirit1_get_rx_length(void)
+{
+    return _bc_spirit1.rx_length;
+}
+
+void bc_spirit1_set_rx_timeout(bc_tick_t timeout)
+{
+    _bc_spirit1.rx_timeout = timeout;
+
+    if (_bc_spirit1.current_state == BC_SPIRIT1_STATE_RX)
+    {
+        if (_bc_spirit1.rx_timeout == BC_TICK_INFINITY)
+        {
+            _bc_spirit1.rx_tick_timeout = BC_TICK_INFINITY;
+        }
+        else
+        {
+            _bc_spirit1.rx_tick_timeout = bc_tick_get() + _bc_spirit1.rx_timeout;
+        }
+
+        bc_scheduler_plan_absolute(_bc_spirit1.task_id, _bc_spirit1.rx_tick_timeout);
+    }
+}
+
+void bc_spirit1_set_channel(uint8_t channel)
+{
+    if (channel >= BC_SPIRIT1_CHANNEL_COUNT)
+    {
+        return;
+    }
+
+    _bc_spirit1.channel = channel;
+}
+
+uint8_t bc_spirit1_get_channel(void)
+{
+    return _bc_spirit1.channel;
+}
+
+void bc_spirit1_set_lbt(bool enable)
+{
+    _bc_spirit1.lbt = enable;
+}
+
+uint32_t bc_spirit1_get_lbt_backoff_count(void)
+{
+    return _bc_spirit1.lbt_backoff_count;
+}
+
+void bc_spirit1_tx(void)
+{
+    _bc_spirit1.desired_state = BC_SPIRIT1_STATE_TX;
+
+    bc_scheduler_plan_now(_bc_spirit1.task_id);
+}
+
+void bc_spirit1_rx(void)
+{
+    _bc_spirit1.desired_state = BC_SPIRIT1_STATE_RX;
+
+    bc_scheduler_plan_now(_bc_spirit1.task_id);
+}
+
+void bc_spirit1_sleep(void)
+{
+    _bc_spirit1.desired_state = BC_SPIRIT1_STATE_SLEEP;
+
+    bc_scheduler_plan_now(_bc_spirit1.task_id);
+}
+
+void bc_host_spirit1_set_tx_handler(void (*handler)(const void *, size_t, void *), void *param)
+{
+    _bc_spirit1.tx_handler = handler;
+    _bc_spirit1.tx_param = param;
+}
+
+void bc_host_spirit1_set_carrier_sense_handler(bool (*handler)(uint8_t, void *), void *param)
+{
+    _bc_spirit1.carrier_sense_handler = handler;
+    _bc_spirit1.carrier_sense_param = param;
+}
+
+bool bc_host_spirit1_receive(const void *buffer, size_t length)
+{
+    if ((_bc_spirit1.current_state != BC_SPIRIT1_STATE_RX) || (length > BC_SPIRIT1_MAX_PACKET_SIZE))
+    {
+        return false;
+    }
+
+    memcpy(_bc_spirit1.rx_buffer, buffer, length);
+
+    _bc_spirit1.rx_length = length;
+
+    _bc_spirit1.rx_pending = true;
+
+    // Same as GPIO_0 interrupt on target
+    bc_scheduler_plan_now(_bc_spirit1.task_id);
+
+    return true;
+}
+
+void bc_host_spirit1_set_datarate(uint32_t datarate)
+{
+    _bc_spirit1_datarate = datarate;
+}
+
+bc_tick_t bc_host_spirit1_get_airtime(size_t length)
+{
+    uint32_t bits = (length + _BC_SPIRIT1_FRAME_OVERHEAD) * 8;
+
+    return ((uint64_t) bits * 1000 + _bc_spirit1_datarate - 1) / _bc_spirit1_datarate;
+}
+
+static void _bc_spirit1_task(void *param)
+{
+    (void) param;
+
+    if ((_bc_spirit1.current_state == BC_SPIRIT1_STATE_RX) && (bc_tick_get() >= _bc_spirit1.rx_tick_timeout))
+    {
+        if (_bc_spirit1.event_handler != NULL)
+        {
+            _bc_spirit1.event_handler(BC_SPIRIT1_EVENT_RX_TIMEOUT, _bc_spirit1.event_param);
+        }
+    }
+
+    if (_bc_spirit1.desired_state != _bc_spirit1.current_state)
+    {
+        if (_bc_spirit1.desired_state == BC_SPIRIT1_STATE_TX)
+        {
+            _bc_spirit1_enter_state_tx();
+
+            return;
+        }
+        else if (_bc_spirit1.desired_state == BC_SPIRIT1_STATE_RX)
+        {
+            _bc_spirit1_enter_state_rx();
+
+            return;
+        }
+        else if (_bc_spirit1.desired_state == BC_SPIRIT1_STATE_SLEEP)
+        {
+            _bc_spirit1_enter_state_sleep();
+
+            return;
+        }
+
+        return;
+    }
+
+    if (_bc_spirit1.current_state == BC_SPIRIT1_STATE_TX)
+    {
+        _bc_spirit1_check_state_tx();
+
+        return;
+    }
+    else if (_bc_spirit1.current_state == BC_SPIRIT1_STATE_RX)
+    {
+        _bc_spirit1_check_state_rx();
+
+        return;
+    }
+}
+
+static void _bc_spirit1_enter_state_tx(void)
+{
+    _bc_spirit1.current_state = BC_SPIRIT1_STATE_TX;
+
+    _bc_spirit1.tx_backoff_count = 0;
+
+    _bc_spirit1_transmit();
+}
+
+static void _bc_spirit1_transmit(void)
+{
+    if (_bc_spirit1.lbt && (_bc_spirit1.tx_backoff_count < BC_SPIRIT1_LBT_MAX_BACKOFFS) && _bc_spirit1_carrier_sense())
+    {
+        // Back-off is at least one slot, random part in milliseconds doubles with every busy channel
+        bc_tick_t backoff = BC_SPIRIT1_LBT_BACKOFF_SLOT + rand() % (BC_SPIRIT1_LBT_BACKOFF_SLOT << (_bc_spirit1.tx_backoff_count + 1));
+
+        _bc_spirit1.tx_backoff = true;
+        _bc_spirit1.tx_backoff_count++;
+        _bc_spirit1.tx_tick_backoff = bc_tick_get() + backoff;
+
+        _bc_spirit1.lbt_backoff_count++;
+
+        bc_scheduler_plan_absolute(_bc_spirit1.task_id, _bc_spirit1.tx_tick_backoff);
+
+        return;
+    }
+
+    _bc_spirit1.tx_backoff = false;
+
+    if (_bc_spirit1.tx_handler != NULL)
+    {
+        _bc_spirit1.tx_handler(_bc_spirit1.tx_buffer, _bc_spirit1.tx_length, _bc_spirit1.tx_param);
+    }
+
+    _bc_spirit1.tx_tick_done = bc_tick_get() + bc_host_spirit1_get_airtime(_bc_spirit1.tx_length);
+
+    bc_scheduler_plan_absolute(_bc_spirit1.task_id, _bc_spirit1.tx_tick_done);
+}
+
+static void _bc_spirit1_check_state_tx(void)
+{
+    if (_bc_spirit1.tx_backoff)
+    {
+        if (bc_tick_get() < _bc_spirit1.tx_tick_backoff)
+        {
+            bc_scheduler_plan_current_absolute(_bc_spirit1.tx_tick_backoff);
+
+            return;
+        }
+
+        _bc_spirit1_transmit();
+
+        return;
+    }
+
+    if (bc_tick_get() < _bc_spirit1.tx_tick_done)
+    {
+        bc_scheduler_plan_current_absolute(_bc_spirit1.tx_tick_done);
+
+        return;
+    }
+
+    _bc_spirit1.desired_state = BC_SPIRIT1_STATE_SLEEP;
+
+    if (_bc_spirit1.event_handler != NULL)
+    {
+        _bc_spirit1.event_handler(BC_SPIRIT1_EVENT_TX_DONE, _bc_spirit1.event_param);
+    }
+
+    if (_bc_spirit1.desired_state == BC_SPIRIT1_STATE_RX)
+    {
+        _bc_spirit1_enter_state_rx();
+    }
+    else if (_bc_spirit1.desired_state == BC_SPIRIT1_STATE_SLEEP)
+    {
+        _bc_spirit1_enter_state_sleep();
+    }
+    else if (_bc_spirit1.desired_state == BC_SPIRIT1_STATE_TX)
+    {
+        _bc_spirit1_enter_state_tx();
+    }
+}
+
+static void _bc_spirit1_enter_state_rx(void)
+{
+    _bc_spirit1.current_state = BC_SPIRIT1_STATE_RX;
+
+    _bc_spirit1.rx_pending = false;
+
+    if (_bc_spirit1.rx_timeout == BC_TICK_INFINITY)
+    {
+        _bc_spirit1.rx_tick_timeout = BC_TICK_INFINITY;
+    }
+    else
+    {
+        _bc_spirit1.rx_tick_timeout = bc_tick_get() + _bc_spirit1.rx_timeout;
+    }
+
+    bc_scheduler_plan_absolute(_bc_spirit1.task_id, _bc_spirit1.rx_tick_timeout);
+}
+
+static void _bc_spirit1_check_state_rx(void)
+{
+    if (_bc_spirit1.rx_timeout == BC_TICK_INFINITY)
+    {
+        _bc_spirit1.rx_tick_timeout = BC_TICK_INFINITY;
+    }
+    else
+    {
+        _bc_spirit1.rx_tick_timeout = bc_tick_get() + _bc_spirit1.rx_timeout;
+    }
+
+    bc_scheduler_plan_current_absolute(_bc_spirit1.rx_tick_timeout);
+
+    if (_bc_spirit1.rx_pending)
+    {
+        _bc_spirit1.rx_pending = false;
+
+        if (_bc_spirit1.event_handler != NULL)
+        {
+            _bc_spirit1.event_handler(BC_SPIRIT1_EVENT_RX_DONE, _bc_spirit1.event_param);
+        }
+    }
+}
+
+static void _bc_spirit1_enter_state_sleep(void)
+{
+    _bc_spirit1.current_state = BC_SPIRIT1_STATE_SLEEP;
+
+    _bc_spirit1.rx_pending = false;
+}
+
+static bool _bc_spirit1_carrier_sense(void)
+{
+    if (_bc_spirit1.carrier_sense_handler == NULL)
+    {
+        return false;
+    }
+
+    return _bc_spirit1.carrier_sense_handler(_bc_spirit1.channel, _bc_spirit1.carrier_sense_param);
+}
@@ -0,0 +1,209 @@
+#include <bc_system.h>
+#include <bc_scheduler.h>
+#include <bc_tick.h>
+#include <bc_host.h>
+
+static const uint32_t _bc_system_clock_table[3] =
+{
+    [BC_SYSTEM_CLOCK_MSI] = 2097000,
+    [BC_SYSTEM_CLOCK_HSI] = 16000000,
+    [BC_SYSTEM_CLOCK_PLL] = 32000000
+};
+
+// Same tickless limits as on target
+#define _BC_SYSTEM_TICKLESS_MIN_INTERVAL 20
+#define _BC_SYSTEM_TICKLESS_MAX_COUNT 0x10000
+
+static struct
+{
+    int hsi16_enable_semaphore;
+    int pll_enable_semaphore;
+    int deep_sleep_disable_semaphore;
+    int tickless_disable_semaphore;
+    uint32_t tick_fraction;
+    bc_tick_t tick_end;
+    uint32_t wakeup_count;
+
+} _bc_system = { .tick_end = BC_TICK_INFINITY };
+
+static void _bc_system_exit(void);
+
+void bc_system_init(void)
+{
+    _bc_system.hsi16_enable_semaphore = 0;
+    _bc_system.pll_enable_semaphore = 0;
+    _bc_system.deep_sleep_disable_semaphore = 0;
+    _bc_system.tickless_disable_semaphore = 0;
+    _bc_system.tick_fraction = 0;
+    _bc_system.wakeup_count = 0;
+}
+
+void bc_system_sleep(void)
+{
+    bc_tick_t interval = 0;
+    bc_tick_t tick_wakeup = bc_tick_get();
+    uint32_t count;
+
+    if (_bc_system.tickless_disable_semaphore == 0)
+    {
+        bc_tick_t tick_now = bc_tick_get();
+        bc_tick_t tick_deadline = bc_scheduler_get_next_deadline();
+
+        if (tick_deadline > tick_now)
+        {
+            interval = tick_deadline - tick_now;
+        }
+    }
+
+    if (interval >= (bc_tick_t) _BC_SYSTEM_TICKLESS_MAX_COUNT * 1000 / BC_SYSTEM_RTC_WAKEUP_FREQUENCY)
+    {
+        count = _BC_SYSTEM_TICKLESS_MAX_COUNT;
+    }
+    else if (interval >= _BC_SYSTEM_TICKLESS_MIN_INTERVAL)
+    {
+        // Wake-up timer is reprogrammed to deadline (rounded up)
+        count = (interval * BC_SYSTEM_RTC_WAKEUP_FREQUENCY + 999) / 1000;
+    }
+    else
+    {
+        // Core is woken up by periodic RTC wake-up interrupt
+        count = BC_SYSTEM_RTC_WAKEUP_COUNT;
+    }
+
+    // Fraction of millisecond is carried the same way as on target
+    _bc_system.tick_fraction += count * 1000;
+
+    tick_wakeup += _bc_system.tick_fraction / BC_SYSTEM_RTC_WAKEUP_FREQUENCY;
+
+    _bc_system.tick_fraction %= BC_SYSTEM_RTC_WAKEUP_FREQUENCY;
+
+    bc_tick_t tick_medium = bc_host_radio_medium_sleep(tick_wakeup);
+
+    // Core woken up by radio interrupt reads time from calendar
+    if (tick_medium != tick_wakeup)
+    {
+        _bc_system.tick_fraction = 0;
+    }
+
+    bc_tick_inrement_irq(tick_medium - bc_tick_get());
+
+    _bc_system.wakeup_count++;
+
+    if (bc_tick_get() >= _bc_system.tick_end)
+    {
+        _bc_system_exit();
+    }
+}
+
+void bc_system_tickless_enable(void)
+{
+    _bc_system.tickless_disable_semaphore--;
+}
+
+void bc_system_tickless_disable(void)
+{
+    _bc_system.tickless_disable_semaphore++;
+}
+
+void bc_system_deep_sleep_enable(void)
+{
+    _bc_system.deep_sleep_disable_semaphore--;
+}
+
+void bc_system_deep_sleep_disable(void)
+{
+    _bc_system.deep_sleep_disable_semaphore++;
+}
+
+bc_system_clock_t bc_system_clock_get(void)
+{
+    if (_bc_system.pll_enable_semaphore != 0)
+    {
+        return BC_SYSTEM_CLOCK_PLL;
+    }
+    else if (_bc_system.hsi16_enable_semaphore != 0)
+    {
+        return BC_SYSTEM_CLOCK_HSI;
+    }
+    else
+    {
+        return BC_SYSTEM_CLOCK_MSI;
+    }
+}
+
+void bc_system_hsi16_enable(void)
+{
+    _bc_system.hsi16_enable_semaphore++;
+
+    bc_scheduler_disable_sleep();
+}
+
+void bc_system_hsi16_disable(void)
+{
+    _bc_system.hsi16_enable_semaphore--;
+
+    bc_scheduler_enable_sleep();
+}
+
+void bc_system_pll_enable(void)
+{
+    if (++_bc_system.pll_enable_semaphore == 1)
+    {
+        bc_system_hsi16_enable();
+    }
+}
+
+void bc_system_pll_disable(void)
+{
+    if (--_bc_system.pll_enable_semaphore == 0)
+    {
+        bc_system_hsi16_disable();
+    }
+}
+
+uint32_t bc_system_get_clock(void)
+{
+    return _bc_system_clock_table[bc_system_clock_get()];
+}
+
+void bc_system_reset(void)
+{
+    fprintf(stderr, "bc_system_reset\n");
+
+    exit(EXIT_FAILURE);
+}
+
+__attribute__((weak)) void bc_system_error(void)
+{
+    abort();
+}
+
+void bc_host_set_run_time(bc_tick_t tick)
+{
+    _bc_system.tick_end = tick;
+}
+
+uint32_t bc_host_get_wakeup_count(void)
+{
+    return _bc_system.wakeup_count;
+}
+
+uint32_t bc_host_get_wakeup_count_per_hour(void)
+{
+    bc_tick_t tick = bc_tick_get();
+
+    if (tick == 0)
+    {
+        return 0;
+    }
+
+    return (uint64_t) _bc_system.wakeup_count * 3600000 / tick;
+}
+
+static void _bc_system_exit(void)
+{
+    fprintf(stderr, "bc_host: %" PRIu32 " wake-ups in %" PRIu64 " ms (%" PRIu32 " per hour)\n",
+            _bc_system.wakeup_count, bc_tick_get(), bc_host_get_wakeup_count_per_hour());
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,47 @@
+#include <bc_scheduler.h>
+#include <bc_system.h>
+#include <bc_error.h>
+#include <bc_host.h>
+
+void application_init(void);
+
+void application_task(void *param);
+
+void application_error(bc_error_t code);
+
+int main(int argc, char *argv[])
+{
+    // Optional argument is simulated run time in milliseconds
+    if (argc > 1)
+    {
+        bc_host_set_run_time(strtoull(argv[1], NULL, 10));
+    }
+
+    bc_system_init();
+
+    bc_scheduler_init();
+
+    bc_scheduler_register(application_task, NULL, 0);
+
+    application_init();
+
+    bc_scheduler_run();
+
+    return EXIT_SUCCESS;
+}
+
+__attribute__((weak)) void application_init(void)
+{
+}
+
+__attribute__((weak)) void application_task(void *param)
+{
+    (void) param;
+}
+
+__attribute__((weak)) void application_error(bc_error_t code)
+{
+    fprintf(stderr, "application_error: %d\n", code);
+
+    exit(EXIT_FAILURE);
+}
@@ -31,6 +31,40 @@
             .type=BC_DATA_STREAM_TYPE_INT \
     };
 
+//! @brief Macro for float data stream buffer declaration with constant time minimum and maximum
+//! @details Two more arrays of NUMBER_OF_SAMPLES integers are declared, buffer without them scans samples in bc_data_stream_get_min and bc_data_stream_get_max
+
+#define BC_DATA_STREAM_FLOAT_BUFFER_MIN_MAX(NAME, NUMBER_OF_SAMPLES) \
+    float NAME##_feed[NUMBER_OF_SAMPLES]; \
+    float NAME##_sort[NUMBER_OF_SAMPLES]; \
+    int NAME##_min[NUMBER_OF_SAMPLES]; \
+    int NAME##_max[NUMBER_OF_SAMPLES]; \
+    bc_data_stream_buffer_t NAME = { \
+            .feed = NAME##_feed, \
+            .sort = NAME##_sort, \
+            .min = NAME##_min, \
+            .max = NAME##_max, \
+            .number_of_samples = NUMBER_OF_SAMPLES, \
+            .type=BC_DATA_STREAM_TYPE_FLOAT \
+    };
+
+//! @brief Macro for int data stream buffer declaration with constant time minimum and maximum
+//! @details Two more arrays of NUMBER_OF_SAMPLES integers are declared, buffer without them scans samples in bc_data_stream_get_min and bc_data_stream_get_max
+
+#define BC_DATA_STREAM_INT_BUFFER_MIN_MAX(NAME, NUMBER_OF_SAMPLES) \
+    int NAME##_feed[NUMBER_OF_SAMPLES]; \
+    int NAME##_sort[NUMBER_OF_SAMPLES]; \
+    int NAME##_min[NUMBER_OF_SAMPLES]; \
+    int NAME##_max[NUMBER_OF_SAMPLES]; \
+    bc_data_stream_buffer_t NAME = { \
+            .feed = NAME##_feed, \
+            .sort = NAME##_sort, \
+            .min = NAME##_min, \
+            .max = NAME##_max, \
+            .number_of_samples = NUMBER_OF_SAMPLES, \
+            .type=BC_DATA_STREAM_TYPE_INT \
+    };
+
 //! @brief Data stream type
 
 typedef enum
@@ -46,6 +80,8 @@ typedef struct
 {
     void *feed;
     void *sort;
+    int *min;
+    int *max;
     int number_of_samples;
     bc_data_stream_type_t type;
 
@@ -64,6 +100,30 @@ struct bc_data_stream_t
     int _counter;
     int _min_number_of_samples;
     int _feed_head;
+    // Sums of differences of samples from shift (close to average), exact in int streams
+    union
+    {
+        struct
+        {
+            int64_t shift;
+            int64_t sum;
+            int64_t sum_squares;
+
+        } i;
+
+        struct
+        {
+            float shift;
+            float sum;
+            float sum_squares;
+
+        } f;
+
+    } _sums;
+    int _min_head;
+    int _min_length;
+    int _max_head;
+    int _max_length;
 };
 
 //! @endcond
@@ -103,6 +163,39 @@ bool bc_data_stream_get_average(bc_data_stream_t *self, void *result);
 
 bool bc_data_stream_get_median(bc_data_stream_t *self, void *result);
 
+//! @brief Get percentile of data stream (linear interpolation between closest ranks)
+//! @param[in] self Instance
+//! @param[in] percentile Percentile in range from 0 to 100
+//! @param[out] self Pointer to buffer where result will be stored
+//! @return true On success (desired value is available)
+//! @return false On failure (desired value is not available)
+
+bool bc_data_stream_get_percentile(bc_data_stream_t *self, float percentile, void *result);
+
+//! @brief Get minimum value of data stream
+//! @param[in] self Instance
+//! @param[out] self Pointer to buffer where result will be stored
+//! @return true On success (desired value is available)
+//! @return false On failure (desired value is not available)
+
+bool bc_data_stream_get_min(bc_data_stream_t *self, void *result);
+
+//! @brief Get maximum value of data stream
+//! @param[in] self Instance
+//! @param[out] self Pointer to buffer where result will be stored
+//! @return true On success (desired value is available)
+//! @return false On failure (desired value is not available)
+
+bool bc_data_stream_get_max(bc_data_stream_t *self, void *result);
+
+//! @brief Get variance of data stream (population variance of samples in buffer)
+//! @param[in] self Instance
+//! @param[out] self Pointer to buffer where result will be stored
+//! @return true On success (desired value is available)
+//! @return false On failure (desired value is not available)
+
+bool bc_data_stream_get_variance(bc_data_stream_t *self, void *result);
+
 //! @brief Get first value in data stream
 //! @param[in] self Instance
 //! @param[out] self Pointer to buffer where result will be stored
@@ -7,7 +7,20 @@
 //! @brief Driver for internal EEPROM memory
 //! @{
 
+//! @brief EEPROM event
+
+typedef enum
+{
+    //! @brief Asynchronous write is done
+    BC_EEPROM_EVENT_ASYNC_WRITE_DONE = 0,
+
+    //! @brief Asynchronous write has failed
+    BC_EEPROM_EVENT_ASYNC_WRITE_ERROR = 1
+
+} bc_eeprom_event_t;
+
 //! @brief Write buffer to EEPROM area and verify it
+//! @details Aligned words are programmed at once, words and bytes which already contain data of buffer are not programmed.
 //! @param[in] address EEPROM start address (starts at 0)
 //! @param[in] buffer Pointer to source buffer
 //! @param[in] length Number of bytes to be written
@@ -16,6 +29,28 @@
 
 bool bc_eeprom_write(uint32_t address, const void *buffer, size_t length);
 
+//! @brief Write buffer to EEPROM area from scheduler task and verify it
+//! @details Scheduler keeps running while words are programmed. bc_eeprom_write fails until the asynchronous write is done.
+//! @param[in] address EEPROM start address (starts at 0)
+//! @param[in] buffer Pointer to source buffer (it has to be valid until the write is done)
+//! @param[in] length Number of bytes to be written
+//! @param[in] event_handler Function address (can be NULL)
+//! @param[in] event_param Optional event parameter (can be NULL)
+//! @return true On success
+//! @return false On failure (another asynchronous write is running)
+
+bool bc_eeprom_async_write(uint32_t address, const void *buffer, size_t length, void (*event_handler)(bc_eeprom_event_t, void *), void *event_param);
+
+//! @brief Cancel asynchronous write (part of buffer can be already written)
+
+void bc_eeprom_async_cancel(void);
+
+//! @brief Check if no asynchronous write is running
+//! @return true If ready
+//! @return false If asynchronous write is running
+
+bool bc_eeprom_is_ready(void);
+
 //! @brief Read buffer from EEPROM area
 //! @param[in] address EEPROM start address (starts at 0)
 //! @param[out] buffer Pointer to destination buffer
@@ -0,0 +1,83 @@
+#ifndef _BC_EEPROM_LOG_H
+#define _BC_EEPROM_LOG_H
+
+#include <bc_common.h>
+
+//! @addtogroup bc_eeprom_log bc_eeprom_log
+//! @brief Append-only log of records in EEPROM area which survives reset and power loss
+//! @details Records are written to fixed size slots which are used as a ring, so every slot is written once per turn of the log.
+//! Position of the log is not stored at fixed address, it is recovered from sequence numbers of records by bc_eeprom_log_init.
+//! Record interrupted by power loss fails CRC check and is ignored. Record is marked by bc_eeprom_log_remove after it has been
+//! handled, record removed at the moment of power loss can be returned once more by bc_eeprom_log_peek.
+//! When the log is full, the oldest record is overwritten. Measurements which could not be delivered are appended to the log
+//! and sent again in order by bc_eeprom_log_peek and bc_eeprom_log_remove once the radio is able to deliver them.
+//! @{
+
+//! @brief Size of one record slot in EEPROM (multiple of 4 bytes)
+
+#ifndef BC_EEPROM_LOG_SLOT_SIZE
+#define BC_EEPROM_LOG_SLOT_SIZE 16
+#endif
+
+//! @brief Maximum length of record data
+
+#define BC_EEPROM_LOG_RECORD_SIZE (BC_EEPROM_LOG_SLOT_SIZE - 6)
+
+//! @cond
+
+typedef struct
+{
+    uint32_t _address;
+    int _slot_count;
+    int _head;
+    int _tail;
+    int _count;
+    uint16_t _sequence;
+
+} bc_eeprom_log_t;
+
+//! @endcond
+
+//! @brief Initialize log and recover its content from EEPROM area
+//! @param[in] log Instance
+//! @param[in] address EEPROM start address of the log area
+//! @param[in] size Size of the log area (at least two slots, area must not overlap BC_RADIO_EEPROM_RESERVED bytes at the end of EEPROM)
+//! @return true On success
+//! @return false On failure (area is outside of EEPROM or it is too small or too big)
+
+bool bc_eeprom_log_init(bc_eeprom_log_t *log, uint32_t address, size_t size);
+
+//! @brief Append record to the end of log
+//! @param[in] log Instance
+//! @param[in] buffer Record data
+//! @param[in] length Length of record data (1 to BC_EEPROM_LOG_RECORD_SIZE bytes)
+//! @return true On success
+//! @return false On failure
+
+bool bc_eeprom_log_append(bc_eeprom_log_t *log, const void *buffer, size_t length);
+
+//! @brief Read the oldest record of log without removing it
+//! @param[in] log Instance
+//! @param[out] buffer Buffer for record data (at least BC_EEPROM_LOG_RECORD_SIZE bytes)
+//! @param[out] length Length of record data
+//! @return true On success
+//! @return false On failure (log is empty)
+
+bool bc_eeprom_log_peek(bc_eeprom_log_t *log, void *buffer, size_t *length);
+
+//! @brief Remove the oldest record of log
+//! @param[in] log Instance
+//! @return true On success
+//! @return false On failure
+
+bool bc_eeprom_log_remove(bc_eeprom_log_t *log);
+
+//! @brief Get number of records in log
+//! @param[in] log Instance
+//! @return Number of records
+
+int bc_eeprom_log_get_count(bc_eeprom_log_t *log);
+
+//! @}
+
+#endif // _BC_EEPROM_LOG_H
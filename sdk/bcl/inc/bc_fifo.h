@@ -69,6 +69,26 @@ size_t bc_fifo_irq_write(bc_fifo_t *fifo, const void *buffer, size_t length);
 
 size_t bc_fifo_irq_read(bc_fifo_t *fifo, void *buffer, size_t length);
 
+//! @brief Write data to FIFO without disabling interrupts (single producer, single consumer)
+//! @param[in] fifo FIFO instance
+//! @param[in] buffer Pointer to buffer from which data will be written
+//! @param[in] length Number of requested bytes to be written
+//! @return Number of bytes written
+//!
+//! Can be used only if there is one writer and one reader of FIFO (e.g. interrupt and task) and reader uses bc_fifo_spsc_read.
+
+size_t bc_fifo_spsc_write(bc_fifo_t *fifo, const void *buffer, size_t length);
+
+//! @brief Read data from FIFO without disabling interrupts (single producer, single consumer)
+//! @param[in] fifo FIFO instance
+//! @param[out] buffer Pointer to buffer where data will be read
+//! @param[in] length Number of requested bytes to be read
+//! @return Number of bytes read
+//!
+//! Can be used only if there is one writer and one reader of FIFO (e.g. interrupt and task) and writer uses bc_fifo_spsc_write.
+
+size_t bc_fifo_spsc_read(bc_fifo_t *fifo, void *buffer, size_t length);
+
 //! @brief Is empty
 //! @param[in] fifo FIFO instance
 //! @return true When is empty
@@ -76,6 +96,32 @@ size_t bc_fifo_irq_read(bc_fifo_t *fifo, void *buffer, size_t length);
 
 bool bc_fifo_is_empty(bc_fifo_t *fifo);
 
+//! @brief Get contiguous block of data at beginning of FIFO without reading it
+//! @param[in] fifo FIFO instance
+//! @param[out] buffer Pointer to data inside of FIFO buffer
+//! @return Number of bytes available at buffer (remaining data may follow at beginning of FIFO buffer)
+
+size_t bc_fifo_peek(bc_fifo_t *fifo, const void **buffer);
+
+//! @brief Remove data obtained by bc_fifo_peek from FIFO
+//! @param[in] fifo FIFO instance
+//! @param[in] length Number of bytes to be removed (at most value returned by bc_fifo_peek)
+
+void bc_fifo_skip(bc_fifo_t *fifo, size_t length);
+
+//! @brief Get contiguous block of free space at end of FIFO
+//! @param[in] fifo FIFO instance
+//! @param[out] buffer Pointer to free space inside of FIFO buffer
+//! @return Number of bytes which can be written to buffer
+
+size_t bc_fifo_get_span(bc_fifo_t *fifo, void **buffer);
+
+//! @brief Append data written to space obtained by bc_fifo_get_span to FIFO
+//! @param[in] fifo FIFO instance
+//! @param[in] length Number of bytes written (at most value returned by bc_fifo_get_span)
+
+void bc_fifo_commit(bc_fifo_t *fifo, size_t length);
+
 //! @}
 
 #endif // _BC_FIFO_H
@@ -1,7 +1,7 @@
 #ifndef _BC_I2C_H
 #define _BC_I2C_H
 
-#include <bc_common.h>
+#include <bc_tick.h>
 
 //! @addtogroup bc_i2c bc_i2c
 //! @brief Driver for I2C bus
@@ -37,6 +37,63 @@ typedef enum
 
 } bc_i2c_speed_t;
 
+//! @brief Asynchronous transfer events
+
+typedef enum
+{
+    //! @brief Transfer has been completed
+    BC_I2C_EVENT_DONE = 0,
+
+    //! @brief Transfer has failed (NACK, bus error or timeout)
+    BC_I2C_EVENT_ERROR = 1
+
+} bc_i2c_event_t;
+
+//! @brief Priority of device in queue of asynchronous transfers
+
+typedef enum
+{
+    //! @brief Low priority
+    BC_I2C_PRIORITY_LOW = 0,
+
+    //! @brief Normal priority (default)
+    BC_I2C_PRIORITY_NORMAL = 1,
+
+    //! @brief High priority
+    BC_I2C_PRIORITY_HIGH = 2
+
+} bc_i2c_priority_t;
+
+//! @brief Statistics of transfers addressed to one device (both blocking and asynchronous)
+
+typedef struct
+{
+    //! @brief Number of finished transfers
+    uint32_t transfer_count;
+
+    //! @brief Number of failed transfers (NACK, bus error or timeout)
+    uint32_t error_count;
+
+    //! @brief Sum of latencies in milliseconds (from request to completion including waiting in queue)
+    bc_tick_t latency_total;
+
+    //! @brief Maximum latency in milliseconds
+    bc_tick_t latency_max;
+
+} bc_i2c_device_stats_t;
+
+//! @brief Maximum number of asynchronous transfers queued on one channel
+
+#ifndef BC_I2C_ASYNC_QUEUE_SIZE
+#define BC_I2C_ASYNC_QUEUE_SIZE 8
+#endif
+
+//! @brief Maximum number of devices (of all channels) with priority and statistics
+
+#ifndef BC_I2C_DEVICE_COUNT
+#define BC_I2C_DEVICE_COUNT 12
+#endif
+
 //! @brief I2C transfer parameters
 
 typedef struct
@@ -152,6 +209,76 @@ bool bc_i2c_memory_read_8b(bc_i2c_channel_t channel, uint8_t device_address, uin
 
 bool bc_i2c_memory_read_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t *data);
 
+//! @brief Queue asynchronous write to I2C channel
+//! @details Transfers are ordered by priority of device and then by order of requests. Queued transfers run back to back,
+//! the next one is started by interrupt of the previous one, so the bus and clock are woken up once for all of them and
+//! the core sleeps while they are running. Transfers requested in one scheduler spin are collected before the bus is started.
+//! Buffer has to stay valid until event handler is called, transfer parameters are copied.
+//! Event handler is called from scheduler task, never from interrupt, and it can queue another transfer.
+//! @param[in] channel I2C channel
+//! @param[in] transfer Pointer to I2C transfer parameters instance
+//! @param[in] event_handler Function called when transfer is finished (can be NULL)
+//! @param[in] event_param Optional event parameter (can be NULL)
+//! @return true On success
+//! @return false On failure (channel is not initialized, queue is full or transfer is too long)
+
+bool bc_i2c_async_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param);
+
+//! @brief Queue asynchronous read from I2C channel
+//! @param[in] channel I2C channel
+//! @param[in] transfer Pointer to I2C transfer parameters instance
+//! @param[in] event_handler Function called when transfer is finished (can be NULL)
+//! @param[in] event_param Optional event parameter (can be NULL)
+//! @return true On success
+//! @return false On failure (channel is not initialized, queue is full or transfer is too long)
+
+bool bc_i2c_async_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param);
+
+//! @brief Queue asynchronous memory write to I2C channel
+//! @param[in] channel I2C channel
+//! @param[in] transfer Pointer to I2C memory transfer parameters instance
+//! @param[in] event_handler Function called when transfer is finished (can be NULL)
+//! @param[in] event_param Optional event parameter (can be NULL)
+//! @return true On success
+//! @return false On failure (channel is not initialized, queue is full or transfer is too long)
+
+bool bc_i2c_async_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param);
+
+//! @brief Queue asynchronous memory read from I2C channel
+//! @param[in] channel I2C channel
+//! @param[in] transfer Pointer to I2C memory transfer parameters instance
+//! @param[in] event_handler Function called when transfer is finished (can be NULL)
+//! @param[in] event_param Optional event parameter (can be NULL)
+//! @return true On success
+//! @return false On failure (channel is not initialized, queue is full or transfer is too long)
+
+bool bc_i2c_async_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param);
+
+//! @brief Check if all asynchronous transfers queued on I2C channel are finished
+//! @param[in] channel I2C channel
+//! @return true If queue is empty
+//! @return false If transfer is queued or running
+
+bool bc_i2c_is_ready(bc_i2c_channel_t channel);
+
+//! @brief Set priority of device in queue of asynchronous transfers
+//! @param[in] channel I2C channel
+//! @param[in] device_address 7-bit I2C device address
+//! @param[in] priority Priority (it applies to transfers queued later)
+//! @return true On success
+//! @return false On failure (table of devices is full)
+
+bool bc_i2c_set_device_priority(bc_i2c_channel_t channel, uint8_t device_address, bc_i2c_priority_t priority);
+
+//! @brief Get statistics of transfers addressed to device
+//! @param[in] channel I2C channel
+//! @param[in] device_address 7-bit I2C device address
+//! @param[out] stats Statistics
+//! @return true On success
+//! @return false On failure (device has not been addressed yet or table of devices is full)
+
+bool bc_i2c_get_device_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_i2c_device_stats_t *stats);
+
 //! @}
 
 #endif // _BC_I2C_H
@@ -33,10 +33,49 @@ typedef enum
     BC_MODULE_CLIMATE_EVENT_UPDATE_LUX_METER = 6,
 
     //! @brief Update event for barometer
-    BC_MODULE_CLIMATE_EVENT_UPDATE_BAROMETER = 7
+    BC_MODULE_CLIMATE_EVENT_UPDATE_BAROMETER = 7,
+
+    //! @brief Update event for all sensors (measurement started by bc_module_climate_measure_all_sensors is finished)
+    BC_MODULE_CLIMATE_EVENT_UPDATE_ALL_SENSORS = 8
 
 } bc_module_climate_event_t;
 
+//! @brief Values of all sensors from one measurement
+
+typedef struct
+{
+    //! @brief Temperature is valid
+    bool temperature_valid;
+
+    //! @brief Temperature in degrees of Celsius
+    float temperature_celsius;
+
+    //! @brief Humidity is valid
+    bool humidity_valid;
+
+    //! @brief Relative humidity in percent
+    float humidity_percentage;
+
+    //! @brief Illuminance is valid
+    bool illuminance_valid;
+
+    //! @brief Illuminance in lux
+    float illuminance_lux;
+
+    //! @brief Altitude is valid
+    bool altitude_valid;
+
+    //! @brief Altitude in meters
+    float altitude_meter;
+
+    //! @brief Pressure is valid
+    bool pressure_valid;
+
+    //! @brief Pressure in Pascal
+    float pressure_pascal;
+
+} bc_module_climate_snapshot_t;
+
 //! @brief Initialize BigClown Climate Module
 
 void bc_module_climate_init(void);
@@ -52,6 +91,14 @@ void bc_module_climate_set_event_handler(void (*event_handler)(bc_module_climate
 
 void bc_module_climate_set_update_interval_all_sensors(bc_tick_t interval);
 
+//! @brief Set measurement interval for all sensors measured together
+//! @details All conversions are started at once so their delays overlap and only BC_MODULE_CLIMATE_EVENT_UPDATE_ALL_SENSORS is raised
+//! when the last of them is finished, update events of individual sensors are not raised (error events are).
+//! Intervals of individual sensors are disabled, bc_module_climate_set_update_interval_all_sensors leaves this mode.
+//! @param[in] interval Measurement interval
+
+void bc_module_climate_set_update_interval_synchronized(bc_tick_t interval);
+
 //! @brief Set measurement interval for thermometer
 //! @param[in] interval Measurement interval
 
@@ -73,6 +120,7 @@ void bc_module_climate_set_update_interval_lux_meter(bc_tick_t interval);
 void bc_module_climate_set_update_interval_barometer(bc_tick_t interval);
 
 //! @brief Start measurement of all sensors manually
+//! @details BC_MODULE_CLIMATE_EVENT_UPDATE_ALL_SENSORS is raised when all sensors are finished
 //! @return true On success
 //! @return false When other measurement is in progress
 
@@ -151,6 +199,13 @@ bool bc_module_climate_get_altitude_meter(float *meter);
 
 bool bc_module_climate_get_pressure_pascal(float *pascal);
 
+//! @brief Get values of all sensors from the last finished measurement started by bc_module_climate_measure_all_sensors
+//! @param[out] snapshot Pointer to structure where values will be stored
+//! @return true When snapshot is available
+//! @return false When no such measurement has been finished yet
+
+bool bc_module_climate_get_snapshot(bc_module_climate_snapshot_t *snapshot);
+
 //! @}
 
 #endif // _BC_MODULE_CLIMATE_H
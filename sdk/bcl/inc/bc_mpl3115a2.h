@@ -62,6 +62,10 @@ struct bc_mpl3115a2_t
     uint8_t _reg_out_p_lsb_pressure;
     uint8_t _reg_out_t_msb_pressure;
     uint8_t _reg_out_t_lsb_pressure;
+    int _i2c_pending;
+    bool _i2c_error;
+    bool _i2c_wait;
+    uint8_t _i2c_buffer[6];
 };
 
 //! @endcond
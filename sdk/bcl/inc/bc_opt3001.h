@@ -50,6 +50,10 @@ struct bc_opt3001_t
     bc_tick_t _tick_ready;
     bool _illuminance_valid;
     uint16_t _reg_result;
+    int _i2c_pending;
+    bool _i2c_error;
+    bool _i2c_wait;
+    uint8_t _i2c_buffer[4];
 };
 
 //! @endcond
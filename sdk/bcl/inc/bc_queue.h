@@ -4,7 +4,7 @@
 #include <bc_common.h>
 
 //! @addtogroup bc_queue bc_queue
-//! @brief Queue handling functions
+//! @brief Queue handling functions (items are stored in ring buffer with one byte length header)
 //! @{
 
 //! @cond
@@ -14,6 +14,8 @@ typedef struct
     void *_buffer;
     size_t _size;
     size_t _length;
+    size_t _head;
+    size_t _tail;
 
 } bc_queue_t;
 
@@ -29,7 +31,7 @@ void bc_queue_init(bc_queue_t *queue, void *buffer, size_t size);
 //! @brief Put buffer to queue
 //! @param[in] queue Instance
 //! @param[in] buffer Buffer to be copied to queue
-//! @param[in] length Length of buffer
+//! @param[in] length Length of buffer (1 to 255 bytes)
 //! @return true On success
 //! @return false On failure
 
@@ -44,6 +46,26 @@ bool bc_queue_put(bc_queue_t *queue, const void *buffer, size_t length);
 
 bool bc_queue_get(bc_queue_t *queue, void *buffer, size_t *length);
 
+//! @brief Get first item of queue without removing it
+//! @param[in] queue Instance
+//! @param[out] buffer Pointer to item stored in queue (valid until item is removed)
+//! @param[out] length Length of item
+//! @return true On success
+//! @return false On failure (queue is empty)
+
+bool bc_queue_peek(bc_queue_t *queue, const void **buffer, size_t *length);
+
+//! @brief Remove first item from queue
+//! @param[in] queue Instance
+
+void bc_queue_remove(bc_queue_t *queue);
+
+//! @brief Get number of bytes occupied in buffer (including item headers)
+//! @param[in] queue Instance
+//! @return Number of occupied bytes
+
+size_t bc_queue_get_length(bc_queue_t *queue);
+
 //! @}
 
 #endif // _BC_QUEUE_H
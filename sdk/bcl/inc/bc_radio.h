@@ -10,9 +10,21 @@
 //! @brief Radio implementation
 //! @{
 
+//! @brief Maximum number of peer devices (up to 255, gateway serving many nodes should increase it)
+
 #ifndef BC_RADIO_MAX_DEVICES
+#ifdef BC_HOST
+// Simulated gateway serves many nodes of radio medium, library and application must agree on the size
+#define BC_RADIO_MAX_DEVICES 128
+#else
 #define BC_RADIO_MAX_DEVICES 4
 #endif
+#endif
+
+//! @brief Number of bytes at the end of EEPROM used for table of peer devices (they must not be used by application)
+
+#define BC_RADIO_EEPROM_RESERVED (8 + BC_RADIO_MAX_DEVICES * 3 * sizeof(uint64_t))
+
 #define BC_RADIO_ID_SIZE           6
 #define BC_RADIO_HEAD_SIZE         (BC_RADIO_ID_SIZE + 2)
 #define BC_RADIO_MAX_BUFFER_SIZE   (BC_SPIRIT1_MAX_PACKET_SIZE - BC_RADIO_HEAD_SIZE)
@@ -37,6 +49,93 @@ typedef enum
 
 } bc_radio_mode_t;
 
+//! @brief Retry policy of transmitted messages
+
+typedef enum
+{
+    //! @brief Up to six transmissions, ACK timeout is random from 50 ms to 150 ms
+    BC_RADIO_RETRY_POLICY_FIXED = 0,
+
+    //! @brief ACK timeout derived from measured round-trip time, exponential back-off with jitter and retry budget of link (helps on congested channel)
+    BC_RADIO_RETRY_POLICY_ADAPTIVE = 1,
+
+} bc_radio_retry_policy_t;
+
+//! @brief Statistics of link to peer device
+
+typedef struct
+{
+    //! @brief Number of messages sent over link
+    uint32_t tx_messages;
+
+    //! @brief Number of transmissions including retransmissions
+    uint32_t tx_frames;
+
+    //! @brief Number of acknowledged messages
+    uint32_t tx_acknowledged;
+
+    //! @brief Number of messages which were not acknowledged
+    uint32_t tx_failed;
+
+    //! @brief Number of retransmissions denied by retry budget
+    uint32_t tx_retry_denied;
+
+    //! @brief Number of frames received from peer device
+    uint32_t rx_frames;
+
+    //! @brief Number of duplicate frames received from peer device
+    uint32_t rx_duplicates;
+
+    //! @brief Smoothed round-trip time in ticks (zero until first measurement)
+    uint16_t round_trip_time;
+
+    //! @brief Current ACK timeout in ticks
+    uint16_t ack_timeout;
+
+    //! @brief Ratio of acknowledged transmissions (0 is dead link, 255 is perfect link)
+    uint8_t quality;
+
+} bc_radio_link_stats_t;
+
+//! @brief Radio statistics
+
+typedef struct
+{
+    //! @brief Number of transmitted frames including retransmissions and ACK
+    uint32_t tx_frames;
+
+    //! @brief Number of retransmissions
+    uint32_t tx_retransmissions;
+
+    //! @brief Number of transmissions which have not been acknowledged in time
+    uint32_t tx_ack_timeouts;
+
+    //! @brief Number of received frames
+    uint32_t rx_frames;
+
+    //! @brief Number of dropped duplicate frames
+    uint32_t rx_duplicates;
+
+    //! @brief Number of messages rejected by bc_radio_pub_queue_put because queue is full
+    uint32_t pub_queue_full;
+
+    //! @brief Number of received messages dropped because queue is full
+    uint32_t rx_queue_full;
+
+    //! @brief Time spent in transmit state in ticks
+    bc_tick_t tx_airtime;
+
+    //! @brief Time spent in receive state in ticks
+    bc_tick_t rx_airtime;
+
+    //! @brief Maximum number of occupied bytes of publish queue
+    uint16_t pub_queue_high_water;
+
+    //! @brief Maximum number of received frames waiting for decoding
+    uint16_t rx_queue_high_water;
+
+} bc_radio_stats_t;
+
 typedef enum
 {
     BC_RADIO_EVENT_INIT_FAILURE = 0,
@@ -81,6 +180,15 @@ typedef enum
     BC_RADIO_HEADER_NODE_LED_STRIP_COMPOUND_SET   = 0x1a,
     BC_RADIO_HEADER_NODE_LED_STRIP_EFFECT_SET     = 0x1b,
     BC_RADIO_HEADER_NODE_LED_STRIP_THERMOMETER_SET = 0x1c,
+    BC_RADIO_HEADER_PUB_BUFFER_BATCH = 0x1d,
+    BC_RADIO_HEADER_PUB_TELEMETRY   = 0x1e,
+    BC_RADIO_HEADER_PUB_RADIO_STATS = 0x1f,
+    BC_RADIO_HEADER_PUB_MULTI       = 0x20,
+    BC_RADIO_HEADER_PUB_TOPIC_DEFINE = 0x21,
+    BC_RADIO_HEADER_PUB_TOPIC_ID    = 0x22,
+
+    // Headers from this one on (except ACK) are free for applications, see bc_radio_pub_register_custom_handler
+    BC_RADIO_HEADER_CUSTOM_FIRST    = 0x80,
 
     BC_RADIO_HEADER_ACK             = 0xaa,
 
@@ -91,6 +199,12 @@ typedef enum
 
 void bc_radio_init(bc_radio_mode_t mode);
 
+//! @brief Initialize radio with retry policy (bc_radio_init uses BC_RADIO_RETRY_POLICY_FIXED)
+//! @param[in] mode
+//! @param[in] retry_policy
+
+void bc_radio_init_retry_policy(bc_radio_mode_t mode, bc_radio_retry_policy_t retry_policy);
+
 void bc_radio_set_event_handler(void (*event_handler)(bc_radio_event_t, void *), void *event_param);
 
 void bc_radio_listen(void);
@@ -127,18 +241,54 @@ bool bc_radio_is_peer_device(uint64_t id);
 
 bool bc_radio_pub_queue_put(const void *buffer, size_t length);
 
+//! @brief Enable or disable listen before talk, radio senses carrier and backs off before it transmits frame (ACK is sent immediately)
+//! @param[in] enable Enable
+
+void bc_radio_set_lbt(bool enable);
+
+//! @brief Set single channel on which radio transmits and receives (default is channel 0)
+//! @param[in] channel Channel (0 to BC_SPIRIT1_CHANNEL_COUNT - 1)
+
+void bc_radio_set_channel(uint8_t channel);
+
+//! @brief Set channel set shared by gateways and nodes
+//! @param[in] channel_set Bit mask of channels (0 to BC_SPIRIT1_CHANNEL_COUNT - 1)
+//!
+//! Every device starts on channel of the set selected by its ID, so gateways spread over the set. Gateway stays on its
+//! channel, node moves to the next channel of the set whenever its messages are not acknowledged until it finds its gateway.
+
+void bc_radio_set_channel_set(uint8_t channel_set);
+
+//! @brief Get statistics of link to peer device
+//! @param[in] id Peer device ID, 0 is link used for messages which are not addressed to single peer device
+//! @param[out] stats Link statistics
+//! @return true On success
+//! @return false If device is not peer device
+
+bool bc_radio_get_link_stats(uint64_t id, bc_radio_link_stats_t *stats);
+
+//! @brief Get radio statistics (counted since bc_radio_init)
+//! @param[out] stats Radio statistics
+
+void bc_radio_get_stats(bc_radio_stats_t *stats);
+
+//! @brief Publish radio statistics periodically by bc_radio_pub_radio_stats
+//! @param[in] interval Publish interval in ticks (0 disables publishing)
+
+void bc_radio_set_stats_interval(bc_tick_t interval);
+
 uint8_t *bc_radio_id_to_buffer(uint64_t *id, uint8_t *buffer);
 uint8_t *bc_radio_bool_to_buffer(bool *value, uint8_t *buffer);
 uint8_t *bc_radio_int_to_buffer(int *value, uint8_t *buffer);
 uint8_t *bc_radio_uint32_to_buffer(uint32_t *value, uint8_t *buffer);
 uint8_t *bc_radio_float_to_buffer(float *value, uint8_t *buffer);
 uint8_t *bc_radio_data_to_buffer(void *data, size_t length, uint8_t *buffer);
-uint8_t *bc_radio_id_from_buffer(uint8_t *buffer, uint64_t *id);
-uint8_t *bc_radio_bool_from_buffer(uint8_t *buffer, bool *value, bool **pointer);
-uint8_t *bc_radio_int_from_buffer(uint8_t *buffer, int *value, int **pointer);
-uint8_t *bc_radio_uint32_from_buffer(uint8_t *buffer, uint32_t *value, uint32_t **pointer);
-uint8_t *bc_radio_float_from_buffer(uint8_t *buffer, float *value, float **pointer);
-uint8_t *bc_radio_data_from_buffer(uint8_t *buffer, void *data, size_t length);
+uint8_t *bc_radio_id_from_buffer(const uint8_t *buffer, uint64_t *id);
+uint8_t *bc_radio_bool_from_buffer(const uint8_t *buffer, bool *value, bool **pointer);
+uint8_t *bc_radio_int_from_buffer(const uint8_t *buffer, int *value, int **pointer);
+uint8_t *bc_radio_uint32_from_buffer(const uint8_t *buffer, uint32_t *value, uint32_t **pointer);
+uint8_t *bc_radio_float_from_buffer(const uint8_t *buffer, float *value, float **pointer);
+uint8_t *bc_radio_data_from_buffer(const uint8_t *buffer, void *data, size_t length);
 
 void bc_radio_init_pairing_button();
 
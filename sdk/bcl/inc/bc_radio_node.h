@@ -108,10 +108,10 @@ bool bc_radio_node_led_strip_thermometer_set(uint64_t *id, float temperature, in
 
 //! @brief Internal decode function for bc_radio.c
 //! @param[in] id Pointer on own id
-//! @param[in] buffer Pointer to RX buffer
-//! @param[in] length RX buffer length
+//! @param[in] buffer Pointer to received frame (without radio head), it is decoded in place
+//! @param[in] length Length of received frame
 
-void bc_radio_node_decode(uint64_t *id, uint8_t *buffer, size_t length);
+void bc_radio_node_decode(uint64_t *id, const uint8_t *buffer, size_t length);
 
 //! @}
 
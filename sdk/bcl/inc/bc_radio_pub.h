@@ -2,6 +2,7 @@
 #define _BC_RADIO_PUB_H
 
 #include <bc_radio.h>
+#include <bc_telemetry_codec.h>
 
 //! @addtogroup bc_radio bc_radio
 //! @brief Radio implementation send to gateway
@@ -68,6 +69,57 @@ bool bc_radio_pub_acceleration(float *x_axis, float *y_axis, float *z_axis);
 
 bool bc_radio_pub_buffer(void *buffer, size_t length);
 
+//! @brief Set number of buffers sent together by bc_radio_pub_batch_buffer
+//! @param[in] size Number of buffers in one radio frame (1 sends every buffer immediately as bc_radio_pub_buffer)
+
+void bc_radio_pub_batch_set_size(int size);
+
+//! @brief Publish buffer in batch (buffers are kept in RAM and sent in one radio frame with their age)
+//! @param[in] buffer Pointer to buffer
+//! @param[in] length Length of buffer (all buffers in batch should have the same length)
+//! @return true On success
+//! @return false On failure
+
+bool bc_radio_pub_batch_buffer(void *buffer, size_t length);
+
+//! @brief Send buffers collected by bc_radio_pub_batch_buffer immediately
+//! @return true On success (or if there is nothing to send)
+//! @return false On failure
+
+bool bc_radio_pub_batch_flush(void);
+
+//! @brief Start collecting of publications into one radio frame
+//! @details Following bc_radio_pub_* calls (except telemetry and batch of buffers) are stored as entries of one frame until bc_radio_pub_multi_end is called. Frame is sent earlier only when the next entry does not fit. Receiver gets the same callbacks as if every value was sent in its own frame.
+
+void bc_radio_pub_multi_begin(void);
+
+//! @brief Send collected publications
+//! @return true On success (or if there is nothing to send)
+//! @return false On failure
+
+bool bc_radio_pub_multi_end(void);
+
+//! @brief Enable or disable sending of subtopics as numeric ids
+//! @details First publication of subtopic carries both id and string, the following ones carry only id once the first one is acknowledged. Receiver expands id back to string for bc_radio_pub_on_bool and friends. Dictionary is refreshed periodically so that receiver which lost it recovers. Subtopics longer than BC_RADIO_PUB_TOPIC_MAX_LEN are always sent as strings.
+//! @param[in] enable Enable dictionary (receiver has to support it)
+
+void bc_radio_pub_set_topic_dictionary(bool enable);
+
+//! @brief Publish telemetry values (frame is delta encoded against last acknowledged frame, see bc_telemetry_codec)
+//! @param[in] values Values to be published
+//! @param[in] count Number of values (1 to BC_TELEMETRY_CODEC_MAX_VALUES, it should not change between calls)
+//! @return true On success
+//! @return false On failure
+
+bool bc_radio_pub_telemetry(const int32_t *values, int count);
+
+//! @brief Publish radio statistics (airtime is sent in milliseconds modulo 2^32)
+//! @param[in] stats Radio statistics, see bc_radio_get_stats
+//! @return true On success
+//! @return false On failure
+
+bool bc_radio_pub_radio_stats(bc_radio_stats_t *stats);
+
 bool bc_radio_pub_state(uint8_t state_id, bool *state);
 
 bool bc_radio_pub_bool(const char *subtopic, bool *value);
@@ -80,12 +132,44 @@ bool bc_radio_pub_float(const char *subtopic, float *value);
 
 bool bc_radio_pub_string(const char *subtopic, const char *value);
 
+//! @brief Register handler of received frames with custom headers (send them by bc_radio_pub_queue_put)
+//! @param[in] first First header of range (BC_RADIO_HEADER_CUSTOM_FIRST or higher)
+//! @param[in] last Last header of range (range must not contain BC_RADIO_HEADER_ACK)
+//! @param[in] handler Function called with sender id and whole frame starting with header
+//! @param[in] param Optional parameter which is passed to handler (can be NULL)
+//! @return true On success
+//! @return false If range is not allowed or all BC_RADIO_PUB_CUSTOM_HANDLERS handlers are registered
+
+bool bc_radio_pub_register_custom_handler(uint8_t first, uint8_t last, void (*handler)(uint64_t *id, const uint8_t *buffer, size_t length, void *param), void *param);
+
 //! @brief Internal decode function for bc_radio.c
 //! @param[in] id Pointer on sender id
-//! @param[in] buffer Pointer to RX buffer
-//! @param[in] length RX buffer length
+//! @param[in] buffer Pointer to received frame (without radio head), it is decoded in place
+//! @param[in] length Length of received frame
+
+void bc_radio_pub_decode(uint64_t *id, const uint8_t *buffer, size_t length);
+
+//! @brief Internal check for bc_radio.c whether received frame can be decoded, it is done before frame is acknowledged
+//! @param[in] id Pointer on sender id
+//! @param[in] buffer Pointer to received frame (without radio head)
+//! @param[in] length Length of received frame
+//! @return true If frame can be decoded or it does not refer to any state of sender
+//! @return false If frame refers to state of sender which is not known (e.g. it has been replaced by other device), sender has to be refused
+
+bool bc_radio_pub_is_decodable(uint64_t *id, const uint8_t *buffer, size_t length);
+
+//! @brief Internal delivery notification for bc_radio.c
+//! @param[in] buffer Pointer to transmitted buffer (without radio head)
+//! @param[in] length Transmitted buffer length
+//! @param[in] delivered true if buffer has been acknowledged, false if it has been lost
+
+void bc_radio_pub_delivery(uint8_t *buffer, size_t length, bool delivered);
+
+//! @brief Internal refusal notification for bc_radio.c (receiver has got buffer but it cannot decode it)
+//! @param[in] buffer Pointer to transmitted buffer (without radio head)
+//! @param[in] length Transmitted buffer length
 
-void bc_radio_pub_decode(uint64_t *id, uint8_t *buffer, size_t length);
+void bc_radio_pub_refusal(uint8_t *buffer, size_t length);
 
 //! @}
 
@@ -48,6 +48,11 @@ bc_scheduler_task_id_t bc_scheduler_get_current_task_id(void);
 
 bc_tick_t bc_scheduler_get_spin_tick(void);
 
+//! @brief Get tick of the earliest planned task
+//! @return Tick of the earliest planned task or BC_TICK_INFINITY if no task is planned
+
+bc_tick_t bc_scheduler_get_next_deadline(void);
+
 //! @brief Disable sleep mode, implemented as semaphore
 
 void bc_scheduler_disable_sleep(void);
@@ -54,6 +54,10 @@ struct bc_sht20_t
     bool _temperature_valid;
     uint16_t _reg_humidity;
     uint16_t _reg_temperature;
+    int _i2c_pending;
+    bool _i2c_error;
+    bool _i2c_wait;
+    uint8_t _i2c_buffer[2];
 };
 
 //! @endcond
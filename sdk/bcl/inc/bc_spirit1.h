@@ -13,6 +13,28 @@
 
 //! @endcond
 
+//! @brief Number of channels, channel 0 is base frequency and channels are spaced by 100 kHz
+
+#define BC_SPIRIT1_CHANNEL_COUNT 6
+
+//! @brief Maximum number of back-offs of listen before talk, frame is transmitted regardless of busy channel then
+
+#ifndef BC_SPIRIT1_LBT_MAX_BACKOFFS
+#define BC_SPIRIT1_LBT_MAX_BACKOFFS 4
+#endif
+
+//! @brief Minimum back-off of listen before talk in milliseconds, random window of two slots is added and doubles with every back-off
+
+#ifndef BC_SPIRIT1_LBT_BACKOFF_SLOT
+#define BC_SPIRIT1_LBT_BACKOFF_SLOT 20
+#endif
+
+//! @brief RSSI in dBm above which listen before talk considers channel busy
+
+#ifndef BC_SPIRIT1_LBT_RSSI_THRESHOLD
+#define BC_SPIRIT1_LBT_RSSI_THRESHOLD -90
+#endif
+
 //! @brief Callback events
 
 typedef enum
@@ -58,6 +80,11 @@ size_t bc_spirit1_get_tx_length(void);
 
 void *bc_spirit1_get_rx_buffer(void);
 
+//! @brief Set buffer to which following packets are received
+//! @param[in] buffer Pointer to buffer of BC_SPIRIT1_MAX_PACKET_SIZE bytes (NULL for internal buffer)
+
+void bc_spirit1_set_rx_buffer(void *buffer);
+
 //! @brief Get RX buffer length
 //! @return Size of buffer
 
@@ -68,6 +95,26 @@ size_t bc_spirit1_get_rx_length(void);
 
 void bc_spirit1_set_rx_timeout(bc_tick_t timeout);
 
+//! @brief Set channel, change takes effect with the next TX or RX state
+//! @param[in] channel Channel (0 to BC_SPIRIT1_CHANNEL_COUNT - 1)
+
+void bc_spirit1_set_channel(uint8_t channel);
+
+//! @brief Get channel
+//! @return Channel
+
+uint8_t bc_spirit1_get_channel(void);
+
+//! @brief Enable or disable listen before talk (carrier sense with random back-off before every transmitted frame)
+//! @param[in] enable Enable
+
+void bc_spirit1_set_lbt(bool enable);
+
+//! @brief Get number of transmissions postponed by listen before talk because channel was busy
+//! @return Number of back-offs since bc_spirit1_init
+
+uint32_t bc_spirit1_get_lbt_backoff_count(void);
+
 //! @brief Enter TX state
 
 void bc_spirit1_tx(void);
@@ -3,6 +3,12 @@
 
 #include <bc_common.h>
 
+// Wake-up timer is clocked from RTCCLK / 16 (in Hz)
+#define BC_SYSTEM_RTC_WAKEUP_FREQUENCY 2048
+
+// Period of wake-up timer while core is running (in timer periods, 10.25 ms)
+#define BC_SYSTEM_RTC_WAKEUP_COUNT 21
+
 typedef enum
 {
     BC_SYSTEM_CLOCK_MSI = 0,
@@ -29,6 +35,10 @@ void bc_system_deep_sleep_disable(void);
 
 void bc_system_deep_sleep_enable(void);
 
+void bc_system_tickless_disable(void);
+
+void bc_system_tickless_enable(void);
+
 uint32_t bc_system_get_clock(void);
 
 void bc_system_reset(void);
@@ -0,0 +1,138 @@
+#ifndef _BC_TELEMETRY_CODEC_H
+#define _BC_TELEMETRY_CODEC_H
+
+#include <bc_common.h>
+
+//! @addtogroup bc_telemetry_codec bc_telemetry_codec
+//! @brief Delta and variable length integer encoding of telemetry frames
+//! @{
+
+//! @brief Maximum number of values in frame
+
+#define BC_TELEMETRY_CODEC_MAX_VALUES 8
+
+//! @brief Number of frames remembered by encoder (not yet acknowledged) and by decoder (possible references)
+
+#ifndef BC_TELEMETRY_CODEC_HISTORY
+#define BC_TELEMETRY_CODEC_HISTORY 3
+#endif
+
+//! @brief Maximum length of encoded frame (one byte of head and varints)
+
+#define BC_TELEMETRY_CODEC_MAX_FRAME_SIZE (1 + BC_TELEMETRY_CODEC_MAX_VALUES * 5)
+
+//! @cond
+
+typedef struct
+{
+    int32_t values[BC_TELEMETRY_CODEC_MAX_VALUES];
+    uint8_t count;
+    uint8_t sequence;
+    bool valid;
+
+} bc_telemetry_codec_reference_t;
+
+//! @endcond
+
+//! @brief Encoder instance
+
+typedef struct
+{
+    //! @cond
+
+    int _count;
+    uint8_t _sequence;
+    int _keyframe_interval;
+    int _keyframe_counter;
+    bc_telemetry_codec_reference_t _reference;
+    bc_telemetry_codec_reference_t _pending[BC_TELEMETRY_CODEC_HISTORY];
+    int _pending_head;
+
+    //! @endcond
+
+} bc_telemetry_codec_encoder_t;
+
+//! @brief Decoder instance
+
+typedef struct
+{
+    //! @cond
+
+    bc_telemetry_codec_reference_t _history[BC_TELEMETRY_CODEC_HISTORY];
+    int _history_head;
+
+    //! @endcond
+
+} bc_telemetry_codec_decoder_t;
+
+//! @brief Initialize encoder
+//! @param[in] self Instance
+//! @param[in] count Number of values in frame (1 to BC_TELEMETRY_CODEC_MAX_VALUES)
+//! @param[in] keyframe_interval Maximum number of frames between keyframes (0 means keyframe only after loss)
+
+void bc_telemetry_codec_encoder_init(bc_telemetry_codec_encoder_t *self, int count, int keyframe_interval);
+
+//! @brief Encode values to frame (delta against last acknowledged frame or keyframe)
+//! @param[in] self Instance
+//! @param[in] values Values to be encoded
+//! @param[out] buffer Buffer where frame will be stored
+//! @param[in] size Size of buffer
+//! @return Length of frame or 0 on failure (buffer is too small)
+
+size_t bc_telemetry_codec_encode(bc_telemetry_codec_encoder_t *self, const int32_t *values, uint8_t *buffer, size_t size);
+
+//! @brief Mark frame as delivered, it becomes reference for following frames
+//! @param[in] self Instance
+//! @param[in] buffer Frame returned by bc_telemetry_codec_encode
+//! @param[in] length Length of frame
+
+void bc_telemetry_codec_acknowledge(bc_telemetry_codec_encoder_t *self, const uint8_t *buffer, size_t length);
+
+//! @brief Force keyframe (e.g. when frame has been lost)
+//! @param[in] self Instance
+
+void bc_telemetry_codec_force_keyframe(bc_telemetry_codec_encoder_t *self);
+
+//! @brief Initialize decoder
+//! @param[in] self Instance
+
+void bc_telemetry_codec_decoder_init(bc_telemetry_codec_decoder_t *self);
+
+//! @brief Decode frame
+//! @param[in] self Instance
+//! @param[in] buffer Frame
+//! @param[in] length Length of frame
+//! @param[out] values Buffer for BC_TELEMETRY_CODEC_MAX_VALUES values
+//! @param[out] count Number of decoded values
+//! @return true On success
+//! @return false On failure (frame is malformed or its reference is not known)
+
+bool bc_telemetry_codec_decode(bc_telemetry_codec_decoder_t *self, const uint8_t *buffer, size_t length, int32_t *values, int *count);
+
+//! @brief Check if frame is keyframe (it can be decoded without any reference)
+//! @param[in] buffer Frame
+//! @param[in] length Length of frame
+//! @return true If frame is keyframe
+//! @return false If frame is delta frame or it is too short
+
+bool bc_telemetry_codec_is_keyframe(const uint8_t *buffer, size_t length);
+
+//! @brief Get sequence number of frame (it wraps around after 32 frames)
+//! @param[in] buffer Frame
+//! @param[in] length Length of frame
+//! @return Sequence number
+
+uint8_t bc_telemetry_codec_get_sequence(const uint8_t *buffer, size_t length);
+
+//! @brief Check if decoder has reference of frame (without decoding it)
+//! @param[in] self Instance
+//! @param[in] buffer Frame
+//! @param[in] length Length of frame
+//! @return true If frame is keyframe or its reference frame has been decoded
+//! @return false If reference frame is not known (sender has to send keyframe)
+
+bool bc_telemetry_codec_decoder_has_reference(const bc_telemetry_codec_decoder_t *self, const uint8_t *buffer, size_t length);
+
+//! @}
+
+#endif // _BC_TELEMETRY_CODEC_H
@@ -50,6 +50,10 @@ struct bc_tmp112_t
     bc_tick_t _tick_ready;
     bool _temperature_valid;
     uint16_t _reg_temperature;
+    int _i2c_pending;
+    bool _i2c_error;
+    bool _i2c_wait;
+    uint8_t _i2c_buffer[3];
 };
 
 //! @endcond
@@ -64,6 +64,7 @@
 #include <bc_system.h>
 #include <bc_error.h>
 #include <bc_dice.h>
+#include <bc_telemetry_codec.h>
 
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 
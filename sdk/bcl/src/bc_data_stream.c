@@ -1,7 +1,16 @@
 #include <bc_data_stream.h>
 
-static int _bc_data_stream_compare_float(const void * a, const void * b);
-static int _bc_data_stream_compare_int(const void * a, const void * b);
+static void _bc_data_stream_sort_remove_float(float *sort, int length, float value);
+static void _bc_data_stream_sort_insert_float(float *sort, int length, float value);
+static void _bc_data_stream_sort_remove_int(int *sort, int length, int value);
+static void _bc_data_stream_sort_insert_int(int *sort, int length, int value);
+static double _bc_data_stream_get_value(bc_data_stream_t *self, int position);
+static bool _bc_data_stream_get_sample(bc_data_stream_t *self, int position, void *result);
+static void _bc_data_stream_sums_add(bc_data_stream_t *self, int position, int sign);
+static void _bc_data_stream_update_sums(bc_data_stream_t *self);
+static void _bc_data_stream_wedge_evict(bc_data_stream_t *self, int *wedge, int *head, int *length);
+static void _bc_data_stream_wedge_push(bc_data_stream_t *self, int *wedge, int *head, int *length, bool is_min);
+static int _bc_data_stream_find_extreme(bc_data_stream_t *self, bool is_min);
 //
 void bc_data_stream_init(bc_data_stream_t *self, int min_number_of_samples, bc_data_stream_buffer_t *buffer)
 {
@@ -20,29 +29,69 @@ void bc_data_stream_feed(bc_data_stream_t *self, void *data)
         return;
     }
 
+    if (self->_buffer->type == BC_DATA_STREAM_TYPE_FLOAT)
+    {
+        if (isnan(*(float *) data) || isinf(*(float *) data))
+        {
+            bc_data_stream_reset(self);
+
+            return;
+        }
+    }
+
     if (++self->_feed_head == self->_buffer->number_of_samples)
     {
        self->_feed_head = 0;
     }
 
+    // If buffer is full, oldest sample is overwritten
+    if (self->_counter >= self->_buffer->number_of_samples)
+    {
+        _bc_data_stream_sums_add(self, self->_feed_head, -1);
+
+        if (self->_buffer->min != NULL)
+        {
+            _bc_data_stream_wedge_evict(self, self->_buffer->min, &self->_min_head, &self->_min_length);
+        }
+
+        if (self->_buffer->max != NULL)
+        {
+            _bc_data_stream_wedge_evict(self, self->_buffer->max, &self->_max_head, &self->_max_length);
+        }
+    }
+
+    int length = self->_counter > self->_buffer->number_of_samples ? self->_buffer->number_of_samples : self->_counter;
+
+    // Sort buffer is kept ordered, evicted sample is removed and new one inserted
     switch (self->_buffer->type)
     {
         case BC_DATA_STREAM_TYPE_FLOAT:
         {
-            if (isnan(*(float *) data) || isinf(*(float *) data))
-            {
-                bc_data_stream_reset(self);
+            float *feed = (float *) self->_buffer->feed + self->_feed_head;
 
-                return;
+            if (length == self->_buffer->number_of_samples)
+            {
+                _bc_data_stream_sort_remove_float(self->_buffer->sort, length--, *feed);
             }
 
-            *((float *) self->_buffer->feed + self->_feed_head) = *(float *) data;
+            *feed = *(float *) data;
+
+            _bc_data_stream_sort_insert_float(self->_buffer->sort, length, *feed);
 
             break;
         }
         case BC_DATA_STREAM_TYPE_INT:
         {
-            *((int *) self->_buffer->feed + self->_feed_head) = *(int *) data;
+            int *feed = (int *) self->_buffer->feed + self->_feed_head;
+
+            if (length == self->_buffer->number_of_samples)
+            {
+                _bc_data_stream_sort_remove_int(self->_buffer->sort, length--, *feed);
+            }
+
+            *feed = *(int *) data;
+
+            _bc_data_stream_sort_insert_int(self->_buffer->sort, length, *feed);
 
             break;
         }
@@ -52,13 +101,49 @@ void bc_data_stream_feed(bc_data_stream_t *self, void *data)
         }
     }
 
+    // The first sample is taken for shift until sums are recalculated
+    if (self->_counter == 0)
+    {
+        if (self->_buffer->type == BC_DATA_STREAM_TYPE_FLOAT)
+        {
+            self->_sums.f.shift = *(float *) data;
+        }
+        else
+        {
+            self->_sums.i.shift = *(int *) data;
+        }
+    }
+
+    _bc_data_stream_sums_add(self, self->_feed_head, 1);
+
+    if (self->_buffer->min != NULL)
+    {
+        _bc_data_stream_wedge_push(self, self->_buffer->min, &self->_min_head, &self->_min_length, true);
+    }
+
+    if (self->_buffer->max != NULL)
+    {
+        _bc_data_stream_wedge_push(self, self->_buffer->max, &self->_max_head, &self->_max_length, false);
+    }
+
     self->_counter++;
+
+    // Sums are recalculated once per buffer length so that rounding errors do not accumulate and shift follows average
+    if (self->_feed_head == self->_buffer->number_of_samples - 1)
+    {
+        _bc_data_stream_update_sums(self);
+    }
 }
 
 void bc_data_stream_reset(bc_data_stream_t *self)
 {
     self->_counter = 0;
     self->_feed_head = self->_buffer->number_of_samples - 1;
+    memset(&self->_sums, 0, sizeof(self->_sums));
+    self->_min_head = 0;
+    self->_min_length = 0;
+    self->_max_head = 0;
+    self->_max_length = 0;
 }
 
 bool bc_data_stream_get_average(bc_data_stream_t *self, void *result)
@@ -74,29 +159,12 @@ bool bc_data_stream_get_average(bc_data_stream_t *self, void *result)
     {
         case BC_DATA_STREAM_TYPE_FLOAT:
         {
-            float sum = 0;
-            float *buffer = (float *) self->_buffer->feed;
-
-
-            for (int i = 0; i < length; i ++)
-            {
-                sum += buffer[i];
-            }
-
-            *(float *) result = sum / length;
+            *(float *) result = self->_sums.f.shift + self->_sums.f.sum / length;
             break;
         }
         case BC_DATA_STREAM_TYPE_INT:
         {
-            int64_t sum = 0;
-            int *buffer = (int *) self->_buffer->feed;
-
-            for (int i = 0; i < length; i ++)
-            {
-                sum += buffer[i];
-            }
-
-            *(int *) result = sum / length;
+            *(int *) result = (self->_sums.i.shift * length + self->_sums.i.sum) / length;
             break;
         }
         default:
@@ -121,9 +189,6 @@ bool bc_data_stream_get_median(bc_data_stream_t *self, void *result)
     {
         case BC_DATA_STREAM_TYPE_FLOAT:
         {
-            memcpy(self->_buffer->sort, self->_buffer->feed, length * sizeof(float));
-            qsort(self->_buffer->sort, length, sizeof(float), _bc_data_stream_compare_float);
-
             float *buffer = (float *) self->_buffer->sort;
 
             if (length % 2 == 0)
@@ -138,9 +203,6 @@ bool bc_data_stream_get_median(bc_data_stream_t *self, void *result)
         }
         case BC_DATA_STREAM_TYPE_INT:
         {
-            memcpy(self->_buffer->sort, self->_buffer->feed, length * sizeof(int));
-            qsort(self->_buffer->sort, length, sizeof(int), _bc_data_stream_compare_int);
-
             int *buffer = (int *) self->_buffer->sort;
 
             if (length % 2 == 0)
@@ -162,6 +224,132 @@ bool bc_data_stream_get_median(bc_data_stream_t *self, void *result)
     return true;
 }
 
+bool bc_data_stream_get_percentile(bc_data_stream_t *self, float percentile, void *result)
+{
+    if ((self->_counter == 0) || (self->_counter < self->_min_number_of_samples))
+    {
+        return false;
+    }
+
+    if ((percentile < 0) || (percentile > 100))
+    {
+        return false;
+    }
+
+    int length = self->_counter > self->_buffer->number_of_samples ? self->_buffer->number_of_samples : self->_counter;
+
+    // Linear interpolation between closest ranks
+    float rank = percentile / 100 * (length - 1);
+
+    int index = rank;
+
+    float fraction = rank - index;
+
+    if (index == length - 1)
+    {
+        index--;
+
+        fraction = 1;
+    }
+
+    switch (self->_buffer->type)
+    {
+        case BC_DATA_STREAM_TYPE_FLOAT:
+        {
+            float *buffer = (float *) self->_buffer->sort;
+
+            if (length == 1)
+            {
+                *(float *) result = buffer[0];
+            }
+            else
+            {
+                *(float *) result = buffer[index] + (buffer[index + 1] - buffer[index]) * fraction;
+            }
+            break;
+        }
+        case BC_DATA_STREAM_TYPE_INT:
+        {
+            int *buffer = (int *) self->_buffer->sort;
+
+            if (length == 1)
+            {
+                *(int *) result = buffer[0];
+            }
+            else
+            {
+                *(int *) result = buffer[index] + (buffer[index + 1] - buffer[index]) * fraction;
+            }
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool bc_data_stream_get_min(bc_data_stream_t *self, void *result)
+{
+    if ((self->_counter == 0) || (self->_counter < self->_min_number_of_samples))
+    {
+        return false;
+    }
+
+    int position = self->_buffer->min != NULL ? self->_buffer->min[self->_min_head] : _bc_data_stream_find_extreme(self, true);
+
+    return _bc_data_stream_get_sample(self, position, result);
+}
+
+bool bc_data_stream_get_max(bc_data_stream_t *self, void *result)
+{
+    if ((self->_counter == 0) || (self->_counter < self->_min_number_of_samples))
+    {
+        return false;
+    }
+
+    int position = self->_buffer->max != NULL ? self->_buffer->max[self->_max_head] : _bc_data_stream_find_extreme(self, false);
+
+    return _bc_data_stream_get_sample(self, position, result);
+}
+
+bool bc_data_stream_get_variance(bc_data_stream_t *self, void *result)
+{
+    if ((self->_counter == 0) || (self->_counter < self->_min_number_of_samples))
+    {
+        return false;
+    }
+
+    int length = self->_counter > self->_buffer->number_of_samples ? self->_buffer->number_of_samples : self->_counter;
+
+    switch (self->_buffer->type)
+    {
+        case BC_DATA_STREAM_TYPE_FLOAT:
+        {
+            float average = self->_sums.f.sum / length;
+
+            float variance = self->_sums.f.sum_squares / length - average * average;
+
+            // Rounding errors may result in small negative number
+            *(float *) result = variance < 0 ? 0 : variance;
+            break;
+        }
+        case BC_DATA_STREAM_TYPE_INT:
+        {
+            *(int *) result = (self->_sums.i.sum_squares * length - self->_sums.i.sum * self->_sums.i.sum) / ((int64_t) length * length);
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool bc_data_stream_get_first(bc_data_stream_t *self, void *result)
 {
     if (self->_counter == 0)
@@ -281,12 +469,228 @@ bool bc_data_stream_get_nth(bc_data_stream_t *self, int n, void *result)
     return true;
 }
 
-static int _bc_data_stream_compare_float(const void *a, const void *b)
+static double _bc_data_stream_get_value(bc_data_stream_t *self, int position)
+{
+    if (self->_buffer->type == BC_DATA_STREAM_TYPE_FLOAT)
+    {
+        return *((float *) self->_buffer->feed + position);
+    }
+
+    return *((int *) self->_buffer->feed + position);
+}
+
+static bool _bc_data_stream_get_sample(bc_data_stream_t *self, int position, void *result)
+{
+    switch (self->_buffer->type)
+    {
+        case BC_DATA_STREAM_TYPE_FLOAT:
+        {
+            *(float *) result = *((float *) self->_buffer->feed + position);
+            break;
+        }
+        case BC_DATA_STREAM_TYPE_INT:
+        {
+            *(int *) result = *((int *) self->_buffer->feed + position);
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void _bc_data_stream_sums_add(bc_data_stream_t *self, int position, int sign)
+{
+    if (self->_buffer->type == BC_DATA_STREAM_TYPE_FLOAT)
+    {
+        float value = *((float *) self->_buffer->feed + position) - self->_sums.f.shift;
+
+        self->_sums.f.sum += sign * value;
+        self->_sums.f.sum_squares += sign * value * value;
+    }
+    else
+    {
+        int64_t value = *((int *) self->_buffer->feed + position) - self->_sums.i.shift;
+
+        self->_sums.i.sum += sign * value;
+        self->_sums.i.sum_squares += sign * value * value;
+    }
+}
+
+static void _bc_data_stream_update_sums(bc_data_stream_t *self)
+{
+    int length = self->_counter > self->_buffer->number_of_samples ? self->_buffer->number_of_samples : self->_counter;
+
+    if (self->_buffer->type == BC_DATA_STREAM_TYPE_FLOAT)
+    {
+        self->_sums.f.shift += self->_sums.f.sum / length;
+        self->_sums.f.sum = 0;
+        self->_sums.f.sum_squares = 0;
+    }
+    else
+    {
+        self->_sums.i.shift += self->_sums.i.sum / length;
+        self->_sums.i.sum = 0;
+        self->_sums.i.sum_squares = 0;
+    }
+
+    for (int i = 0; i < length; i++)
+    {
+        _bc_data_stream_sums_add(self, i, 1);
+    }
+}
+
+static void _bc_data_stream_wedge_evict(bc_data_stream_t *self, int *wedge, int *head, int *length)
+{
+    // Oldest sample can only be at front of wedge
+    if ((*length != 0) && (wedge[*head] == self->_feed_head))
+    {
+        if (++*head == self->_buffer->number_of_samples)
+        {
+            *head = 0;
+        }
+
+        (*length)--;
+    }
+}
+
+static void _bc_data_stream_wedge_push(bc_data_stream_t *self, int *wedge, int *head, int *length, bool is_min)
 {
-    return *(float *) a - *(float *) b;
+    double value = _bc_data_stream_get_value(self, self->_feed_head);
+
+    // Samples which can never become extreme again are removed from back of wedge
+    while (*length != 0)
+    {
+        double back = _bc_data_stream_get_value(self, wedge[(*head + *length - 1) % self->_buffer->number_of_samples]);
+
+        if (is_min ? (back < value) : (back > value))
+        {
+            break;
+        }
+
+        (*length)--;
+    }
+
+    wedge[(*head + *length) % self->_buffer->number_of_samples] = self->_feed_head;
+
+    (*length)++;
 }
 
-static int _bc_data_stream_compare_int(const void *a, const void *b)
+static int _bc_data_stream_find_extreme(bc_data_stream_t *self, bool is_min)
 {
-    return *(int *) a - *(int *) b;
+    int length = self->_counter > self->_buffer->number_of_samples ? self->_buffer->number_of_samples : self->_counter;
+
+    int position = 0;
+
+    for (int i = 1; i < length; i++)
+    {
+        double value = _bc_data_stream_get_value(self, i);
+        double extreme = _bc_data_stream_get_value(self, position);
+
+        if (is_min ? (value < extreme) : (value > extreme))
+        {
+            position = i;
+        }
+    }
+
+    return position;
+}
+
+static void _bc_data_stream_sort_remove_float(float *sort, int length, float value)
+{
+    int low = 0;
+    int high = length - 1;
+
+    // Find first occurrence of value
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (sort[middle] < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    memmove(sort + low, sort + low + 1, (length - low - 1) * sizeof(float));
+}
+
+static void _bc_data_stream_sort_insert_float(float *sort, int length, float value)
+{
+    int low = 0;
+    int high = length;
+
+    // Find position after last element not greater than value
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (sort[middle] <= value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    memmove(sort + low + 1, sort + low, (length - low) * sizeof(float));
+
+    sort[low] = value;
+}
+
+static void _bc_data_stream_sort_remove_int(int *sort, int length, int value)
+{
+    int low = 0;
+    int high = length - 1;
+
+    // Find first occurrence of value
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (sort[middle] < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    memmove(sort + low, sort + low + 1, (length - low - 1) * sizeof(int));
+}
+
+static void _bc_data_stream_sort_insert_int(int *sort, int length, int value)
+{
+    int low = 0;
+    int high = length;
+
+    // Find position after last element not greater than value
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (sort[middle] <= value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    memmove(sort + low + 1, sort + low, (length - low) * sizeof(int));
+
+    sort[low] = value;
 }
@@ -188,7 +188,7 @@ void _bc_dma_task(void *param)
 
     bc_dma_pending_event_t pending_event;
 
-    while (bc_fifo_read(&_bc_dma.fifo_pending, &pending_event, sizeof(bc_dma_pending_event_t)) != 0)
+    while (bc_fifo_spsc_read(&_bc_dma.fifo_pending, &pending_event, sizeof(bc_dma_pending_event_t)) != 0)
     {
         if (_bc_dma.channel[pending_event.channel].event_handler != NULL)
         {
@@ -206,7 +206,12 @@ void _bc_dma_irq_handler(bc_dma_channel_t channel, bc_dma_event_t event)
 
     bc_dma_pending_event_t pending_event = { channel, event };
 
-    bc_fifo_irq_write(&_bc_dma.fifo_pending, &pending_event, sizeof(bc_dma_pending_event_t));
+    // DMA interrupts have different priorities and preempt each other, masking makes them one producer
+    bc_irq_disable();
+
+    bc_fifo_spsc_write(&_bc_dma.fifo_pending, &pending_event, sizeof(bc_dma_pending_event_t));
+
+    bc_irq_enable();
 
     bc_scheduler_plan_now(_bc_dma.task_id);
 }
@@ -1,75 +1,132 @@
 #include <bc_eeprom.h>
 #include <bc_irq.h>
+#include <bc_scheduler.h>
 #include <stm32l0xx.h>
 #include <bc_tick.h>
 
+// Programming of one word including automatic erase takes up to 3.2 ms
+#define _BC_EEPROM_PROGRAM_TIME 4
+
+static struct
+{
+    bool initialized;
+    bool running;
+    volatile uint8_t *eeprom;
+    const uint8_t *buffer;
+    size_t length;
+    size_t position;
+    bc_scheduler_task_id_t task_id;
+    void (*event_handler)(bc_eeprom_event_t, void *);
+    void *event_param;
+
+} _bc_eeprom;
+
 static bool _bc_eeprom_is_busy(bc_tick_t timeout);
+static void _bc_eeprom_unlock(void);
+static void _bc_eeprom_lock(void);
+static bool _bc_eeprom_program(volatile uint8_t *eeprom, const uint8_t *buffer, size_t length, size_t *position);
+static void _bc_eeprom_async_task(void *param);
 
 bool bc_eeprom_write(uint32_t address, const void *buffer, size_t length)
 {
-    // Add EEPROM base offset to address
-    address += DATA_EEPROM_BASE;
+    volatile uint8_t *eeprom = (uint8_t *) DATA_EEPROM_BASE + address;
+    size_t position = 0;
 
     // If user attempts to write outside EEPROM area...
-    if ((address + length) > (DATA_EEPROM_BANK2_END + 1))
+    if ((address + length) > bc_eeprom_get_size())
     {
         // Indicate failure
         return false;
     }
 
-    if (_bc_eeprom_is_busy(50))
+    if (_bc_eeprom.running || _bc_eeprom_is_busy(50))
     {
         return false;
     }
 
-    // Disable interrupts
-    bc_irq_disable();
+    _bc_eeprom_unlock();
 
-    // Unlock FLASH_PECR register
-    if ((FLASH->PECR & FLASH_PECR_PELOCK) != 0)
+    // Program every word or byte which differs from buffer
+    while (_bc_eeprom_program(eeprom, buffer, length, &position))
     {
-        FLASH->PEKEYR = FLASH_PEKEY1;
-        FLASH->PEKEYR = FLASH_PEKEY2;
+        if (_bc_eeprom_is_busy(_BC_EEPROM_PROGRAM_TIME + 10))
+        {
+            _bc_eeprom_lock();
+
+            return false;
+        }
     }
 
-    // Enable interrupts
-    bc_irq_enable();
+    _bc_eeprom_lock();
 
-    // For every byte in buffer
-    for (size_t i = 0UL; i < length; i++)
+    // If we do not read what we wrote...
+    if (memcmp(buffer, (const void *) eeprom, length) != 0UL)
     {
-        // Program data to address
-        ((uint8_t *) address)[i] = ((uint8_t *) buffer)[i];
+        // Indicate failure
+        return false;
+    }
 
-        while ((FLASH->SR & FLASH_SR_BSY) != 0UL)
-        {
-            continue;
-        }
+    // Indicate success
+    return true;
+}
+
+bool bc_eeprom_async_write(uint32_t address, const void *buffer, size_t length, void (*event_handler)(bc_eeprom_event_t, void *), void *event_param)
+{
+    // If user attempts to write outside EEPROM area...
+    if ((address + length) > bc_eeprom_get_size())
+    {
+        // Indicate failure
+        return false;
     }
 
-    if (_bc_eeprom_is_busy(10 * length))
+    if (_bc_eeprom.running)
     {
         return false;
     }
 
-    // Disable interrupts
-    bc_irq_disable();
+    if (!_bc_eeprom.initialized)
+    {
+        _bc_eeprom.task_id = bc_scheduler_register(_bc_eeprom_async_task, NULL, BC_TICK_INFINITY);
 
-    // Lock FLASH_PECR register
-    FLASH->PECR |= FLASH_PECR_PELOCK;
+        _bc_eeprom.initialized = true;
+    }
 
-    // Enable interrupts
-    bc_irq_enable();
+    _bc_eeprom.running = true;
+    _bc_eeprom.eeprom = (uint8_t *) DATA_EEPROM_BASE + address;
+    _bc_eeprom.buffer = buffer;
+    _bc_eeprom.length = length;
+    _bc_eeprom.position = 0;
+    _bc_eeprom.event_handler = event_handler;
+    _bc_eeprom.event_param = event_param;
 
-    // If we do not read what we wrote...
-    if (memcmp(buffer, (void *) address, length) != 0UL)
+    // FLASH_PECR stays unlocked until the whole buffer is programmed
+    _bc_eeprom_unlock();
+
+    bc_scheduler_plan_now(_bc_eeprom.task_id);
+
+    return true;
+}
+
+void bc_eeprom_async_cancel(void)
+{
+    if (!_bc_eeprom.running)
     {
-        // Indicate failure
-        return false;
+        return;
     }
 
-    // Indicate success
-    return true;
+    _bc_eeprom.running = false;
+
+    // Word which is being programmed is finished by hardware
+    _bc_eeprom_is_busy(_BC_EEPROM_PROGRAM_TIME + 10);
+
+    _bc_eeprom_lock();
+
+    bc_scheduler_plan_absolute(_bc_eeprom.task_id, BC_TICK_INFINITY);
+}
+
+bool bc_eeprom_is_ready(void)
+{
+    return !_bc_eeprom.running;
 }
 
 bool bc_eeprom_read(uint32_t address, void *buffer, size_t length)
@@ -85,7 +142,7 @@ bool bc_eeprom_read(uint32_t address, void *buffer, size_t length)
     }
 
     // Read from EEPROM memory to buffer
-    memcpy(buffer, (void *) address, length);
+    memcpy(buffer, (void *) (size_t) address, length);
 
     // Indicate success
     return true;
@@ -103,7 +160,7 @@ static bool _bc_eeprom_is_busy(bc_tick_t timeout)
 
     while ((FLASH->SR & FLASH_SR_BSY) != 0UL)
     {
-        if (timeout > bc_tick_get())
+        if (bc_tick_get() >= timeout)
         {
             return true;
         }
@@ -111,3 +168,113 @@ static bool _bc_eeprom_is_busy(bc_tick_t timeout)
 
     return false;
 }
+
+static void _bc_eeprom_unlock(void)
+{
+    // Disable interrupts
+    bc_irq_disable();
+
+    // Unlock FLASH_PECR register
+    if ((FLASH->PECR & FLASH_PECR_PELOCK) != 0)
+    {
+        FLASH->PEKEYR = FLASH_PEKEY1;
+        FLASH->PEKEYR = FLASH_PEKEY2;
+    }
+
+    // Enable interrupts
+    bc_irq_enable();
+}
+
+static void _bc_eeprom_lock(void)
+{
+    // Disable interrupts
+    bc_irq_disable();
+
+    // Lock FLASH_PECR register
+    FLASH->PECR |= FLASH_PECR_PELOCK;
+
+    // Enable interrupts
+    bc_irq_enable();
+}
+
+static bool _bc_eeprom_program(volatile uint8_t *eeprom, const uint8_t *buffer, size_t length, size_t *position)
+{
+    while (*position < length)
+    {
+        volatile uint8_t *destination = eeprom + *position;
+
+        // Aligned word is programmed at once, it takes the same time as one byte
+        if (((((size_t) destination) & 3) == 0) && ((length - *position) >= 4))
+        {
+            uint32_t word;
+
+            memcpy(&word, buffer + *position, 4);
+
+            *position += 4;
+
+            // Word which already has the value is not erased and programmed again
+            if (*(volatile uint32_t *) destination != word)
+            {
+                *(volatile uint32_t *) destination = word;
+
+                return true;
+            }
+        }
+        else
+        {
+            uint8_t byte = buffer[*position];
+
+            *position += 1;
+
+            if (*destination != byte)
+            {
+                *destination = byte;
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static void _bc_eeprom_async_task(void *param)
+{
+    (void) param;
+
+    if (!_bc_eeprom.running)
+    {
+        return;
+    }
+
+    // Previous word is still being programmed
+    if ((FLASH->SR & FLASH_SR_BSY) != 0UL)
+    {
+        bc_scheduler_plan_current_from_now(1);
+
+        return;
+    }
+
+    if (_bc_eeprom_program(_bc_eeprom.eeprom, _bc_eeprom.buffer, _bc_eeprom.length, &_bc_eeprom.position))
+    {
+        bc_scheduler_plan_current_from_now(_BC_EEPROM_PROGRAM_TIME);
+
+        return;
+    }
+
+    _bc_eeprom_lock();
+
+    _bc_eeprom.running = false;
+
+    if (_bc_eeprom.event_handler != NULL)
+    {
+        if (memcmp(_bc_eeprom.buffer, (const void *) _bc_eeprom.eeprom, _bc_eeprom.length) != 0)
+        {
+            _bc_eeprom.event_handler(BC_EEPROM_EVENT_ASYNC_WRITE_ERROR, _bc_eeprom.event_param);
+        }
+        else
+        {
+            _bc_eeprom.event_handler(BC_EEPROM_EVENT_ASYNC_WRITE_DONE, _bc_eeprom.event_param);
+        }
+    }
+}
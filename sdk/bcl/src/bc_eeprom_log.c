@@ -0,0 +1,228 @@
+#include <bc_eeprom_log.h>
+#include <bc_eeprom.h>
+
+// Slot layout: length, data, sequence, CRC, state (state is not covered by CRC, it is rewritten by removal)
+#define _BC_EEPROM_LOG_LENGTH_OFFSET 0
+#define _BC_EEPROM_LOG_DATA_OFFSET 1
+#define _BC_EEPROM_LOG_SEQUENCE_OFFSET (BC_EEPROM_LOG_SLOT_SIZE - 5)
+#define _BC_EEPROM_LOG_CRC_OFFSET (BC_EEPROM_LOG_SLOT_SIZE - 3)
+#define _BC_EEPROM_LOG_STATE_OFFSET (BC_EEPROM_LOG_SLOT_SIZE - 1)
+
+// Zero is state of erased EEPROM, any other value marks removed record
+#define _BC_EEPROM_LOG_STATE_PENDING 0x00
+#define _BC_EEPROM_LOG_STATE_REMOVED 0xff
+
+// Sequence numbers of all slots have to be comparable in serial arithmetic
+#define _BC_EEPROM_LOG_MAX_SLOTS 0x7fff
+
+static bool _bc_eeprom_log_read_slot(bc_eeprom_log_t *log, int slot, uint8_t *buffer, uint16_t *sequence);
+static uint16_t _bc_eeprom_log_crc(const uint8_t *buffer);
+
+bool bc_eeprom_log_init(bc_eeprom_log_t *log, uint32_t address, size_t size)
+{
+    uint8_t buffer[BC_EEPROM_LOG_SLOT_SIZE];
+    uint16_t sequence;
+    uint16_t sequence_last = 0;
+    int slot_last = -1;
+
+    memset(log, 0, sizeof(*log));
+
+    if (((address + size) > bc_eeprom_get_size()) || (size < 2 * BC_EEPROM_LOG_SLOT_SIZE) || (size / BC_EEPROM_LOG_SLOT_SIZE > _BC_EEPROM_LOG_MAX_SLOTS))
+    {
+        return false;
+    }
+
+    log->_address = address;
+    log->_slot_count = size / BC_EEPROM_LOG_SLOT_SIZE;
+
+    // The last written record is the one with the highest sequence number
+    for (int i = 0; i < log->_slot_count; i++)
+    {
+        if (!_bc_eeprom_log_read_slot(log, i, buffer, &sequence))
+        {
+            continue;
+        }
+
+        if ((slot_last < 0) || ((int16_t) (sequence - sequence_last) > 0))
+        {
+            slot_last = i;
+            sequence_last = sequence;
+        }
+    }
+
+    if (slot_last < 0)
+    {
+        return true;
+    }
+
+    log->_head = (slot_last + 1) % log->_slot_count;
+    log->_sequence = sequence_last + 1;
+
+    // Records with consecutive sequence numbers preceding the last one form the log, pending records follow removed ones
+    // (state of record interrupted by power loss can be left from the previous record in slot, so it is not trusted
+    // when any older record is pending)
+    for (int i = slot_last, j = 0; j < log->_slot_count; i = (i + log->_slot_count - 1) % log->_slot_count, j++)
+    {
+        if (!_bc_eeprom_log_read_slot(log, i, buffer, &sequence) || (sequence != (uint16_t) (sequence_last - j)))
+        {
+            break;
+        }
+
+        if (buffer[_BC_EEPROM_LOG_STATE_OFFSET] == _BC_EEPROM_LOG_STATE_PENDING)
+        {
+            log->_count = j + 1;
+        }
+    }
+
+    log->_tail = (log->_head + log->_slot_count - log->_count) % log->_slot_count;
+
+    // Untrusted state is repaired, otherwise the record would be lost once all older records are removed
+    for (int i = log->_tail, j = 0; j < log->_count; i = (i + 1) % log->_slot_count, j++)
+    {
+        bc_eeprom_read(log->_address + i * BC_EEPROM_LOG_SLOT_SIZE + _BC_EEPROM_LOG_STATE_OFFSET, buffer, 1);
+
+        if (buffer[0] != _BC_EEPROM_LOG_STATE_PENDING)
+        {
+            buffer[0] = _BC_EEPROM_LOG_STATE_PENDING;
+
+            bc_eeprom_write(log->_address + i * BC_EEPROM_LOG_SLOT_SIZE + _BC_EEPROM_LOG_STATE_OFFSET, buffer, 1);
+        }
+    }
+
+    return true;
+}
+
+bool bc_eeprom_log_append(bc_eeprom_log_t *log, const void *buffer, size_t length)
+{
+    uint8_t slot[BC_EEPROM_LOG_SLOT_SIZE];
+    uint16_t crc;
+
+    if ((log->_slot_count == 0) || (length == 0) || (length > BC_EEPROM_LOG_RECORD_SIZE))
+    {
+        return false;
+    }
+
+    // The oldest record is lost even if the write fails
+    if (log->_count == log->_slot_count)
+    {
+        log->_tail = (log->_tail + 1) % log->_slot_count;
+        log->_count--;
+    }
+
+    memset(slot, 0, sizeof(slot));
+
+    slot[_BC_EEPROM_LOG_LENGTH_OFFSET] = length;
+
+    memcpy(slot + _BC_EEPROM_LOG_DATA_OFFSET, buffer, length);
+
+    slot[_BC_EEPROM_LOG_SEQUENCE_OFFSET] = log->_sequence;
+    slot[_BC_EEPROM_LOG_SEQUENCE_OFFSET + 1] = log->_sequence >> 8;
+
+    crc = _bc_eeprom_log_crc(slot);
+
+    slot[_BC_EEPROM_LOG_CRC_OFFSET] = crc;
+    slot[_BC_EEPROM_LOG_CRC_OFFSET + 1] = crc >> 8;
+
+    slot[_BC_EEPROM_LOG_STATE_OFFSET] = _BC_EEPROM_LOG_STATE_PENDING;
+
+    // Slot is written in ascending order, so previous record in slot is damaged first and the new one is valid only with complete CRC
+    if (!bc_eeprom_write(log->_address + log->_head * BC_EEPROM_LOG_SLOT_SIZE, slot, sizeof(slot)))
+    {
+        return false;
+    }
+
+    log->_head = (log->_head + 1) % log->_slot_count;
+    log->_sequence++;
+    log->_count++;
+
+    return true;
+}
+
+bool bc_eeprom_log_peek(bc_eeprom_log_t *log, void *buffer, size_t *length)
+{
+    uint8_t slot[BC_EEPROM_LOG_SLOT_SIZE];
+    uint16_t sequence;
+
+    while (log->_count != 0)
+    {
+        if (_bc_eeprom_log_read_slot(log, log->_tail, slot, &sequence) && (sequence == (uint16_t) (log->_sequence - log->_count)))
+        {
+            *length = slot[_BC_EEPROM_LOG_LENGTH_OFFSET];
+
+            memcpy(buffer, slot + _BC_EEPROM_LOG_DATA_OFFSET, *length);
+
+            return true;
+        }
+
+        // Damaged record is skipped, it would not be recovered after reset either
+        log->_tail = (log->_tail + 1) % log->_slot_count;
+        log->_count--;
+    }
+
+    return false;
+}
+
+bool bc_eeprom_log_remove(bc_eeprom_log_t *log)
+{
+    uint8_t state = _BC_EEPROM_LOG_STATE_REMOVED;
+
+    if (log->_count == 0)
+    {
+        return false;
+    }
+
+    if (!bc_eeprom_write(log->_address + log->_tail * BC_EEPROM_LOG_SLOT_SIZE + _BC_EEPROM_LOG_STATE_OFFSET, &state, 1))
+    {
+        return false;
+    }
+
+    log->_tail = (log->_tail + 1) % log->_slot_count;
+    log->_count--;
+
+    return true;
+}
+
+int bc_eeprom_log_get_count(bc_eeprom_log_t *log)
+{
+    return log->_count;
+}
+
+static bool _bc_eeprom_log_read_slot(bc_eeprom_log_t *log, int slot, uint8_t *buffer, uint16_t *sequence)
+{
+    if (!bc_eeprom_read(log->_address + slot * BC_EEPROM_LOG_SLOT_SIZE, buffer, BC_EEPROM_LOG_SLOT_SIZE))
+    {
+        return false;
+    }
+
+    if ((buffer[_BC_EEPROM_LOG_LENGTH_OFFSET] == 0) || (buffer[_BC_EEPROM_LOG_LENGTH_OFFSET] > BC_EEPROM_LOG_RECORD_SIZE))
+    {
+        return false;
+    }
+
+    if (_bc_eeprom_log_crc(buffer) != (buffer[_BC_EEPROM_LOG_CRC_OFFSET] | (buffer[_BC_EEPROM_LOG_CRC_OFFSET + 1] << 8)))
+    {
+        return false;
+    }
+
+    *sequence = buffer[_BC_EEPROM_LOG_SEQUENCE_OFFSET] | (buffer[_BC_EEPROM_LOG_SEQUENCE_OFFSET + 1] << 8);
+
+    return true;
+}
+
+static uint16_t _bc_eeprom_log_crc(const uint8_t *buffer)
+{
+    // CRC-16/CCITT of length, data and sequence
+    uint16_t crc = 0xffff;
+
+    for (size_t i = 0; i < _BC_EEPROM_LOG_CRC_OFFSET; i++)
+    {
+        crc ^= buffer[i] << 8;
+
+        for (int j = 0; j < 8; j++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
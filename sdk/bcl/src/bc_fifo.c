@@ -1,6 +1,11 @@
 #include <bc_fifo.h>
 #include <bc_irq.h>
 
+static size_t _bc_fifo_write(bc_fifo_t *fifo, size_t head, size_t tail, const void *buffer, size_t *length);
+static size_t _bc_fifo_read(bc_fifo_t *fifo, size_t head, size_t tail, void *buffer, size_t *length);
+static size_t _bc_fifo_get_span_length(bc_fifo_t *fifo);
+static size_t _bc_fifo_peek_length(bc_fifo_t *fifo);
+
 void bc_fifo_init(bc_fifo_t *fifo, void *buffer, size_t size)
 {
     fifo->buffer = buffer;
@@ -20,38 +25,7 @@ size_t bc_fifo_write(bc_fifo_t *fifo, const void *buffer, size_t length)
     // Disable interrupts
     bc_irq_disable();
 
-    // For each byte in buffer...
-    for (size_t i = 0; i < length; i++)
-    {
-        if ((fifo->head + 1) == fifo->tail)
-        {
-            // Enable interrupts
-            bc_irq_enable();
-
-            // Return number of bytes written
-            return i;
-        }
-
-        if (((fifo->head + 1) == fifo->size) && (fifo->tail == 0))
-        {
-            // Enable interrupts
-            bc_irq_enable();
-
-            // Return number of bytes written
-            return i;
-        }
-
-        *((uint8_t *) fifo->buffer + fifo->head) = *(uint8_t *) buffer;
-
-        buffer = (uint8_t *) buffer + 1;
-
-        fifo->head++;
-
-        if (fifo->head == fifo->size)
-        {
-            fifo->head = 0;
-        }
-    }
+    length = bc_fifo_irq_write(fifo, buffer, length);
 
     // Enable interrupts
     bc_irq_enable();
@@ -65,31 +39,7 @@ size_t bc_fifo_read(bc_fifo_t *fifo, void *buffer, size_t length)
     // Disable interrupts
     bc_irq_disable();
 
-    // For desired number of bytes...
-    for (size_t i = 0; i < length; i++)
-    {
-        if (fifo->tail != fifo->head)
-        {
-            *(uint8_t *) buffer = *((uint8_t *) fifo->buffer + fifo->tail);
-
-            buffer = (uint8_t *) buffer + 1;
-
-            fifo->tail++;
-
-            if (fifo->tail == fifo->size)
-            {
-                fifo->tail = 0;
-            }
-        }
-        else
-        {
-            // Enable interrupts
-            bc_irq_enable();
-
-            // Return number of bytes read
-            return i;
-        }
-    }
+    length = bc_fifo_irq_read(fifo, buffer, length);
 
     // Enable interrupts
     bc_irq_enable();
@@ -100,64 +50,104 @@ size_t bc_fifo_read(bc_fifo_t *fifo, void *buffer, size_t length)
 
 size_t bc_fifo_irq_write(bc_fifo_t *fifo, const void *buffer, size_t length)
 {
-    for (size_t i = 0; i < length; i++)
-    {
-        if ((fifo->head + 1) == fifo->tail)
-        {
-            // Return number of bytes written
-            return i;
-        }
+    fifo->head = _bc_fifo_write(fifo, fifo->head, fifo->tail, buffer, &length);
+
+    // Return number of bytes written
+    return length;
+}
 
-        if (((fifo->head + 1) == fifo->size) && (fifo->tail == 0))
-        {
-            // Return number of bytes written
-            return i;
-        }
+size_t bc_fifo_irq_read(bc_fifo_t *fifo, void *buffer, size_t length)
+{
+    fifo->tail = _bc_fifo_read(fifo, fifo->head, fifo->tail, buffer, &length);
 
-        *((uint8_t *) fifo->buffer + fifo->head) = *(uint8_t *) buffer;
+    // Return number of bytes read
+    return length;
+}
 
-        buffer = (uint8_t *) buffer + 1;
+size_t bc_fifo_spsc_write(bc_fifo_t *fifo, const void *buffer, size_t length)
+{
+    // Head is owned by producer, tail is updated by consumer
+    size_t head = __atomic_load_n(&fifo->head, __ATOMIC_RELAXED);
+    size_t tail = __atomic_load_n(&fifo->tail, __ATOMIC_ACQUIRE);
 
-        fifo->head++;
+    head = _bc_fifo_write(fifo, head, tail, buffer, &length);
 
-        if (fifo->head == fifo->size)
-        {
-            fifo->head = 0;
-        }
-    }
+    // Publish head only after data has been stored
+    __atomic_store_n(&fifo->head, head, __ATOMIC_RELEASE);
 
     // Return number of bytes written
     return length;
 }
 
-size_t bc_fifo_irq_read(bc_fifo_t *fifo, void *buffer, size_t length)
+size_t bc_fifo_spsc_read(bc_fifo_t *fifo, void *buffer, size_t length)
 {
-    for (size_t i = 0; i < length; i++)
+    // Tail is owned by consumer, head is updated by producer
+    size_t tail = __atomic_load_n(&fifo->tail, __ATOMIC_RELAXED);
+    size_t head = __atomic_load_n(&fifo->head, __ATOMIC_ACQUIRE);
+
+    tail = _bc_fifo_read(fifo, head, tail, buffer, &length);
+
+    // Release space only after data has been loaded
+    __atomic_store_n(&fifo->tail, tail, __ATOMIC_RELEASE);
+
+    // Return number of bytes read
+    return length;
+}
+
+size_t bc_fifo_peek(bc_fifo_t *fifo, const void **buffer)
+{
+    bc_irq_disable();
+
+    size_t length = _bc_fifo_peek_length(fifo);
+
+    *buffer = (uint8_t *) fifo->buffer + fifo->tail;
+
+    bc_irq_enable();
+
+    return length;
+}
+
+void bc_fifo_skip(bc_fifo_t *fifo, size_t length)
+{
+    bc_irq_disable();
+
+    fifo->tail += length;
+
+    if (fifo->tail >= fifo->size)
     {
-        if (fifo->tail != fifo->head)
-        {
-            *(uint8_t *) buffer = *((uint8_t *) fifo->buffer + fifo->tail);
-
-            buffer = (uint8_t *) buffer + 1;
-
-            fifo->tail++;
-
-            if (fifo->tail == fifo->size)
-            {
-                fifo->tail = 0;
-            }
-        }
-        else
-        {
-            // Return number of bytes read
-            return i;
-        }
+        fifo->tail -= fifo->size;
     }
 
-    // Return number of bytes read
+    bc_irq_enable();
+}
+
+size_t bc_fifo_get_span(bc_fifo_t *fifo, void **buffer)
+{
+    bc_irq_disable();
+
+    size_t length = _bc_fifo_get_span_length(fifo);
+
+    *buffer = (uint8_t *) fifo->buffer + fifo->head;
+
+    bc_irq_enable();
+
     return length;
 }
 
+void bc_fifo_commit(bc_fifo_t *fifo, size_t length)
+{
+    bc_irq_disable();
+
+    fifo->head += length;
+
+    if (fifo->head >= fifo->size)
+    {
+        fifo->head -= fifo->size;
+    }
+
+    bc_irq_enable();
+}
+
 bool bc_fifo_is_empty(bc_fifo_t *fifo)
 {
     bc_irq_disable();
@@ -168,3 +158,110 @@ bool bc_fifo_is_empty(bc_fifo_t *fifo)
 
 	return result;
 }
+
+static size_t _bc_fifo_write(bc_fifo_t *fifo, size_t head, size_t tail, const void *buffer, size_t *length)
+{
+    size_t free;
+
+    // One byte is always left empty to distinguish full FIFO from empty one
+    if (tail > head)
+    {
+        free = tail - head - 1;
+    }
+    else
+    {
+        free = fifo->size - head + tail - 1;
+    }
+
+    if (*length > free)
+    {
+        *length = free;
+    }
+
+    // Data is copied in at most two contiguous spans
+    size_t span = fifo->size - head;
+
+    if (span > *length)
+    {
+        span = *length;
+    }
+
+    memcpy((uint8_t *) fifo->buffer + head, buffer, span);
+
+    memcpy(fifo->buffer, (const uint8_t *) buffer + span, *length - span);
+
+    head += *length;
+
+    if (head >= fifo->size)
+    {
+        head -= fifo->size;
+    }
+
+    return head;
+}
+
+static size_t _bc_fifo_read(bc_fifo_t *fifo, size_t head, size_t tail, void *buffer, size_t *length)
+{
+    size_t available;
+
+    if (head >= tail)
+    {
+        available = head - tail;
+    }
+    else
+    {
+        available = fifo->size - tail + head;
+    }
+
+    if (*length > available)
+    {
+        *length = available;
+    }
+
+    // Data is copied out in at most two contiguous spans
+    size_t span = fifo->size - tail;
+
+    if (span > *length)
+    {
+        span = *length;
+    }
+
+    memcpy(buffer, (uint8_t *) fifo->buffer + tail, span);
+
+    memcpy((uint8_t *) buffer + span, fifo->buffer, *length - span);
+
+    tail += *length;
+
+    if (tail >= fifo->size)
+    {
+        tail -= fifo->size;
+    }
+
+    return tail;
+}
+
+static size_t _bc_fifo_get_span_length(bc_fifo_t *fifo)
+{
+    if (fifo->tail > fifo->head)
+    {
+        return fifo->tail - fifo->head - 1;
+    }
+
+    // Last byte of buffer can not be used if tail is at beginning
+    if (fifo->tail == 0)
+    {
+        return fifo->size - fifo->head - 1;
+    }
+
+    return fifo->size - fifo->head;
+}
+
+static size_t _bc_fifo_peek_length(bc_fifo_t *fifo)
+{
+    if (fifo->head >= fifo->tail)
+    {
+        return fifo->head - fifo->tail;
+    }
+
+    return fifo->size - fifo->tail;
+}
@@ -5,6 +5,7 @@
 #include <bc_ds28e17.h>
 #include <bc_module_sensor.h>
 #include <bc_system.h>
+#include <bc_irq.h>
 
 #define _BC_I2C_TX_TIMEOUT_ADJUST_FACTOR 1.5
 #define _BC_I2C_RX_TIMEOUT_ADJUST_FACTOR 1.5
@@ -21,18 +22,76 @@
 
 #define __BC_I2C_RESET_PERIPHERAL(__I2C__) {__I2C__->CR1 &= ~I2C_CR1_PE; __I2C__->CR1 |= I2C_CR1_PE; }
 
+#define _BC_I2C_ASYNC_INTERRUPTS (I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_NACKIE | I2C_CR1_STOPIE | I2C_CR1_TCIE | I2C_CR1_ERRIE)
+
+// Memory address and data are counted together in NBYTES field
+#define _BC_I2C_ASYNC_MAX_LENGTH (255 - _BC_I2C_MEMORY_ADDRESS_SIZE_16BIT)
+
+typedef enum
+{
+    _BC_I2C_ASYNC_OPERATION_WRITE = 0,
+    _BC_I2C_ASYNC_OPERATION_READ = 1,
+    _BC_I2C_ASYNC_OPERATION_MEMORY_WRITE = 2,
+    _BC_I2C_ASYNC_OPERATION_MEMORY_READ = 3
+
+} _bc_i2c_async_operation_t;
+
+typedef struct
+{
+    _bc_i2c_async_operation_t operation;
+    bc_i2c_priority_t priority;
+    uint8_t device_address;
+    uint32_t memory_address;
+    uint8_t *buffer;
+    size_t length;
+    void (*event_handler)(bc_i2c_event_t, void *);
+    void *event_param;
+    bc_tick_t tick_request;
+    bool success;
+
+} _bc_i2c_async_transfer_t;
+
+typedef struct
+{
+    bc_i2c_channel_t channel;
+    uint8_t device_address;
+    bc_i2c_priority_t priority;
+    bc_i2c_device_stats_t stats;
+
+} _bc_i2c_device_t;
+
 static struct
 {
     bool initialized;
     bc_i2c_speed_t speed;
     I2C_TypeDef *i2c;
+    IRQn_Type irqn;
+    bool async_initialized;
+    bc_scheduler_task_id_t async_task_id;
+    _bc_i2c_async_transfer_t async_queue[BC_I2C_ASYNC_QUEUE_SIZE];
+
+    // Queue starts with finished transfers whose event has not been delivered yet, running transfer follows them
+    volatile int async_queue_head;
+    volatile int async_queue_length;
+    volatile int async_done_count;
+    volatile bool async_running;
+    volatile bool async_hold;
+    bool async_clock;
+    bc_tick_t async_tick_timeout;
+    uint8_t async_header[_BC_I2C_MEMORY_ADDRESS_SIZE_16BIT];
+    size_t async_header_length;
+    size_t async_position;
+    bool async_nack;
 
 } _bc_i2c[] = {
-    [BC_I2C_I2C0] = { .initialized = false, .i2c = I2C2 },
-    [BC_I2C_I2C1] = { .initialized = false, .i2c = I2C1 },
+    [BC_I2C_I2C0] = { .initialized = false, .i2c = I2C2, .irqn = I2C2_IRQn },
+    [BC_I2C_I2C1] = { .initialized = false, .i2c = I2C1, .irqn = I2C1_IRQn },
     [BC_I2C_I2C_1W]= { .initialized = false, .i2c = NULL }
 };
 
+static _bc_i2c_device_t _bc_i2c_device[BC_I2C_DEVICE_COUNT];
+static int _bc_i2c_device_count;
+
 static bc_tick_t tick_timeout;
 static bc_ds28e17_t ds28e17;
 
@@ -50,6 +109,22 @@ static uint32_t bc_i2c_get_timeout_us(bc_i2c_channel_t channel, size_t length);
 static void _bc_i2c_timeout_begin(uint32_t timeout_ms);
 static bool _bc_i2c_timeout_is_expired(void);
 static void _bc_i2c_restore_bus(I2C_TypeDef *i2c);
+static bool _bc_i2c_async_submit(bc_i2c_channel_t channel, _bc_i2c_async_operation_t operation, uint8_t device_address, uint32_t memory_address, void *buffer, size_t length, void (*event_handler)(bc_i2c_event_t, void *), void *event_param);
+static void _bc_i2c_async_task(void *param);
+static void _bc_i2c_async_task_1w(void);
+static void _bc_i2c_async_start(bc_i2c_channel_t channel);
+static void _bc_i2c_async_configure(bc_i2c_channel_t channel);
+static void _bc_i2c_async_finish(bc_i2c_channel_t channel, bool success);
+static void _bc_i2c_async_check_timeout(bc_i2c_channel_t channel);
+static void _bc_i2c_async_pause(bc_i2c_channel_t channel);
+static void _bc_i2c_async_resume(bc_i2c_channel_t channel);
+static void _bc_i2c_async_irq_handler(bc_i2c_channel_t channel);
+static _bc_i2c_device_t *_bc_i2c_get_device(bc_i2c_channel_t channel, uint8_t device_address);
+static void _bc_i2c_update_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t tick_request, bool success);
+static bool _bc_i2c_blocking_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer);
+static bool _bc_i2c_blocking_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer);
+static bool _bc_i2c_blocking_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer);
+static bool _bc_i2c_blocking_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer);
 
 void bc_i2c_init(bc_i2c_channel_t channel, bc_i2c_speed_t speed)
 {
@@ -149,6 +224,9 @@ void bc_i2c_set_speed(bc_i2c_channel_t channel, bc_i2c_speed_t speed)
         return;
     }
 
+    // Disabling peripheral would abort running asynchronous transfer
+    _bc_i2c_async_pause(channel);
+
     if (speed == BC_I2C_SPEED_400_KHZ)
     {
         timingr = 0x301d1d;
@@ -172,9 +250,187 @@ void bc_i2c_set_speed(bc_i2c_channel_t channel, bc_i2c_speed_t speed)
     }
 
     _bc_i2c[channel].speed = speed;
+
+    _bc_i2c_async_resume(channel);
 }
 
 bool bc_i2c_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
+{
+    bc_tick_t tick_request = bc_tick_get();
+
+    _bc_i2c_async_pause(channel);
+
+    bool status = _bc_i2c_blocking_write(channel, transfer);
+
+    _bc_i2c_async_resume(channel);
+
+    _bc_i2c_update_stats(channel, transfer->device_address, tick_request, status);
+
+    return status;
+}
+
+bool bc_i2c_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
+{
+    bc_tick_t tick_request = bc_tick_get();
+
+    _bc_i2c_async_pause(channel);
+
+    bool status = _bc_i2c_blocking_read(channel, transfer);
+
+    _bc_i2c_async_resume(channel);
+
+    _bc_i2c_update_stats(channel, transfer->device_address, tick_request, status);
+
+    return status;
+}
+
+bool bc_i2c_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
+{
+    bc_tick_t tick_request = bc_tick_get();
+
+    _bc_i2c_async_pause(channel);
+
+    bool status = _bc_i2c_blocking_memory_write(channel, transfer);
+
+    _bc_i2c_async_resume(channel);
+
+    _bc_i2c_update_stats(channel, transfer->device_address, tick_request, status);
+
+    return status;
+}
+
+bool bc_i2c_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
+{
+    bc_tick_t tick_request = bc_tick_get();
+
+    _bc_i2c_async_pause(channel);
+
+    bool status = _bc_i2c_blocking_memory_read(channel, transfer);
+
+    _bc_i2c_async_resume(channel);
+
+    _bc_i2c_update_stats(channel, transfer->device_address, tick_request, status);
+
+    return status;
+}
+
+bool bc_i2c_memory_write_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t data)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = &data;
+    transfer.length = 1;
+
+    return bc_i2c_memory_write(channel, &transfer);
+}
+
+bool bc_i2c_memory_write_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t data)
+{
+    uint8_t buffer[2];
+
+    buffer[0] = data >> 8;
+    buffer[1] = data;
+
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = 2;
+
+    return bc_i2c_memory_write(channel, &transfer);
+}
+
+bool bc_i2c_memory_read_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t *data)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = data;
+    transfer.length = 1;
+
+    return bc_i2c_memory_read(channel, &transfer);
+}
+
+bool bc_i2c_memory_read_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t *data)
+{
+    uint8_t buffer[2];
+
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = 2;
+
+    if (!bc_i2c_memory_read(channel, &transfer))
+    {
+        return false;
+    }
+
+    *data = buffer[0] << 8 | buffer[1];
+
+    return true;
+}
+
+bool bc_i2c_async_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, _BC_I2C_ASYNC_OPERATION_WRITE, transfer->device_address, 0, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_async_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, _BC_I2C_ASYNC_OPERATION_READ, transfer->device_address, 0, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_async_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, _BC_I2C_ASYNC_OPERATION_MEMORY_WRITE, transfer->device_address, transfer->memory_address, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_async_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    return _bc_i2c_async_submit(channel, _BC_I2C_ASYNC_OPERATION_MEMORY_READ, transfer->device_address, transfer->memory_address, transfer->buffer, transfer->length, event_handler, event_param);
+}
+
+bool bc_i2c_is_ready(bc_i2c_channel_t channel)
+{
+    return (_bc_i2c[channel].async_queue_length == 0);
+}
+
+bool bc_i2c_set_device_priority(bc_i2c_channel_t channel, uint8_t device_address, bc_i2c_priority_t priority)
+{
+    _bc_i2c_device_t *device = _bc_i2c_get_device(channel, device_address);
+
+    if (device == NULL)
+    {
+        return false;
+    }
+
+    device->priority = priority;
+
+    return true;
+}
+
+bool bc_i2c_get_device_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_i2c_device_stats_t *stats)
+{
+    for (int i = 0; i < _bc_i2c_device_count; i++)
+    {
+        if ((_bc_i2c_device[i].channel == channel) && (_bc_i2c_device[i].device_address == device_address))
+        {
+            *stats = _bc_i2c_device[i].stats;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool _bc_i2c_blocking_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
 {
     if (!_bc_i2c[channel].initialized)
     {
@@ -186,6 +442,7 @@ bool bc_i2c_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
         return bc_ds28e17_write(&ds28e17, transfer);
     }
 
+
     I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
 
     bc_system_pll_enable();
@@ -220,7 +477,7 @@ bool bc_i2c_write(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
 
 }
 
-bool bc_i2c_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
+static bool _bc_i2c_blocking_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
 {
     if (!_bc_i2c[channel].initialized)
     {
@@ -232,6 +489,7 @@ bool bc_i2c_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
         return bc_ds28e17_read(&ds28e17, transfer);
     }
 
+
     I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
 
     bc_system_pll_enable();
@@ -264,7 +522,7 @@ bool bc_i2c_read(bc_i2c_channel_t channel, const bc_i2c_transfer_t *transfer)
     return status;
 }
 
-bool bc_i2c_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
+static bool _bc_i2c_blocking_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
 {
     if (!_bc_i2c[channel].initialized)
     {
@@ -276,6 +534,7 @@ bool bc_i2c_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_
         return bc_ds28e17_memory_write(&ds28e17, transfer);
     }
 
+
     I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
 
     // Enable PLL and disable sleep
@@ -302,7 +561,7 @@ bool bc_i2c_memory_write(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_
     return true;
 }
 
-bool bc_i2c_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
+static bool _bc_i2c_blocking_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t *transfer)
 {
     if (!_bc_i2c[channel].initialized)
     {
@@ -314,6 +573,7 @@ bool bc_i2c_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t
         return bc_ds28e17_memory_read(&ds28e17, transfer);
     }
 
+
     I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
 
     // Enable PLL and disable sleep
@@ -339,68 +599,6 @@ bool bc_i2c_memory_read(bc_i2c_channel_t channel, const bc_i2c_memory_transfer_t
     return true;
 }
 
-bool bc_i2c_memory_write_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t data)
-{
-    bc_i2c_memory_transfer_t transfer;
-
-    transfer.device_address = device_address;
-    transfer.memory_address = memory_address;
-    transfer.buffer = &data;
-    transfer.length = 1;
-
-    return bc_i2c_memory_write(channel, &transfer);
-}
-
-bool bc_i2c_memory_write_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t data)
-{
-    uint8_t buffer[2];
-
-    buffer[0] = data >> 8;
-    buffer[1] = data;
-
-    bc_i2c_memory_transfer_t transfer;
-
-    transfer.device_address = device_address;
-    transfer.memory_address = memory_address;
-    transfer.buffer = buffer;
-    transfer.length = 2;
-
-    return bc_i2c_memory_write(channel, &transfer);
-}
-
-bool bc_i2c_memory_read_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t *data)
-{
-    bc_i2c_memory_transfer_t transfer;
-
-    transfer.device_address = device_address;
-    transfer.memory_address = memory_address;
-    transfer.buffer = data;
-    transfer.length = 1;
-
-    return bc_i2c_memory_read(channel, &transfer);
-}
-
-bool bc_i2c_memory_read_16b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint16_t *data)
-{
-    uint8_t buffer[2];
-
-    bc_i2c_memory_transfer_t transfer;
-
-    transfer.device_address = device_address;
-    transfer.memory_address = memory_address;
-    transfer.buffer = buffer;
-    transfer.length = 2;
-
-    if (!bc_i2c_memory_read(channel, &transfer))
-    {
-        return false;
-    }
-
-    *data = buffer[0] << 8 | buffer[1];
-
-    return true;
-}
-
 static bool _bc_i2c_mem_write(I2C_TypeDef *i2c, uint8_t device_address, uint16_t memory_address, uint16_t memory_address_length, uint8_t *buffer, uint16_t length)
 {
     // Get maximum allowed timeout in ms
@@ -771,3 +969,504 @@ static void _bc_i2c_restore_bus(I2C_TypeDef *i2c)
         GPIOB->BSRR = GPIO_BSRR_BR_11;
     }
 }
+
+static bool _bc_i2c_async_submit(bc_i2c_channel_t channel, _bc_i2c_async_operation_t operation, uint8_t device_address, uint32_t memory_address, void *buffer, size_t length, void (*event_handler)(bc_i2c_event_t, void *), void *event_param)
+{
+    if (!_bc_i2c[channel].initialized)
+    {
+        return false;
+    }
+
+    if ((_bc_i2c[channel].async_queue_length == BC_I2C_ASYNC_QUEUE_SIZE) || (length > _BC_I2C_ASYNC_MAX_LENGTH))
+    {
+        return false;
+    }
+
+    if ((length == 0) && ((operation == _BC_I2C_ASYNC_OPERATION_READ) || (operation == _BC_I2C_ASYNC_OPERATION_MEMORY_READ)))
+    {
+        return false;
+    }
+
+    if (!_bc_i2c[channel].async_initialized)
+    {
+        _bc_i2c[channel].async_task_id = bc_scheduler_register(_bc_i2c_async_task, (void *) (size_t) channel, BC_TICK_INFINITY);
+
+        _bc_i2c[channel].async_initialized = true;
+    }
+
+    _bc_i2c_device_t *device = _bc_i2c_get_device(channel, device_address);
+
+    _bc_i2c_async_transfer_t transfer;
+
+    transfer.operation = operation;
+    transfer.priority = device != NULL ? device->priority : BC_I2C_PRIORITY_NORMAL;
+    transfer.device_address = device_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = length;
+    transfer.event_handler = event_handler;
+    transfer.event_param = event_param;
+    transfer.tick_request = bc_tick_get();
+    transfer.success = false;
+
+    bc_irq_disable();
+
+    // Finished and running transfers keep their position
+    int first = _bc_i2c[channel].async_done_count + (_bc_i2c[channel].async_running ? 1 : 0);
+    int i = _bc_i2c[channel].async_queue_length;
+
+    // Transfer is placed behind all waiting transfers of the same or higher priority
+    while ((i > first) && (_bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + i - 1) % BC_I2C_ASYNC_QUEUE_SIZE].priority < transfer.priority))
+    {
+        _bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + i) % BC_I2C_ASYNC_QUEUE_SIZE] =
+                _bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + i - 1) % BC_I2C_ASYNC_QUEUE_SIZE];
+
+        i--;
+    }
+
+    _bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + i) % BC_I2C_ASYNC_QUEUE_SIZE] = transfer;
+
+    _bc_i2c[channel].async_queue_length++;
+
+    bool running = _bc_i2c[channel].async_running;
+
+    bc_irq_enable();
+
+    // Running transfer starts the next one from interrupt, otherwise bus is started by task once transfers requested in this spin are collected
+    if (!running)
+    {
+        bc_scheduler_plan_now(_bc_i2c[channel].async_task_id);
+    }
+
+    return true;
+}
+
+static void _bc_i2c_async_task(void *param)
+{
+    bc_i2c_channel_t channel = (bc_i2c_channel_t) (size_t) param;
+
+    if (channel == BC_I2C_I2C_1W)
+    {
+        _bc_i2c_async_task_1w();
+
+        return;
+    }
+
+    _bc_i2c_async_check_timeout(channel);
+
+    // Events are delivered while the bus is running the next transfer
+    while (_bc_i2c[channel].async_done_count != 0)
+    {
+        if (!_bc_i2c[channel].async_running && !_bc_i2c[channel].async_hold && (_bc_i2c[channel].async_queue_length > _bc_i2c[channel].async_done_count))
+        {
+            _bc_i2c_async_start(channel);
+        }
+
+        _bc_i2c_async_transfer_t transfer = _bc_i2c[channel].async_queue[_bc_i2c[channel].async_queue_head];
+
+        bc_irq_disable();
+
+        _bc_i2c[channel].async_queue_head = (_bc_i2c[channel].async_queue_head + 1) % BC_I2C_ASYNC_QUEUE_SIZE;
+        _bc_i2c[channel].async_queue_length--;
+        _bc_i2c[channel].async_done_count--;
+
+        bc_irq_enable();
+
+        _bc_i2c_update_stats(channel, transfer.device_address, transfer.tick_request, transfer.success);
+
+        if (transfer.event_handler != NULL)
+        {
+            transfer.event_handler(transfer.success ? BC_I2C_EVENT_DONE : BC_I2C_EVENT_ERROR, transfer.event_param);
+        }
+    }
+
+    // Transfers queued by event handlers join the same wake window
+    if (!_bc_i2c[channel].async_running && !_bc_i2c[channel].async_hold && (_bc_i2c[channel].async_queue_length > _bc_i2c[channel].async_done_count))
+    {
+        _bc_i2c_async_start(channel);
+    }
+
+    bc_irq_disable();
+
+    // Transfer can be finished by interrupt after the events were delivered
+    if (_bc_i2c[channel].async_done_count != 0)
+    {
+        bc_scheduler_plan_current_now();
+    }
+    else if (_bc_i2c[channel].async_running)
+    {
+        bc_scheduler_plan_current_absolute(_bc_i2c[channel].async_tick_timeout);
+    }
+
+    bc_irq_enable();
+
+    // Clock is released once the whole batch is finished
+    if ((_bc_i2c[channel].async_queue_length == 0) && _bc_i2c[channel].async_clock)
+    {
+        _bc_i2c[channel].async_clock = false;
+
+        bc_system_deep_sleep_enable();
+
+        bc_scheduler_disable_sleep();
+
+        bc_system_pll_disable();
+    }
+}
+
+static void _bc_i2c_async_task_1w(void)
+{
+    // Transfers over DS28E17 bridge are blocking, they are only ordered with the other queued transfers
+    while (_bc_i2c[BC_I2C_I2C_1W].async_queue_length != 0)
+    {
+        _bc_i2c_async_transfer_t transfer = _bc_i2c[BC_I2C_I2C_1W].async_queue[_bc_i2c[BC_I2C_I2C_1W].async_queue_head];
+        bc_i2c_transfer_t plain_transfer;
+        bc_i2c_memory_transfer_t memory_transfer;
+
+        plain_transfer.device_address = transfer.device_address;
+        plain_transfer.buffer = transfer.buffer;
+        plain_transfer.length = transfer.length;
+
+        memory_transfer.device_address = transfer.device_address;
+        memory_transfer.memory_address = transfer.memory_address;
+        memory_transfer.buffer = transfer.buffer;
+        memory_transfer.length = transfer.length;
+
+        switch (transfer.operation)
+        {
+            case _BC_I2C_ASYNC_OPERATION_WRITE:
+            {
+                transfer.success = bc_ds28e17_write(&ds28e17, &plain_transfer);
+
+                break;
+            }
+            case _BC_I2C_ASYNC_OPERATION_READ:
+            {
+                transfer.success = bc_ds28e17_read(&ds28e17, &plain_transfer);
+
+                break;
+            }
+            case _BC_I2C_ASYNC_OPERATION_MEMORY_WRITE:
+            {
+                transfer.success = bc_ds28e17_memory_write(&ds28e17, &memory_transfer);
+
+                break;
+            }
+            case _BC_I2C_ASYNC_OPERATION_MEMORY_READ:
+            default:
+            {
+                transfer.success = bc_ds28e17_memory_read(&ds28e17, &memory_transfer);
+
+                break;
+            }
+        }
+
+        _bc_i2c[BC_I2C_I2C_1W].async_queue_head = (_bc_i2c[BC_I2C_I2C_1W].async_queue_head + 1) % BC_I2C_ASYNC_QUEUE_SIZE;
+        _bc_i2c[BC_I2C_I2C_1W].async_queue_length--;
+
+        _bc_i2c_update_stats(BC_I2C_I2C_1W, transfer.device_address, transfer.tick_request, transfer.success);
+
+        if (transfer.event_handler != NULL)
+        {
+            transfer.event_handler(transfer.success ? BC_I2C_EVENT_DONE : BC_I2C_EVENT_ERROR, transfer.event_param);
+        }
+    }
+}
+
+static void _bc_i2c_async_start(bc_i2c_channel_t channel)
+{
+    if (!_bc_i2c[channel].async_clock)
+    {
+        // PLL keeps core awake, but sleep mode (not stop mode) is allowed while peripheral is clocked by PCLK
+        bc_system_pll_enable();
+
+        bc_scheduler_enable_sleep();
+
+        bc_system_deep_sleep_disable();
+
+        _bc_i2c[channel].async_clock = true;
+    }
+
+    bc_irq_disable();
+
+    // Interrupt of the previous transfer could have started this one in the meantime
+    if (!_bc_i2c[channel].async_running && (_bc_i2c[channel].async_queue_length > _bc_i2c[channel].async_done_count))
+    {
+        _bc_i2c_async_configure(channel);
+    }
+
+    bc_irq_enable();
+}
+
+static void _bc_i2c_async_configure(bc_i2c_channel_t channel)
+{
+    I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
+    _bc_i2c_async_transfer_t *transfer = &_bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + _bc_i2c[channel].async_done_count) % BC_I2C_ASYNC_QUEUE_SIZE];
+
+    _bc_i2c[channel].async_header_length = 0;
+
+    if ((transfer->operation == _BC_I2C_ASYNC_OPERATION_MEMORY_WRITE) || (transfer->operation == _BC_I2C_ASYNC_OPERATION_MEMORY_READ))
+    {
+        if ((transfer->memory_address & BC_I2C_MEMORY_ADDRESS_16_BIT) != 0)
+        {
+            _bc_i2c[channel].async_header[_bc_i2c[channel].async_header_length++] = transfer->memory_address >> 8;
+        }
+
+        _bc_i2c[channel].async_header[_bc_i2c[channel].async_header_length++] = transfer->memory_address;
+    }
+
+    _bc_i2c[channel].async_position = 0;
+    _bc_i2c[channel].async_nack = false;
+
+    _bc_i2c[channel].async_tick_timeout = bc_tick_get() + _BC_I2C_TX_TIMEOUT_ADJUST_FACTOR * bc_i2c_get_timeout_ms(channel, _bc_i2c[channel].async_header_length + transfer->length);
+
+    _bc_i2c[channel].async_running = true;
+
+    i2c->ICR = I2C_ICR_STOPCF | I2C_ICR_NACKCF | I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+
+    i2c->CR1 |= _BC_I2C_ASYNC_INTERRUPTS;
+
+    NVIC_EnableIRQ(_bc_i2c[channel].irqn);
+
+    switch (transfer->operation)
+    {
+        case _BC_I2C_ASYNC_OPERATION_WRITE:
+        case _BC_I2C_ASYNC_OPERATION_MEMORY_WRITE:
+        {
+            // Memory address and data are sent in one phase
+            _bc_i2c_config(i2c, transfer->device_address << 1, _bc_i2c[channel].async_header_length + transfer->length, _BC_I2C_AUTOEND_MODE, _BC_I2C_GENERATE_START_WRITE);
+
+            break;
+        }
+        case _BC_I2C_ASYNC_OPERATION_READ:
+        {
+            _bc_i2c_config(i2c, transfer->device_address << 1, transfer->length, _BC_I2C_AUTOEND_MODE, I2C_CR2_START | I2C_CR2_RD_WRN);
+
+            break;
+        }
+        case _BC_I2C_ASYNC_OPERATION_MEMORY_READ:
+        default:
+        {
+            // Read direction is restarted from interrupt when memory address has been sent
+            _bc_i2c_config(i2c, transfer->device_address << 1, _bc_i2c[channel].async_header_length, _BC_I2C_SOFTEND_MODE, _BC_I2C_GENERATE_START_WRITE);
+
+            break;
+        }
+    }
+}
+
+static void _bc_i2c_async_finish(bc_i2c_channel_t channel, bool success)
+{
+    I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
+
+    i2c->CR1 &= ~_BC_I2C_ASYNC_INTERRUPTS;
+
+    if (!success)
+    {
+        // Reset I2C peripheral to generate STOP conditions immediately
+        __BC_I2C_RESET_PERIPHERAL(i2c);
+    }
+
+    // Clear Configuration Register 2
+    i2c->CR2 &= ~(I2C_CR2_SADD | I2C_CR2_HEAD10R | I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_RD_WRN);
+
+    _bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + _bc_i2c[channel].async_done_count) % BC_I2C_ASYNC_QUEUE_SIZE].success = success;
+
+    _bc_i2c[channel].async_done_count++;
+
+    _bc_i2c[channel].async_running = false;
+
+    // Next transfer follows immediately, events are delivered by task in the meantime
+    if (!_bc_i2c[channel].async_hold && (_bc_i2c[channel].async_queue_length > _bc_i2c[channel].async_done_count))
+    {
+        _bc_i2c_async_configure(channel);
+    }
+
+    bc_scheduler_plan_now(_bc_i2c[channel].async_task_id);
+}
+
+static void _bc_i2c_async_check_timeout(bc_i2c_channel_t channel)
+{
+    bool timeout = false;
+
+    bc_irq_disable();
+
+    // If interrupt has not finished transfer in time...
+    if (_bc_i2c[channel].async_running && (bc_tick_get() >= _bc_i2c[channel].async_tick_timeout))
+    {
+        _bc_i2c[channel].i2c->CR1 &= ~_BC_I2C_ASYNC_INTERRUPTS;
+
+        _bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + _bc_i2c[channel].async_done_count) % BC_I2C_ASYNC_QUEUE_SIZE].success = false;
+
+        _bc_i2c[channel].async_done_count++;
+
+        _bc_i2c[channel].async_running = false;
+
+        timeout = true;
+    }
+
+    bc_irq_enable();
+
+    if (timeout)
+    {
+        // Device can hold SDA low in the middle of byte
+        _bc_i2c_restore_bus(_bc_i2c[channel].i2c);
+    }
+}
+
+static void _bc_i2c_async_pause(bc_i2c_channel_t channel)
+{
+    if ((channel == BC_I2C_I2C_1W) || !_bc_i2c[channel].async_initialized)
+    {
+        return;
+    }
+
+    // Interrupt does not start the next transfer while blocking transfer owns the bus
+    _bc_i2c[channel].async_hold = true;
+
+    while (_bc_i2c[channel].async_running)
+    {
+        _bc_i2c_async_check_timeout(channel);
+    }
+}
+
+static void _bc_i2c_async_resume(bc_i2c_channel_t channel)
+{
+    if ((channel == BC_I2C_I2C_1W) || !_bc_i2c[channel].async_initialized)
+    {
+        return;
+    }
+
+    _bc_i2c[channel].async_hold = false;
+
+    if (_bc_i2c[channel].async_queue_length != 0)
+    {
+        bc_scheduler_plan_now(_bc_i2c[channel].async_task_id);
+    }
+}
+
+static _bc_i2c_device_t *_bc_i2c_get_device(bc_i2c_channel_t channel, uint8_t device_address)
+{
+    for (int i = 0; i < _bc_i2c_device_count; i++)
+    {
+        if ((_bc_i2c_device[i].channel == channel) && (_bc_i2c_device[i].device_address == device_address))
+        {
+            return &_bc_i2c_device[i];
+        }
+    }
+
+    if (_bc_i2c_device_count == BC_I2C_DEVICE_COUNT)
+    {
+        return NULL;
+    }
+
+    _bc_i2c_device_t *device = &_bc_i2c_device[_bc_i2c_device_count++];
+
+    memset(device, 0, sizeof(*device));
+
+    device->channel = channel;
+    device->device_address = device_address;
+    device->priority = BC_I2C_PRIORITY_NORMAL;
+
+    return device;
+}
+
+static void _bc_i2c_update_stats(bc_i2c_channel_t channel, uint8_t device_address, bc_tick_t tick_request, bool success)
+{
+    _bc_i2c_device_t *device = _bc_i2c_get_device(channel, device_address);
+
+    if (device == NULL)
+    {
+        return;
+    }
+
+    bc_tick_t latency = bc_tick_get() - tick_request;
+
+    device->stats.transfer_count++;
+
+    if (!success)
+    {
+        device->stats.error_count++;
+    }
+
+    device->stats.latency_total += latency;
+
+    if (device->stats.latency_max < latency)
+    {
+        device->stats.latency_max = latency;
+    }
+}
+
+static void _bc_i2c_async_irq_handler(bc_i2c_channel_t channel)
+{
+    I2C_TypeDef *i2c = _bc_i2c[channel].i2c;
+    _bc_i2c_async_transfer_t *transfer = &_bc_i2c[channel].async_queue[(_bc_i2c[channel].async_queue_head + _bc_i2c[channel].async_done_count) % BC_I2C_ASYNC_QUEUE_SIZE];
+    size_t header_length = _bc_i2c[channel].async_header_length;
+    uint32_t isr = i2c->ISR;
+
+    if (!_bc_i2c[channel].async_running)
+    {
+        i2c->CR1 &= ~_BC_I2C_ASYNC_INTERRUPTS;
+
+        return;
+    }
+
+    // If bus error, arbitration loss or overrun occured...
+    if ((isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)) != 0)
+    {
+        _bc_i2c_async_finish(channel, false);
+
+        return;
+    }
+
+    if ((isr & I2C_ISR_NACKF) != 0)
+    {
+        i2c->ICR = I2C_ICR_NACKCF;
+
+        // STOP is generated by hardware only in AUTOEND mode
+        if ((i2c->CR2 & I2C_CR2_AUTOEND) == 0)
+        {
+            i2c->CR2 |= I2C_CR2_STOP;
+        }
+
+        _bc_i2c[channel].async_nack = true;
+    }
+    else if ((isr & I2C_ISR_TXIS) != 0)
+    {
+        size_t position = _bc_i2c[channel].async_position++;
+
+        // Write memory address and then data to TXDR
+        i2c->TXDR = position < header_length ? _bc_i2c[channel].async_header[position] : transfer->buffer[position - header_length];
+    }
+
+    if ((isr & I2C_ISR_RXNE) != 0)
+    {
+        size_t position = _bc_i2c[channel].async_position++;
+
+        // Read data from RXDR
+        transfer->buffer[position - header_length] = i2c->RXDR;
+    }
+
+    if ((isr & I2C_ISR_TC) != 0)
+    {
+        // Memory address has been sent, restart in read direction
+        _bc_i2c_config(i2c, transfer->device_address << 1, transfer->length, _BC_I2C_AUTOEND_MODE, I2C_CR2_START | I2C_CR2_RD_WRN);
+    }
+
+    if ((isr & I2C_ISR_STOPF) != 0)
+    {
+        // Clear STOP flag
+        i2c->ICR = I2C_ICR_STOPCF;
+
+        _bc_i2c_async_finish(channel, !_bc_i2c[channel].async_nack && (_bc_i2c[channel].async_position == header_length + transfer->length));
+    }
+}
+
+void I2C1_IRQHandler(void)
+{
+    _bc_i2c_async_irq_handler(BC_I2C_I2C1);
+}
+
+void I2C2_IRQHandler(void)
+{
+    _bc_i2c_async_irq_handler(BC_I2C_I2C0);
+}
@@ -4,6 +4,12 @@
 #include <bc_opt3001.h>
 #include <bc_mpl3115a2.h>
 
+#define _BC_MODULE_CLIMATE_SENSOR_THERMOMETER (1 << 0)
+#define _BC_MODULE_CLIMATE_SENSOR_HYGROMETER (1 << 1)
+#define _BC_MODULE_CLIMATE_SENSOR_LUX_METER (1 << 2)
+#define _BC_MODULE_CLIMATE_SENSOR_BAROMETER (1 << 3)
+#define _BC_MODULE_CLIMATE_SENSOR_ALL 0x0f
+
 static struct
 {
     void (*event_handler)(bc_module_climate_event_t, void *);
@@ -12,9 +18,21 @@ static struct
     bc_sht20_t sht20;
     bc_opt3001_t opt3001;
     bc_mpl3115a2_t mpl3115a2;
+    bc_scheduler_task_id_t task_id_interval;
+    bc_tick_t update_interval;
+    bool synchronized;
+
+    // Sensors which have not finished measurement started by bc_module_climate_measure_all_sensors yet
+    int pending;
+    bool snapshot_valid;
+    bc_module_climate_snapshot_t snapshot;
 
 } _bc_module_climate;
 
+static void _bc_module_climate_task_interval(void *param);
+
+static void _bc_module_climate_event(int sensor, bc_module_climate_event_t event, bool error);
+
 static void _bc_module_climate_tmp112_event_handler(bc_tmp112_t *self, bc_tmp112_event_t event, void *event_param);
 
 static void _bc_module_climate_sht20_event_handler(bc_sht20_t *self, bc_sht20_event_t event, void *event_param);
@@ -38,6 +56,8 @@ void bc_module_climate_init(void)
 
     bc_mpl3115a2_init(&_bc_module_climate.mpl3115a2, BC_I2C_I2C0, 0x60);
     bc_mpl3115a2_set_event_handler(&_bc_module_climate.mpl3115a2, _bc_module_climate_mpl3115a2_event_handler, NULL);
+
+    _bc_module_climate.task_id_interval = bc_scheduler_register(_bc_module_climate_task_interval, NULL, BC_TICK_INFINITY);
 }
 
 void bc_module_climate_set_event_handler(void (*event_handler)(bc_module_climate_event_t, void *), void *event_param)
@@ -48,12 +68,38 @@ void bc_module_climate_set_event_handler(void (*event_handler)(bc_module_climate
 
 void bc_module_climate_set_update_interval_all_sensors(bc_tick_t interval)
 {
+    _bc_module_climate.synchronized = false;
+
+    bc_scheduler_plan_absolute(_bc_module_climate.task_id_interval, BC_TICK_INFINITY);
+
     bc_tmp112_set_update_interval(&_bc_module_climate.tmp112, interval);
     bc_sht20_set_update_interval(&_bc_module_climate.sht20, interval);
     bc_opt3001_set_update_interval(&_bc_module_climate.opt3001, interval);
     bc_mpl3115a2_set_update_interval(&_bc_module_climate.mpl3115a2, interval);
 }
 
+void bc_module_climate_set_update_interval_synchronized(bc_tick_t interval)
+{
+    bc_tmp112_set_update_interval(&_bc_module_climate.tmp112, BC_TICK_INFINITY);
+    bc_sht20_set_update_interval(&_bc_module_climate.sht20, BC_TICK_INFINITY);
+    bc_opt3001_set_update_interval(&_bc_module_climate.opt3001, BC_TICK_INFINITY);
+    bc_mpl3115a2_set_update_interval(&_bc_module_climate.mpl3115a2, BC_TICK_INFINITY);
+
+    _bc_module_climate.synchronized = true;
+    _bc_module_climate.update_interval = interval;
+
+    if (_bc_module_climate.update_interval == BC_TICK_INFINITY)
+    {
+        bc_scheduler_plan_absolute(_bc_module_climate.task_id_interval, BC_TICK_INFINITY);
+    }
+    else
+    {
+        bc_scheduler_plan_relative(_bc_module_climate.task_id_interval, _bc_module_climate.update_interval);
+
+        bc_module_climate_measure_all_sensors();
+    }
+}
+
 void bc_module_climate_set_update_interval_thermometer(bc_tick_t interval)
 {
     bc_tmp112_set_update_interval(&_bc_module_climate.tmp112, interval);
@@ -78,6 +124,14 @@ bool bc_module_climate_measure_all_sensors(void)
 {
     bool ret = true;
 
+    if (_bc_module_climate.pending != 0)
+    {
+        return false;
+    }
+
+    // Sensor which is already measuring is waited for as well
+    _bc_module_climate.pending = _BC_MODULE_CLIMATE_SENSOR_ALL;
+
     if (!bc_tmp112_measure(&_bc_module_climate.tmp112))
     {
         ret = false;
@@ -156,43 +210,92 @@ bool bc_module_climate_get_pressure_pascal(float *pascal)
     return bc_mpl3115a2_get_pressure_pascal(&_bc_module_climate.mpl3115a2, pascal);
 }
 
-static void _bc_module_climate_tmp112_event_handler(bc_tmp112_t *self, bc_tmp112_event_t event, void *event_param)
+bool bc_module_climate_get_snapshot(bc_module_climate_snapshot_t *snapshot)
 {
-    (void) self;
-    (void) event_param;
+    if (!_bc_module_climate.snapshot_valid)
+    {
+        return false;
+    }
+
+    *snapshot = _bc_module_climate.snapshot;
+
+    return true;
+}
+
+static void _bc_module_climate_task_interval(void *param)
+{
+    (void) param;
+
+    bc_module_climate_measure_all_sensors();
+
+    bc_scheduler_plan_current_relative(_bc_module_climate.update_interval);
+}
 
-    if (_bc_module_climate.event_handler == NULL)
+static void _bc_module_climate_event(int sensor, bc_module_climate_event_t event, bool error)
+{
+    if ((_bc_module_climate.event_handler != NULL) && (!_bc_module_climate.synchronized || error))
+    {
+        _bc_module_climate.event_handler(event, _bc_module_climate.event_param);
+    }
+
+    if ((_bc_module_climate.pending & sensor) == 0)
     {
         return;
     }
 
-    if (event == BC_TMP112_EVENT_UPDATE)
+    _bc_module_climate.pending &= ~sensor;
+
+    if (_bc_module_climate.pending != 0)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_UPDATE_THERMOMETER, _bc_module_climate.event_param);
+        return;
     }
-    else if (event == BC_TMP112_EVENT_ERROR)
+
+    // Values are copied at once, so they are not changed by measurement of individual sensor
+    bc_module_climate_snapshot_t *snapshot = &_bc_module_climate.snapshot;
+
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    snapshot->temperature_valid = bc_module_climate_get_temperature_celsius(&snapshot->temperature_celsius);
+    snapshot->humidity_valid = bc_module_climate_get_humidity_percentage(&snapshot->humidity_percentage);
+    snapshot->illuminance_valid = bc_module_climate_get_illuminance_lux(&snapshot->illuminance_lux);
+    snapshot->altitude_valid = bc_module_climate_get_altitude_meter(&snapshot->altitude_meter);
+    snapshot->pressure_valid = bc_module_climate_get_pressure_pascal(&snapshot->pressure_pascal);
+
+    _bc_module_climate.snapshot_valid = true;
+
+    if (_bc_module_climate.event_handler != NULL)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_ERROR_THERMOMETER, _bc_module_climate.event_param);
+        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_UPDATE_ALL_SENSORS, _bc_module_climate.event_param);
     }
 }
 
-static void _bc_module_climate_sht20_event_handler(bc_sht20_t *self, bc_sht20_event_t event, void *event_param)
+static void _bc_module_climate_tmp112_event_handler(bc_tmp112_t *self, bc_tmp112_event_t event, void *event_param)
 {
     (void) self;
     (void) event_param;
 
-    if (_bc_module_climate.event_handler == NULL)
+    if (event == BC_TMP112_EVENT_UPDATE)
     {
-        return;
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_THERMOMETER, BC_MODULE_CLIMATE_EVENT_UPDATE_THERMOMETER, false);
     }
+    else if (event == BC_TMP112_EVENT_ERROR)
+    {
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_THERMOMETER, BC_MODULE_CLIMATE_EVENT_ERROR_THERMOMETER, true);
+    }
+}
+
+static void _bc_module_climate_sht20_event_handler(bc_sht20_t *self, bc_sht20_event_t event, void *event_param)
+{
+    (void) self;
+    (void) event_param;
 
     if (event == BC_SHT20_EVENT_UPDATE)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_UPDATE_HYGROMETER, _bc_module_climate.event_param);
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_HYGROMETER, BC_MODULE_CLIMATE_EVENT_UPDATE_HYGROMETER, false);
     }
     else if (event == BC_SHT20_EVENT_ERROR)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_ERROR_HYGROMETER, _bc_module_climate.event_param);
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_HYGROMETER, BC_MODULE_CLIMATE_EVENT_ERROR_HYGROMETER, true);
     }
 }
 
@@ -201,18 +304,13 @@ static void _bc_module_climate_opt3001_event_handler(bc_opt3001_t *self, bc_opt3
     (void) self;
     (void) event_param;
 
-    if (_bc_module_climate.event_handler == NULL)
-    {
-        return;
-    }
-
     if (event == BC_OPT3001_EVENT_UPDATE)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_UPDATE_LUX_METER, _bc_module_climate.event_param);
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_LUX_METER, BC_MODULE_CLIMATE_EVENT_UPDATE_LUX_METER, false);
     }
     else if (event == BC_OPT3001_EVENT_ERROR)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_ERROR_LUX_METER, _bc_module_climate.event_param);
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_LUX_METER, BC_MODULE_CLIMATE_EVENT_ERROR_LUX_METER, true);
     }
 }
 
@@ -221,17 +319,12 @@ static void _bc_module_climate_mpl3115a2_event_handler(bc_mpl3115a2_t *self, bc_
     (void) self;
     (void) event_param;
 
-    if (_bc_module_climate.event_handler == NULL)
-    {
-        return;
-    }
-
     if (event == BC_MPL3115A2_EVENT_UPDATE)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_UPDATE_BAROMETER, _bc_module_climate.event_param);
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_BAROMETER, BC_MODULE_CLIMATE_EVENT_UPDATE_BAROMETER, false);
     }
     else if (event == BC_MPL3115A2_EVENT_ERROR)
     {
-        _bc_module_climate.event_handler(BC_MODULE_CLIMATE_EVENT_ERROR_BAROMETER, _bc_module_climate.event_param);
+        _bc_module_climate_event(_BC_MODULE_CLIMATE_SENSOR_BAROMETER, BC_MODULE_CLIMATE_EVENT_ERROR_BAROMETER, true);
     }
 }
@@ -2,7 +2,6 @@
 // https://www.embeddedartists.com/sites/default/files/support/datasheet/Memory_LCD_Programming.pdf
 // https://www.silabs.com/documents/public/application-notes/AN0048.pdf
 
-#include <stm32l0xx.h>
 #include <bc_module_lcd.h>
 #include <bc_spi.h>
 #include <bc_tca9534a.h>
@@ -97,12 +96,12 @@ void bc_module_lcd_init(bc_module_lcd_framebuffer_t *framebuffer)
 
 bool bc_module_lcd_on(void)
 {
-    return bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_DISP_ON_PIN, 1);
+    return bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_DISP_ON_PIN, 1);
 }
 
 bool bc_module_lcd_off(void)
 {
-    return bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_DISP_ON_PIN, 0);
+    return bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_DISP_ON_PIN, 0);
 }
 
 bool bc_module_lcd_is_ready(void)
@@ -395,7 +394,7 @@ bool bc_module_lcd_update(void)
             return false;
         }
 
-        if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_LED_DISP_CS_PIN, 0))
+        if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_LED_DISP_CS_PIN, 0))
         {
             _bc_module_lcd.is_tca9534a_initialized = false;
             return false;
@@ -405,7 +404,7 @@ bool bc_module_lcd_update(void)
 
         if (!bc_spi_async_transfer(_bc_module_lcd.framebuffer, NULL, BC_LCD_FRAMEBUFFER_SIZE, _bc_spi_event_handler, NULL))
         {
-            if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_LED_DISP_CS_PIN, 1))
+            if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_LED_DISP_CS_PIN, 1))
             {
                 _bc_module_lcd.is_tca9534a_initialized = false;
             }
@@ -503,7 +502,7 @@ static bool _bc_module_lcd_tca9534a_init(void)
 
 static bool _bc_module_lcd_spi_transfer(uint8_t *buffer, size_t length)
 {
-    if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_LED_DISP_CS_PIN, 0))
+    if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_LED_DISP_CS_PIN, 0))
     {
     	_bc_module_lcd.is_tca9534a_initialized = false;
     	return false;
@@ -511,7 +510,7 @@ static bool _bc_module_lcd_spi_transfer(uint8_t *buffer, size_t length)
 
     bool spi_state = bc_spi_transfer(buffer, NULL, length);
 
-    if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_LED_DISP_CS_PIN, 1))
+    if (!bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_LED_DISP_CS_PIN, 1))
     {
     	_bc_module_lcd.is_tca9534a_initialized = false;
     	return false;
@@ -540,7 +539,7 @@ static void _bc_spi_event_handler(bc_spi_event_t event, void *event_param)
 
     if (event == BC_SPI_EVENT_DONE)
     {
-        bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, _BC_MODULE_LCD_LED_DISP_CS_PIN, 1);
+        bc_tca9534a_write_pin(&_bc_module_lcd.tca9534a, (bc_tca9534a_pin_t) _BC_MODULE_LCD_LED_DISP_CS_PIN, 1);
     }
 }
 
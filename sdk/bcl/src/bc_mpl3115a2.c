@@ -8,6 +8,12 @@ static void _bc_mpl3115a2_task_interval(void *param);
 
 static void _bc_mpl3115a2_task_measure(void *param);
 
+static bool _bc_mpl3115a2_i2c_write(bc_mpl3115a2_t *self, uint32_t memory_address, uint8_t *buffer);
+
+static bool _bc_mpl3115a2_i2c_read(bc_mpl3115a2_t *self, uint32_t memory_address, uint8_t *buffer, size_t length);
+
+static void _bc_mpl3115a2_i2c_event_handler(bc_i2c_event_t event, void *event_param);
+
 void bc_mpl3115a2_init(bc_mpl3115a2_t *self, bc_i2c_channel_t i2c_channel, uint8_t i2c_address)
 {
     memset(self, 0, sizeof(*self));
@@ -100,6 +106,21 @@ static void _bc_mpl3115a2_task_measure(void *param)
 {
     bc_mpl3115a2_t *self = param;
 
+    // Transfers of previous state are not finished yet, their event handler plans task again
+    if (self->_i2c_pending != 0)
+    {
+        self->_i2c_wait = true;
+
+        return;
+    }
+
+    if (self->_i2c_error)
+    {
+        self->_i2c_error = false;
+
+        self->_state = BC_MPL3115A2_STATE_ERROR;
+    }
+
 start:
 
     switch (self->_state)
@@ -122,7 +143,17 @@ start:
         }
         case BC_MPL3115A2_STATE_INITIALIZE:
         {
-            bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x26, 0x04);
+            bc_i2c_memory_transfer_t transfer;
+
+            self->_i2c_buffer[0] = 0x04;
+
+            transfer.device_address = self->_i2c_address;
+            transfer.memory_address = 0x26;
+            transfer.buffer = self->_i2c_buffer;
+            transfer.length = 1;
+
+            // Result of software reset is not checked
+            bc_i2c_async_memory_write(self->_i2c_channel, &transfer, NULL, NULL);
 
             self->_state = BC_MPL3115A2_STATE_MEASURE_ALTITUDE;
 
@@ -139,17 +170,21 @@ start:
         {
             self->_state = BC_MPL3115A2_STATE_ERROR;
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x26, 0xb8))
+            self->_i2c_buffer[0] = 0xb8;
+            self->_i2c_buffer[1] = 0x07;
+            self->_i2c_buffer[2] = 0xba;
+
+            if (!_bc_mpl3115a2_i2c_write(self, 0x26, &self->_i2c_buffer[0]))
             {
                 goto start;
             }
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x13, 0x07))
+            if (!_bc_mpl3115a2_i2c_write(self, 0x13, &self->_i2c_buffer[1]))
             {
                 goto start;
             }
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x26, 0xba))
+            if (!_bc_mpl3115a2_i2c_write(self, 0x26, &self->_i2c_buffer[2]))
             {
                 goto start;
             }
@@ -164,59 +199,54 @@ start:
         {
             self->_state = BC_MPL3115A2_STATE_ERROR;
 
-            uint8_t reg_status;
-
-            if (!bc_i2c_memory_read_8b(self->_i2c_channel, self->_i2c_address, 0x00, &reg_status))
+            if (!_bc_mpl3115a2_i2c_read(self, 0x00, &self->_i2c_buffer[0], 1))
             {
                 goto start;
             }
 
-            if (reg_status != 0x0e)
+            if (!_bc_mpl3115a2_i2c_read(self, 0x01, &self->_i2c_buffer[1], 5))
             {
                 goto start;
             }
 
-            uint8_t buffer[5];
+            self->_state = BC_MPL3115A2_STATE_MEASURE_PRESSURE;
 
-            bc_i2c_memory_transfer_t transfer;
+            bc_scheduler_plan_current_now();
 
-            transfer.device_address = self->_i2c_address;
-            transfer.memory_address = 0x01;
-            transfer.buffer = buffer;
-            transfer.length = 5;
+            return;
+        }
+        case BC_MPL3115A2_STATE_MEASURE_PRESSURE:
+        {
+            self->_state = BC_MPL3115A2_STATE_ERROR;
 
-            if (!bc_i2c_memory_read(self->_i2c_channel, &transfer))
+            if (self->_i2c_buffer[0] != 0x0e)
             {
                 goto start;
             }
 
-            self->_reg_out_p_msb_altitude = buffer[0];
-            self->_reg_out_p_csb_altitude = buffer[1];
-            self->_reg_out_p_lsb_altitude = buffer[2];
-            self->_reg_out_t_msb_altitude = buffer[3];
-            self->_reg_out_t_lsb_altitude = buffer[4];
+            self->_reg_out_p_msb_altitude = self->_i2c_buffer[1];
+            self->_reg_out_p_csb_altitude = self->_i2c_buffer[2];
+            self->_reg_out_p_lsb_altitude = self->_i2c_buffer[3];
+            self->_reg_out_t_msb_altitude = self->_i2c_buffer[4];
+            self->_reg_out_t_lsb_altitude = self->_i2c_buffer[5];
 
             self->_altitude_valid = true;
 
-            self->_state = BC_MPL3115A2_STATE_MEASURE_PRESSURE;
-
-            goto start;
-        }
-        case BC_MPL3115A2_STATE_MEASURE_PRESSURE:
-        {
-            self->_state = BC_MPL3115A2_STATE_ERROR;
+            self->_i2c_buffer[0] = 0x38;
+            self->_i2c_buffer[1] = 0x07;
+            self->_i2c_buffer[2] = 0x3a;
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x26, 0x38))
+            if (!_bc_mpl3115a2_i2c_write(self, 0x26, &self->_i2c_buffer[0]))
             {
                 goto start;
             }
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x13, 0x07))
+            if (!_bc_mpl3115a2_i2c_write(self, 0x13, &self->_i2c_buffer[1]))
             {
                 goto start;
             }
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x26, 0x3a))
+            if (!_bc_mpl3115a2_i2c_write(self, 0x26, &self->_i2c_buffer[2]))
             {
                 goto start;
             }
@@ -231,46 +261,39 @@ start:
         {
             self->_state = BC_MPL3115A2_STATE_ERROR;
 
-            uint8_t reg_status;
-
-            if (!bc_i2c_memory_read_8b(self->_i2c_channel, self->_i2c_address, 0x00, &reg_status))
+            if (!_bc_mpl3115a2_i2c_read(self, 0x00, &self->_i2c_buffer[0], 1))
             {
                 goto start;
             }
 
-            if (reg_status != 0x0e)
+            if (!_bc_mpl3115a2_i2c_read(self, 0x01, &self->_i2c_buffer[1], 5))
             {
                 goto start;
             }
 
-            uint8_t buffer[5];
-
-            bc_i2c_memory_transfer_t transfer;
+            self->_state = BC_MPL3115A2_STATE_UPDATE;
 
-            transfer.device_address = self->_i2c_address;
-            transfer.memory_address = 0x01;
-            transfer.buffer = buffer;
-            transfer.length = 5;
+            bc_scheduler_plan_current_now();
 
-            if (!bc_i2c_memory_read(self->_i2c_channel, &transfer))
+            return;
+        }
+        case BC_MPL3115A2_STATE_UPDATE:
+        {
+            if (self->_i2c_buffer[0] != 0x0e)
             {
+                self->_state = BC_MPL3115A2_STATE_ERROR;
+
                 goto start;
             }
 
-            self->_reg_out_p_msb_pressure = buffer[0];
-            self->_reg_out_p_csb_pressure = buffer[1];
-            self->_reg_out_p_lsb_pressure = buffer[2];
-            self->_reg_out_t_msb_pressure = buffer[3];
-            self->_reg_out_t_lsb_pressure = buffer[4];
+            self->_reg_out_p_msb_pressure = self->_i2c_buffer[1];
+            self->_reg_out_p_csb_pressure = self->_i2c_buffer[2];
+            self->_reg_out_p_lsb_pressure = self->_i2c_buffer[3];
+            self->_reg_out_t_msb_pressure = self->_i2c_buffer[4];
+            self->_reg_out_t_lsb_pressure = self->_i2c_buffer[5];
 
             self->_pressure_valid = true;
 
-            self->_state = BC_MPL3115A2_STATE_UPDATE;
-
-            goto start;
-        }
-        case BC_MPL3115A2_STATE_UPDATE:
-        {
             self->_measurement_active = false;
 
             if (self->_event_handler != NULL)
@@ -290,3 +313,59 @@ start:
         }
     }
 }
+
+static bool _bc_mpl3115a2_i2c_write(bc_mpl3115a2_t *self, uint32_t memory_address, uint8_t *buffer)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = 1;
+
+    if (!bc_i2c_async_memory_write(self->_i2c_channel, &transfer, _bc_mpl3115a2_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static bool _bc_mpl3115a2_i2c_read(bc_mpl3115a2_t *self, uint32_t memory_address, uint8_t *buffer, size_t length)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = length;
+
+    if (!bc_i2c_async_memory_read(self->_i2c_channel, &transfer, _bc_mpl3115a2_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static void _bc_mpl3115a2_i2c_event_handler(bc_i2c_event_t event, void *event_param)
+{
+    bc_mpl3115a2_t *self = event_param;
+
+    if (event == BC_I2C_EVENT_ERROR)
+    {
+        self->_i2c_error = true;
+    }
+
+    // Failure is handled immediately, otherwise task continues at its planned time
+    if ((--self->_i2c_pending == 0) && (self->_i2c_wait || self->_i2c_error))
+    {
+        self->_i2c_wait = false;
+
+        bc_scheduler_plan_now(self->_task_id_measure);
+    }
+}
@@ -8,6 +8,12 @@ static void _bc_opt3001_task_interval(void *param);
 
 static void _bc_opt3001_task_measure(void *param);
 
+static bool _bc_opt3001_i2c_write(bc_opt3001_t *self, uint32_t memory_address, uint16_t data);
+
+static bool _bc_opt3001_i2c_read(bc_opt3001_t *self, uint32_t memory_address, uint8_t *buffer);
+
+static void _bc_opt3001_i2c_event_handler(bc_i2c_event_t event, void *event_param);
+
 void bc_opt3001_init(bc_opt3001_t *self, bc_i2c_channel_t i2c_channel, uint8_t i2c_address)
 {
     memset(self, 0, sizeof(*self));
@@ -98,6 +104,21 @@ static void _bc_opt3001_task_measure(void *param)
 {
     bc_opt3001_t *self = param;
 
+    // Transfers of previous state are not finished yet, their event handler plans task again
+    if (self->_i2c_pending != 0)
+    {
+        self->_i2c_wait = true;
+
+        return;
+    }
+
+    if (self->_i2c_error)
+    {
+        self->_i2c_error = false;
+
+        self->_state = BC_OPT3001_STATE_ERROR;
+    }
+
 start:
 
     switch (self->_state)
@@ -121,7 +142,7 @@ start:
         {
             self->_state = BC_OPT3001_STATE_ERROR;
 
-            if (!bc_i2c_memory_write_16b(self->_i2c_channel, self->_i2c_address, 0x01, 0xc810))
+            if (!_bc_opt3001_i2c_write(self, 0x01, 0xc810))
             {
                 goto start;
             }
@@ -141,7 +162,7 @@ start:
         {
             self->_state = BC_OPT3001_STATE_ERROR;
 
-            if (!bc_i2c_memory_write_16b(self->_i2c_channel, self->_i2c_address, 0x01, 0xca10))
+            if (!_bc_opt3001_i2c_write(self, 0x01, 0xca10))
             {
                 goto start;
             }
@@ -156,31 +177,37 @@ start:
         {
             self->_state = BC_OPT3001_STATE_ERROR;
 
-            uint16_t reg_configuration;
-
-            if (!bc_i2c_memory_read_16b(self->_i2c_channel, self->_i2c_address, 0x01, &reg_configuration))
+            if (!_bc_opt3001_i2c_read(self, 0x01, &self->_i2c_buffer[0]))
             {
                 goto start;
             }
 
-            if ((reg_configuration & 0x0680) != 0x0080)
+            if (!_bc_opt3001_i2c_read(self, 0x00, &self->_i2c_buffer[2]))
             {
                 goto start;
             }
 
-            if (!bc_i2c_memory_read_16b(self->_i2c_channel, self->_i2c_address, 0x00, &self->_reg_result))
+            self->_state = BC_OPT3001_STATE_UPDATE;
+
+            bc_scheduler_plan_current_now();
+
+            return;
+        }
+        case BC_OPT3001_STATE_UPDATE:
+        {
+            uint16_t reg_configuration = self->_i2c_buffer[0] << 8 | self->_i2c_buffer[1];
+
+            if ((reg_configuration & 0x0680) != 0x0080)
             {
+                self->_state = BC_OPT3001_STATE_ERROR;
+
                 goto start;
             }
 
-            self->_illuminance_valid = true;
+            self->_reg_result = self->_i2c_buffer[2] << 8 | self->_i2c_buffer[3];
 
-            self->_state = BC_OPT3001_STATE_UPDATE;
+            self->_illuminance_valid = true;
 
-            goto start;
-        }
-        case BC_OPT3001_STATE_UPDATE:
-        {
             self->_measurement_active = false;
 
             if (self->_event_handler != NULL)
@@ -200,3 +227,62 @@ start:
         }
     }
 }
+
+static bool _bc_opt3001_i2c_write(bc_opt3001_t *self, uint32_t memory_address, uint16_t data)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    self->_i2c_buffer[0] = data >> 8;
+    self->_i2c_buffer[1] = data;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = self->_i2c_buffer;
+    transfer.length = 2;
+
+    if (!bc_i2c_async_memory_write(self->_i2c_channel, &transfer, _bc_opt3001_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static bool _bc_opt3001_i2c_read(bc_opt3001_t *self, uint32_t memory_address, uint8_t *buffer)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = 2;
+
+    if (!bc_i2c_async_memory_read(self->_i2c_channel, &transfer, _bc_opt3001_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static void _bc_opt3001_i2c_event_handler(bc_i2c_event_t event, void *event_param)
+{
+    bc_opt3001_t *self = event_param;
+
+    if (event == BC_I2C_EVENT_ERROR)
+    {
+        self->_i2c_error = true;
+    }
+
+    // Failure is handled immediately, otherwise task continues at its planned time
+    if ((--self->_i2c_pending == 0) && (self->_i2c_wait || self->_i2c_error))
+    {
+        self->_i2c_wait = false;
+
+        bc_scheduler_plan_now(self->_task_id_measure);
+    }
+}
@@ -1,5 +1,11 @@
 #include <bc_queue.h>
 
+// Maximum length of item (it has to fit to one byte header)
+#define _BC_QUEUE_ITEM_MAX_LENGTH 255
+
+// Header of zero length marks unused space at the end of buffer
+#define _BC_QUEUE_WRAP_MARK 0
+
 void bc_queue_init(bc_queue_t *queue, void *buffer, size_t size)
 {
     memset(queue, 0, sizeof(*queue));
@@ -15,20 +21,42 @@ bool bc_queue_put(bc_queue_t *queue, const void *buffer, size_t length)
         return true;
     }
 
-    if (sizeof(length) + length > queue->_size - queue->_length)
+    if (length > _BC_QUEUE_ITEM_MAX_LENGTH)
     {
         return false;
     }
 
     uint8_t *p = queue->_buffer;
 
-    p += queue->_length;
+    size_t space = 1 + length;
+
+    // If free space is between head and tail...
+    if ((queue->_length != 0) && (queue->_head <= queue->_tail))
+    {
+        if (space > queue->_tail - queue->_head)
+        {
+            return false;
+        }
+    }
+    // ...otherwise free space is after head and before tail
+    else if (space > queue->_size - queue->_head)
+    {
+        if (space > queue->_tail)
+        {
+            return false;
+        }
+
+        // Item is always stored in one piece, skip rest of buffer
+        p[queue->_head] = _BC_QUEUE_WRAP_MARK;
+
+        queue->_length += queue->_size - queue->_head;
 
-    memcpy(p, &length, sizeof(length));
+        queue->_head = 0;
+    }
 
-    p += sizeof(length);
+    p += queue->_head;
 
-    queue->_length += sizeof(length) + length;
+    *p++ = length;
 
     if (buffer != NULL)
     {
@@ -39,10 +67,38 @@ bool bc_queue_put(bc_queue_t *queue, const void *buffer, size_t length)
         memset(p, 0, length);
     }
 
+    queue->_length += space;
+
+    queue->_head += space;
+
+    if (queue->_head == queue->_size)
+    {
+        queue->_head = 0;
+    }
+
     return true;
 }
 
 bool bc_queue_get(bc_queue_t *queue, void *buffer, size_t *length)
+{
+    const void *item;
+
+    if (!bc_queue_peek(queue, &item, length))
+    {
+        return false;
+    }
+
+    if (buffer != NULL)
+    {
+        memcpy(buffer, item, *length);
+    }
+
+    bc_queue_remove(queue);
+
+    return true;
+}
+
+bool bc_queue_peek(bc_queue_t *queue, const void **buffer, size_t *length)
 {
     if (queue->_length == 0)
     {
@@ -51,18 +107,48 @@ bool bc_queue_get(bc_queue_t *queue, void *buffer, size_t *length)
 
     uint8_t *p = queue->_buffer;
 
-    memcpy(length, p, sizeof(*length));
+    if (p[queue->_tail] == _BC_QUEUE_WRAP_MARK)
+    {
+        queue->_length -= queue->_size - queue->_tail;
+
+        queue->_tail = 0;
+    }
 
-    p += sizeof(*length);
+    *length = p[queue->_tail];
 
-    queue->_length -= sizeof(*length) + *length;
+    *buffer = p + queue->_tail + 1;
 
-    if (buffer != NULL)
+    return true;
+}
+
+void bc_queue_remove(bc_queue_t *queue)
+{
+    const void *item;
+    size_t length;
+
+    if (!bc_queue_peek(queue, &item, &length))
     {
-        memcpy(buffer, p, *length);
+        return;
     }
 
-    memmove(queue->_buffer, p + *length, queue->_length);
+    queue->_length -= 1 + length;
 
-    return true;
+    queue->_tail += 1 + length;
+
+    if (queue->_tail == queue->_size)
+    {
+        queue->_tail = 0;
+    }
+
+    // Start from beginning of buffer when queue is empty to avoid wrapping
+    if (queue->_length == 0)
+    {
+        queue->_head = 0;
+        queue->_tail = 0;
+    }
+}
+
+size_t bc_queue_get_length(bc_queue_t *queue)
+{
+    return queue->_length;
 }
@@ -13,6 +13,53 @@
 #define _BC_RADIO_SLEEP_RX_TIMEOUT  100
 #define _BC_RADIO_TX_MAX_COUNT      6
 
+// Adaptive retry policy keeps ACK timeout in these bounds
+#define _BC_RADIO_ACK_TIMEOUT_MIN   20
+#define _BC_RADIO_ACK_TIMEOUT_MAX   (2 * _BC_RADIO_ACK_TIMEOUT)
+
+// Back-off window doubles with every retransmission up to maximum
+#define _BC_RADIO_BACKOFF_BASE      128
+#define _BC_RADIO_BACKOFF_MAX       512
+
+// Retry budget is counted in quarters of retransmission, every message earns two retransmissions
+#define _BC_RADIO_RETRY_BUDGET_COST     4
+#define _BC_RADIO_RETRY_BUDGET_DEPOSIT  8
+#define _BC_RADIO_RETRY_BUDGET_MAX      (10 * _BC_RADIO_RETRY_BUDGET_COST)
+
+// Node moves to the next channel of channel set after this many messages in row have not been acknowledged
+#define _BC_RADIO_CHANNEL_MAX_FAILURES  2
+
+// Status byte which follows header of ACK when message has been received but refused (receiver cannot decode it)
+#define _BC_RADIO_ACK_REFUSED       0x01
+
+// Received frames are decoded in place, one of RX buffers is always given to Spirit1 for the next frame
+#define _BC_RADIO_RX_POOL_SIZE      5
+
+// Peer devices are stored behind the last 8 bytes of EEPROM, length of table is in the last byte
+#define _BC_RADIO_PEER_EEPROM_OFFSET    8
+
+// Hash table of peer devices has at least twice as many slots as devices
+#if BC_RADIO_MAX_DEVICES <= 4
+#define _BC_RADIO_PEER_HASH_BITS    3
+#elif BC_RADIO_MAX_DEVICES <= 8
+#define _BC_RADIO_PEER_HASH_BITS    4
+#elif BC_RADIO_MAX_DEVICES <= 16
+#define _BC_RADIO_PEER_HASH_BITS    5
+#elif BC_RADIO_MAX_DEVICES <= 32
+#define _BC_RADIO_PEER_HASH_BITS    6
+#elif BC_RADIO_MAX_DEVICES <= 64
+#define _BC_RADIO_PEER_HASH_BITS    7
+#elif BC_RADIO_MAX_DEVICES <= 128
+#define _BC_RADIO_PEER_HASH_BITS    8
+#elif BC_RADIO_MAX_DEVICES <= 255
+#define _BC_RADIO_PEER_HASH_BITS    9
+#else
+#error "BC_RADIO_MAX_DEVICES must not be greater than 255"
+#endif
+
+#define _BC_RADIO_PEER_HASH_SIZE    (1 << _BC_RADIO_PEER_HASH_BITS)
+#define _BC_RADIO_PEER_HASH_MASK    (_BC_RADIO_PEER_HASH_SIZE - 1)
+
 typedef enum
 {
     BC_RADIO_STATE_SLEEP = 0,
@@ -24,22 +71,42 @@ typedef enum
 
 } bc_radio_state_t;
 
+typedef struct
+{
+    bc_radio_link_stats_t stats;
+
+    // Smoothed round-trip time and its variation scaled by 8 and 4
+    uint16_t srtt;
+    uint16_t rttvar;
+
+    uint8_t retry_budget;
+
+} bc_radio_link_t;
+
 typedef struct
 {
     uint64_t id;
+
+    // The last accepted message ID
     uint16_t message_id;
     bool message_id_synced;
 
+    bc_radio_link_t link;
+
 } bc_radio_peer_t;
 
 static struct
 {
     bc_radio_mode_t mode;
+    bc_radio_retry_policy_t retry_policy;
     bc_atsha204_t atsha204;
     bc_radio_state_t state;
     uint64_t my_id;
     uint16_t message_id;
     int transmit_count;
+    int transmit_attempt;
+    bc_tick_t transmit_tick_done;
+    bool transmit_rtt_valid;
     void (*event_handler)(bc_radio_event_t, void *);
     void *event_param;
     bc_scheduler_task_id_t task_id;
@@ -49,9 +116,18 @@ static struct
     bool pairing_mode;
 
     bc_queue_t pub_queue;
-    bc_queue_t rx_queue;
     uint8_t pub_queue_buffer[128];
-    uint8_t rx_queue_buffer[128];
+
+    // Ring of RX buffers, frames waiting for decoding are followed by buffer of Spirit1
+    struct
+    {
+        uint8_t buffer[BC_SPIRIT1_MAX_PACKET_SIZE];
+        size_t length;
+
+    } rx_pool[_BC_RADIO_RX_POOL_SIZE];
+
+    int rx_pool_head;
+    int rx_pool_length;
 
     uint8_t ack_tx_cache_buffer[15];
     size_t ack_tx_cache_length;
@@ -61,6 +137,19 @@ static struct
     bc_radio_peer_t peer_devices[BC_RADIO_MAX_DEVICES];
     int peer_devices_lenght;
 
+    // Open addressing table with index of peer device increased by one (zero is empty slot)
+    uint8_t peer_devices_hash[_BC_RADIO_PEER_HASH_SIZE];
+
+    // Link of messages which are not addressed to single peer device
+    bc_radio_link_t link;
+
+    bc_radio_stats_t stats;
+    bc_radio_state_t airtime_state;
+    bc_tick_t airtime_tick;
+    bc_scheduler_task_id_t stats_task_id;
+    bool stats_task_registered;
+    bc_tick_t stats_interval;
+
     uint64_t peer_id;
 
     bool listening;
@@ -71,6 +160,11 @@ static struct
 
     bool automatic_pairing;
     bool save_peer_devices;
+    int save_peer_devices_from;
+
+    bool lbt;
+    uint8_t channel_set;
+    int channel_failures;
 
 } _bc_radio;
 
@@ -82,29 +176,60 @@ static void _bc_radio_save_peer_devices(void);
 static void _bc_radio_atsha204_event_handler(bc_atsha204_t *self, bc_atsha204_event_t event, void *event_param);
 static bool _bc_radio_peer_device_add(uint64_t id);
 static bool _bc_radio_peer_device_remove(uint64_t id);
+static int _bc_radio_peer_device_find(uint64_t id);
+static void _bc_radio_peer_device_hash_insert(int index);
+static void _bc_radio_peer_device_hash_remove(uint64_t id);
+static void _bc_radio_peer_devices_changed(int index);
+static void _bc_radio_link_init(bc_radio_link_t *link);
+static bool _bc_radio_message_id_is_duplicate(bc_radio_peer_t *peer, uint16_t message_id);
+static void _bc_radio_message_id_accept(bc_radio_peer_t *peer, uint16_t message_id);
+static bc_radio_link_t *_bc_radio_tx_link(void);
+static bc_tick_t _bc_radio_ack_timeout(void);
+static void _bc_radio_tx_done(void);
+static void _bc_radio_tx_acknowledged(void);
+static bool _bc_radio_tx_timeout(void);
+static void _bc_radio_spirit1_tx(void);
+static void _bc_radio_spirit1_rx(void);
+static void _bc_radio_spirit1_sleep(void);
+static void _bc_radio_airtime_update(bc_radio_state_t state);
+static void _bc_radio_channel_select(void);
+static void _bc_radio_channel_failure(void);
+static bool _bc_radio_rx_pool_put(size_t length);
+static void _bc_radio_rx_pool_remove(void);
+static void _bc_radio_queue_high_water_update(void);
+static void _bc_radio_stats_task(void *param);
 
 __attribute__((weak)) void bc_radio_on_info(uint64_t *id, char *firmware, char *version) { (void) id; (void) firmware; (void) version; }
 
 void bc_radio_init(bc_radio_mode_t mode)
+{
+    bc_radio_init_retry_policy(mode, BC_RADIO_RETRY_POLICY_FIXED);
+}
+
+void bc_radio_init_retry_policy(bc_radio_mode_t mode, bc_radio_retry_policy_t retry_policy)
 {
     memset(&_bc_radio, 0, sizeof(_bc_radio));
 
     _bc_radio.mode = mode;
 
+    _bc_radio.retry_policy = retry_policy;
+
+    _bc_radio_link_init(&_bc_radio.link);
+
     bc_atsha204_init(&_bc_radio.atsha204, BC_I2C_I2C0, 0x64);
     bc_atsha204_set_event_handler(&_bc_radio.atsha204, _bc_radio_atsha204_event_handler, NULL);
     bc_atsha204_read_serial_number(&_bc_radio.atsha204);
 
     bc_queue_init(&_bc_radio.pub_queue, _bc_radio.pub_queue_buffer, sizeof(_bc_radio.pub_queue_buffer));
-    bc_queue_init(&_bc_radio.rx_queue, _bc_radio.rx_queue_buffer, sizeof(_bc_radio.rx_queue_buffer));
 
     bc_spirit1_init();
+    bc_spirit1_set_rx_buffer(_bc_radio.rx_pool[0].buffer);
     bc_spirit1_set_event_handler(_bc_radio_spirit1_event_handler, NULL);
 
-    _bc_radio_load_peer_devices();
-
     _bc_radio.task_id = bc_scheduler_register(_bc_radio_task, NULL, BC_TICK_INFINITY);
 
+    _bc_radio_load_peer_devices();
+
     if ((_bc_radio.mode == BC_RADIO_MODE_GATEWAY) || (_bc_radio.mode == BC_RADIO_MODE_NODE_LISTENING))
     {
         _bc_radio.listening = true;
@@ -173,9 +298,7 @@ bool bc_radio_peer_device_add(uint64_t id)
 
     bc_radio_id_to_buffer(&id, buffer + 1);
 
-    bc_queue_put(&_bc_radio.pub_queue, buffer, sizeof(buffer));
-
-    bc_scheduler_plan_now(_bc_radio.task_id);
+    bc_radio_pub_queue_put(buffer, sizeof(buffer));
 
     return true;
 }
@@ -193,9 +316,7 @@ bool bc_radio_peer_device_remove(uint64_t id)
 
     bc_radio_id_to_buffer(&id, buffer + 1);
 
-    bc_queue_put(&_bc_radio.pub_queue, buffer, sizeof(buffer));
-
-    bc_scheduler_plan_now(_bc_radio.task_id);
+    bc_radio_pub_queue_put(buffer, sizeof(buffer));
 
     return true;
 }
@@ -263,28 +384,95 @@ uint64_t bc_radio_get_event_id(void)
 
 bool bc_radio_is_peer_device(uint64_t id)
 {
-    for (int i = 0; i < _bc_radio.peer_devices_lenght; i++)
-    {
-        if (id == _bc_radio.peer_devices[i].id)
-        {
-            return true;
-        }
-    }
-    return false;
+    return _bc_radio_peer_device_find(id) >= 0;
+}
+
+void bc_radio_set_lbt(bool enable)
+{
+    _bc_radio.lbt = enable;
+}
+
+void bc_radio_set_channel(uint8_t channel)
+{
+    _bc_radio.channel_set = 0;
+
+    bc_spirit1_set_channel(channel);
+}
+
+void bc_radio_set_channel_set(uint8_t channel_set)
+{
+    _bc_radio.channel_set = channel_set & ((1 << BC_SPIRIT1_CHANNEL_COUNT) - 1);
+
+    _bc_radio.channel_failures = 0;
+
+    _bc_radio_channel_select();
 }
 
 bool bc_radio_pub_queue_put(const void *buffer, size_t length)
 {
     if (!bc_queue_put(&_bc_radio.pub_queue, buffer, length))
     {
+        _bc_radio.stats.pub_queue_full++;
+
         return false;
     }
 
+    _bc_radio_queue_high_water_update();
+
     bc_scheduler_plan_now(_bc_radio.task_id);
 
     return true;
 }
 
+bool bc_radio_get_link_stats(uint64_t id, bc_radio_link_stats_t *stats)
+{
+    if (id == 0)
+    {
+        *stats = _bc_radio.link.stats;
+
+        return true;
+    }
+
+    int i = _bc_radio_peer_device_find(id);
+
+    if (i < 0)
+    {
+        return false;
+    }
+
+    *stats = _bc_radio.peer_devices[i].link.stats;
+
+    return true;
+}
+
+void bc_radio_get_stats(bc_radio_stats_t *stats)
+{
+    // Time of current state is included
+    _bc_radio_airtime_update(_bc_radio.airtime_state);
+
+    *stats = _bc_radio.stats;
+}
+
+void bc_radio_set_stats_interval(bc_tick_t interval)
+{
+    _bc_radio.stats_interval = interval;
+
+    // Task is registered only if statistics are published
+    if (!_bc_radio.stats_task_registered)
+    {
+        if (interval == 0)
+        {
+            return;
+        }
+
+        _bc_radio.stats_task_id = bc_scheduler_register(_bc_radio_stats_task, NULL, BC_TICK_INFINITY);
+
+        _bc_radio.stats_task_registered = true;
+    }
+
+    bc_scheduler_plan_absolute(_bc_radio.stats_task_id, interval == 0 ? BC_TICK_INFINITY : bc_tick_get() + interval);
+}
+
 static void _bc_radio_task(void *param)
 {
     (void) param;
@@ -340,38 +528,44 @@ static void _bc_radio_task(void *param)
 
         bc_spirit1_set_tx_length(10 + len + 2);
 
-        bc_spirit1_tx();
+        _bc_radio_spirit1_tx();
 
         _bc_radio.transmit_count = _BC_RADIO_TX_MAX_COUNT;
 
+        _bc_radio.transmit_attempt = 0;
+
         _bc_radio.state = BC_RADIO_STATE_TX;
 
         return;
     }
 
-    uint8_t queue_item_buffer[sizeof(_bc_radio.pub_queue_buffer)];
-    size_t queue_item_length;
     uint64_t id;
 
-    while (bc_queue_get(&_bc_radio.rx_queue, queue_item_buffer, &queue_item_length))
+    while (_bc_radio.rx_pool_length != 0)
     {
-        bc_radio_id_from_buffer(queue_item_buffer, &id);
+        uint8_t *rx_buffer = _bc_radio.rx_pool[_bc_radio.rx_pool_head].buffer;
+        size_t rx_length = _bc_radio.rx_pool[_bc_radio.rx_pool_head].length - BC_RADIO_HEAD_SIZE;
 
-        queue_item_length -= BC_RADIO_HEAD_SIZE;
+        bc_radio_id_from_buffer(rx_buffer, &id);
 
-        bc_radio_pub_decode(&id, queue_item_buffer + BC_RADIO_HEAD_SIZE, queue_item_length);
+        bc_radio_pub_decode(&id, rx_buffer + BC_RADIO_HEAD_SIZE, rx_length);
 
-        bc_radio_node_decode(&id, queue_item_buffer + BC_RADIO_HEAD_SIZE, queue_item_length);
+        bc_radio_node_decode(&id, rx_buffer + BC_RADIO_HEAD_SIZE, rx_length);
 
-        if (queue_item_buffer[BC_RADIO_HEAD_SIZE] == BC_RADIO_HEADER_PUB_INFO)
+        if (rx_buffer[BC_RADIO_HEAD_SIZE] == BC_RADIO_HEADER_PUB_INFO)
         {
-            queue_item_buffer[queue_item_length + BC_RADIO_HEAD_SIZE - 1] = 0;
+            rx_buffer[rx_length + BC_RADIO_HEAD_SIZE - 1] = 0;
 
-            bc_radio_on_info(&id, (char *) queue_item_buffer + BC_RADIO_HEAD_SIZE + 1, "");
+            bc_radio_on_info(&id, (char *) rx_buffer + BC_RADIO_HEAD_SIZE + 1, "");
         }
+
+        _bc_radio_rx_pool_remove();
     }
 
-    if (bc_queue_get(&_bc_radio.pub_queue, queue_item_buffer, &queue_item_length))
+    const void *queue_item;
+    size_t queue_item_length;
+
+    if (bc_queue_peek(&_bc_radio.pub_queue, &queue_item, &queue_item_length))
     {
         uint8_t *buffer = bc_spirit1_get_tx_buffer();
 
@@ -382,14 +576,18 @@ static void _bc_radio_task(void *param)
         buffer[6] = _bc_radio.message_id;
         buffer[7] = _bc_radio.message_id >> 8;
 
-        memcpy(buffer + 8, queue_item_buffer, queue_item_length);
+        memcpy(buffer + 8, queue_item, queue_item_length);
+
+        bc_queue_remove(&_bc_radio.pub_queue);
 
         bc_spirit1_set_tx_length(8 + queue_item_length);
 
-        bc_spirit1_tx();
+        _bc_radio_spirit1_tx();
 
         _bc_radio.transmit_count = _BC_RADIO_TX_MAX_COUNT;
 
+        _bc_radio.transmit_attempt = 0;
+
         _bc_radio.state = BC_RADIO_STATE_TX;
     }
 }
@@ -419,7 +617,7 @@ static bool _bc_radio_scan_cache_push(void)
     return true;
 }
 
-static void _bc_radio_send_ack(void)
+static void _bc_radio_send_ack(const uint8_t *rx_buffer)
 {
     uint8_t *tx_buffer = bc_spirit1_get_tx_buffer();
 
@@ -427,6 +625,9 @@ static void _bc_radio_send_ack(void)
     {
         _bc_radio.ack_transmit_count = _bc_radio.transmit_count;
 
+        // ACK sent in between would be part of measured round-trip time
+        _bc_radio.transmit_rtt_valid = false;
+
         _bc_radio.ack_tx_cache_length = bc_spirit1_get_tx_length();
 
         memcpy(_bc_radio.ack_tx_cache_buffer, tx_buffer, sizeof(_bc_radio.ack_tx_cache_buffer));
@@ -442,8 +643,6 @@ static void _bc_radio_send_ack(void)
         return;
     }
 
-    uint8_t *rx_buffer = bc_spirit1_get_rx_buffer();
-
     memcpy(tx_buffer, rx_buffer, 8);
 
     tx_buffer[8] = BC_RADIO_HEADER_ACK;
@@ -452,7 +651,21 @@ static void _bc_radio_send_ack(void)
 
     _bc_radio.transmit_count = 2;
 
-    bc_spirit1_tx();
+    _bc_radio_spirit1_tx();
+}
+
+static void _bc_radio_send_refusal(const uint8_t *rx_buffer)
+{
+    _bc_radio_send_ack(rx_buffer);
+
+    if ((_bc_radio.state == BC_RADIO_STATE_RX_SEND_ACK) || (_bc_radio.state == BC_RADIO_STATE_TX_SEND_ACK))
+    {
+        uint8_t *tx_buffer = bc_spirit1_get_tx_buffer();
+
+        tx_buffer[9] = _BC_RADIO_ACK_REFUSED;
+
+        bc_spirit1_set_tx_length(10);
+    }
 }
 
 static void _bc_radio_go_to_state_rx_or_sleep(void)
@@ -461,13 +674,13 @@ static void _bc_radio_go_to_state_rx_or_sleep(void)
     {
         bc_spirit1_set_rx_timeout(BC_TICK_INFINITY);
 
-        bc_spirit1_rx();
+        _bc_radio_spirit1_rx();
 
         _bc_radio.state = BC_RADIO_STATE_RX;
     }
     else
     {
-        bc_spirit1_sleep();
+        _bc_radio_spirit1_sleep();
 
         _bc_radio.state = BC_RADIO_STATE_SLEEP;
     }
@@ -489,13 +702,15 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
 
         if (_bc_radio.state == BC_RADIO_STATE_TX)
         {
-            bc_tick_t timeout = _BC_RADIO_ACK_TIMEOUT - 50 + rand() % _BC_RADIO_ACK_TIMEOUT;
+            _bc_radio_tx_done();
+
+            bc_tick_t timeout = _bc_radio_ack_timeout();
 
             _bc_radio.ack_rx_timeout = bc_tick_get() + timeout;
 
             bc_spirit1_set_rx_timeout(timeout);
 
-            bc_spirit1_rx();
+            _bc_radio_spirit1_rx();
 
             _bc_radio.state = BC_RADIO_STATE_TX_WAIT_ACK;
 
@@ -506,7 +721,7 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
         {
             if (_bc_radio.transmit_count > 0)
             {
-                bc_spirit1_tx();
+                _bc_radio_spirit1_tx();
 
                 return;
             }
@@ -516,7 +731,7 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
         {
             if (_bc_radio.transmit_count > 0)
             {
-                bc_spirit1_tx();
+                _bc_radio_spirit1_tx();
 
                 return;
             }
@@ -526,17 +741,17 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
 
                 memcpy(tx_buffer, _bc_radio.ack_tx_cache_buffer, sizeof(_bc_radio.ack_tx_cache_buffer));
 
-                bc_tick_t timeout = _BC_RADIO_ACK_TIMEOUT - 50 + rand() % _BC_RADIO_ACK_TIMEOUT;
+                _bc_radio.transmit_count = _bc_radio.ack_transmit_count;
 
-                _bc_radio.ack_rx_timeout = bc_tick_get() + timeout;
+                bc_tick_t timeout = _bc_radio_ack_timeout();
 
-                _bc_radio.transmit_count = _bc_radio.ack_transmit_count;
+                _bc_radio.ack_rx_timeout = bc_tick_get() + timeout;
 
                 bc_spirit1_set_rx_timeout(timeout);
 
                 bc_spirit1_set_tx_length(_bc_radio.ack_tx_cache_length);
 
-                bc_spirit1_rx();
+                _bc_radio_spirit1_rx();
 
                 _bc_radio.state = BC_RADIO_STATE_TX_WAIT_ACK;
 
@@ -550,14 +765,18 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
     {
         if (_bc_radio.state == BC_RADIO_STATE_TX_WAIT_ACK)
         {
-            if (_bc_radio.transmit_count > 0)
+            if (_bc_radio_tx_timeout())
             {
-                bc_spirit1_tx();
+                _bc_radio_spirit1_tx();
 
                 _bc_radio.state = BC_RADIO_STATE_TX;
 
                 return;
             }
+
+            bc_radio_pub_delivery((uint8_t *) bc_spirit1_get_tx_buffer() + BC_RADIO_HEAD_SIZE, bc_spirit1_get_tx_length() - BC_RADIO_HEAD_SIZE, false);
+
+            _bc_radio_channel_failure();
         }
 
         _bc_radio_go_to_state_rx_or_sleep();
@@ -567,11 +786,13 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
         size_t length = bc_spirit1_get_rx_length();
         uint16_t message_id;
 
+        _bc_radio.stats.rx_frames++;
+
         if ((_bc_radio.state == BC_RADIO_STATE_TX_WAIT_ACK) && (bc_tick_get() >= _bc_radio.ack_rx_timeout))
         {
-            if (_bc_radio.transmit_count > 0)
+            if (_bc_radio_tx_timeout())
             {
-                bc_spirit1_tx();
+                _bc_radio_spirit1_tx();
 
                 _bc_radio.state = BC_RADIO_STATE_TX;
 
@@ -579,6 +800,10 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
             }
             else
             {
+                bc_radio_pub_delivery((uint8_t *) bc_spirit1_get_tx_buffer() + BC_RADIO_HEAD_SIZE, bc_spirit1_get_tx_length() - BC_RADIO_HEAD_SIZE, false);
+
+                _bc_radio_channel_failure();
+
                 _bc_radio_go_to_state_rx_or_sleep();
             }
         }
@@ -601,8 +826,22 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
 
                     if ((_bc_radio.peer_id == _bc_radio.my_id) && (_bc_radio.message_id == message_id) )
                     {
+                        _bc_radio_tx_acknowledged();
+
                         _bc_radio.transmit_count = 0;
 
+                        _bc_radio.channel_failures = 0;
+
+                        // Refused message is not retransmitted, sender has to change it (e.g. to telemetry keyframe)
+                        if ((length == 10) && (buffer[9] == _BC_RADIO_ACK_REFUSED))
+                        {
+                            bc_radio_pub_refusal(tx_buffer + BC_RADIO_HEAD_SIZE, bc_spirit1_get_tx_length() - BC_RADIO_HEAD_SIZE);
+                        }
+                        else
+                        {
+                            bc_radio_pub_delivery(tx_buffer + BC_RADIO_HEAD_SIZE, bc_spirit1_get_tx_length() - BC_RADIO_HEAD_SIZE, true);
+                        }
+
                         _bc_radio_go_to_state_rx_or_sleep();
 
                         if ((length == 15) && (tx_buffer[8] == BC_RADIO_HEADER_PAIRING))
@@ -633,9 +872,14 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
                     }
                 }
 
-                if (bc_radio_is_peer_device(_bc_radio.peer_id))
+                int i = _bc_radio_peer_device_find(_bc_radio.peer_id);
+
+                if (i >= 0)
                 {
-                    _bc_radio_send_ack();
+                    // Node sends pairing request after restart when its message ID starts again
+                    _bc_radio.peer_devices[i].message_id_synced = false;
+
+                    _bc_radio_send_ack(buffer);
 
                     uint8_t *tx_buffer = bc_spirit1_get_tx_buffer();
 
@@ -666,7 +910,8 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
 
                 if (id == _bc_radio.my_id)
                 {
-                    if (buffer[8] == BC_RADIO_HEADER_NODE_ATTACH)
+                    // Pairing request carries firmware given by bc_radio_pairing_request
+                    if ((buffer[8] == BC_RADIO_HEADER_NODE_ATTACH) && (_bc_radio.firmware != NULL))
                     {
                         _bc_radio.pairing_request_to_gateway = true;
 
@@ -683,54 +928,71 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
                     }
                 }
 
-                _bc_radio_send_ack();
+                _bc_radio_send_ack(buffer);
 
                 return;
             }
 
-            int i;
-            for (i = 0; i < _bc_radio.peer_devices_lenght; i++)
+            int i = _bc_radio_peer_device_find(_bc_radio.peer_id);
+
+            if (i >= 0)
             {
-                if (_bc_radio.peer_id == _bc_radio.peer_devices[i].id)
+                _bc_radio.peer_devices[i].link.stats.rx_frames++;
+
+                // Retransmission of accepted message is only acknowledged again (its ACK has been lost)
+                if (_bc_radio_message_id_is_duplicate(&_bc_radio.peer_devices[i], message_id))
                 {
-                    if (_bc_radio.peer_devices[i].message_id != message_id)
-                    {
-                        _bc_radio.peer_devices[i].message_id = message_id;
+                    _bc_radio.peer_devices[i].link.stats.rx_duplicates++;
 
-                        _bc_radio.peer_devices[i].message_id_synced = false;
+                    _bc_radio.stats.rx_duplicates++;
 
-                        if (length > 9)
-                        {
-                            if ((buffer[8] >= 0x15) && (buffer[8] <= 0x1c) && (length > 14))
-                            {
-                                uint64_t for_id;
+                    _bc_radio_send_ack(buffer);
 
-                                bc_radio_id_from_buffer(buffer + 9, &for_id);
-
-                                if (for_id != _bc_radio.my_id)
-                                {
-                                    return;
-                                }
-                            }
+                    return;
+                }
 
-                            bc_queue_put(&_bc_radio.rx_queue, buffer, length);
+                if (length > 9)
+                {
+                    if ((buffer[8] >= 0x15) && (buffer[8] <= 0x1c) && (length > 14))
+                    {
+                        uint64_t for_id;
 
-                            bc_scheduler_plan_now(_bc_radio.task_id);
+                        bc_radio_id_from_buffer(buffer + 9, &for_id);
 
-                            _bc_radio.peer_devices[i].message_id_synced = true;
+                        if (for_id != _bc_radio.my_id)
+                        {
+                            return;
                         }
                     }
 
-                    if (_bc_radio.peer_devices[i].message_id_synced)
+                    // Message is refused when it refers to state of sender which receiver does not have, sender sends the state again
+                    if (!bc_radio_pub_is_decodable(&_bc_radio.peer_id, buffer + BC_RADIO_HEAD_SIZE, length - BC_RADIO_HEAD_SIZE))
                     {
-                        _bc_radio_send_ack();
+                        _bc_radio_send_refusal(buffer);
+
+                        return;
                     }
 
-                    return;
+                    if (!_bc_radio_rx_pool_put(length))
+                    {
+                        // Message is not acknowledged so that sender retransmits it
+                        _bc_radio.stats.rx_queue_full++;
+
+                        return;
+                    }
+
+                    _bc_radio_queue_high_water_update();
+
+                    bc_scheduler_plan_now(_bc_radio.task_id);
+
+                    _bc_radio_message_id_accept(&_bc_radio.peer_devices[i], message_id);
+
+                    _bc_radio_send_ack(buffer);
                 }
-            }
 
-            if (i == _bc_radio.peer_devices_lenght)
+                return;
+            }
+            else
             {
                 if (_bc_radio.scan && (_bc_radio.event_handler != NULL) && _bc_radio_scan_cache_push())
                 {
@@ -748,7 +1010,7 @@ static void _bc_radio_spirit1_event_handler(bc_spirit1_event_t event, void *even
 
 static void _bc_radio_load_peer_devices(void)
 {
-    uint32_t address = (uint32_t) bc_eeprom_get_size() - 8;
+    uint32_t address = (uint32_t) bc_eeprom_get_size() - _BC_RADIO_PEER_EEPROM_OFFSET;
     uint64_t buffer[3];
     uint32_t *pointer = (uint32_t *)buffer;
     uint8_t length = 0;
@@ -757,6 +1019,8 @@ static void _bc_radio_load_peer_devices(void)
 
     _bc_radio.peer_devices_lenght = 0;
 
+    memset(_bc_radio.peer_devices_hash, 0, sizeof(_bc_radio.peer_devices_hash));
+
     for (int i = 0; (i < length) && (i < BC_RADIO_MAX_DEVICES); i++)
     {
         address -= sizeof(buffer);
@@ -772,9 +1036,7 @@ static void _bc_radio_load_peer_devices(void)
             {
                 buffer[0] = buffer[1];
 
-                _bc_radio.save_peer_devices = true;
-
-                bc_scheduler_plan_now(_bc_radio.task_id);
+                _bc_radio_peer_devices_changed(_bc_radio.peer_devices_lenght);
             }
             else
             {
@@ -782,23 +1044,44 @@ static void _bc_radio_load_peer_devices(void)
             }
         }
 
-        if (buffer[0] != 0)
+        if ((buffer[0] != 0) && (_bc_radio_peer_device_find(buffer[0]) < 0))
         {
+            // Following devices move to lower position than they have in EEPROM
+            if (_bc_radio.peer_devices_lenght != i)
+            {
+                _bc_radio_peer_devices_changed(_bc_radio.peer_devices_lenght);
+            }
+
             _bc_radio.peer_devices[_bc_radio.peer_devices_lenght].id = buffer[0];
             _bc_radio.peer_devices[_bc_radio.peer_devices_lenght].message_id_synced = false;
+
+            _bc_radio_link_init(&_bc_radio.peer_devices[_bc_radio.peer_devices_lenght].link);
+
+            _bc_radio_peer_device_hash_insert(_bc_radio.peer_devices_lenght);
+
             _bc_radio.peer_devices_lenght++;
         }
     }
+
+    if (_bc_radio.peer_devices_lenght != length)
+    {
+        _bc_radio_peer_devices_changed(_bc_radio.peer_devices_lenght);
+    }
 }
 
 static void _bc_radio_save_peer_devices(void)
 {
-    uint32_t address = (uint32_t) bc_eeprom_get_size() - 8;
+    uint32_t address = (uint32_t) bc_eeprom_get_size() - _BC_RADIO_PEER_EEPROM_OFFSET;
     uint64_t buffer_write[3];
     uint32_t *pointer_write = (uint32_t *)buffer_write;
-    uint64_t buffer_read[3];
+    uint8_t length;
+
+    _bc_radio.save_peer_devices = false;
 
-    for (int i = 0; i < _bc_radio.peer_devices_lenght; i++)
+    // Devices in front of the first changed one are already stored
+    address -= _bc_radio.save_peer_devices_from * sizeof(buffer_write);
+
+    for (int i = _bc_radio.save_peer_devices_from; i < _bc_radio.peer_devices_lenght; i++)
     {
         buffer_write[0] = _bc_radio.peer_devices[i].id;
         buffer_write[1] = _bc_radio.peer_devices[i].id;
@@ -809,26 +1092,22 @@ static void _bc_radio_save_peer_devices(void)
 
         address -= sizeof(buffer_write);
 
-        bc_eeprom_read(address, buffer_read, sizeof(buffer_read));
-
-        if (memcmp(buffer_read, buffer_write, sizeof(buffer_write)) != 0)
+        // Words which are already stored are skipped by bc_eeprom_write
+        if (!bc_eeprom_write(address, buffer_write, sizeof(buffer_write)))
         {
-            if (!bc_eeprom_write(address, buffer_write, sizeof(buffer_write)))
-            {
-                _bc_radio.save_peer_devices = true;
+            _bc_radio_peer_devices_changed(i);
 
-                bc_scheduler_plan_now(_bc_radio.task_id);
-
-                return;
-            }
+            return;
         }
     }
 
-    if (!bc_eeprom_write(bc_eeprom_get_size() - 1, &_bc_radio.peer_devices_lenght, 1))
-    {
-        _bc_radio.save_peer_devices = true;
+    _bc_radio.save_peer_devices_from = _bc_radio.peer_devices_lenght;
+
+    length = _bc_radio.peer_devices_lenght;
 
-        bc_scheduler_plan_now(_bc_radio.task_id);
+    if (!bc_eeprom_write(bc_eeprom_get_size() - 1, &length, 1))
+    {
+        _bc_radio_peer_devices_changed(_bc_radio.peer_devices_lenght);
 
         return;
     }
@@ -842,6 +1121,11 @@ static void _bc_radio_atsha204_event_handler(bc_atsha204_t *self, bc_atsha204_ev
     {
         if (bc_atsha204_get_serial_number(self, &_bc_radio.my_id, sizeof(_bc_radio.my_id)))
         {
+            // Nothing else seeds rand on target, without device id all nodes would draw the same retry jitter and back-offs of listen before talk
+            srand((uint32_t) _bc_radio.my_id ^ (uint32_t) (_bc_radio.my_id >> 32) ^ rand());
+
+            _bc_radio_channel_select();
+
             if (_bc_radio.event_handler != NULL)
             {
                 _bc_radio.event_handler(BC_RADIO_EVENT_INIT_DONE, _bc_radio.event_param);
@@ -866,7 +1150,7 @@ static void _bc_radio_atsha204_event_handler(bc_atsha204_t *self, bc_atsha204_ev
 
 static bool _bc_radio_peer_device_add(uint64_t id)
 {
-    if (_bc_radio.peer_devices_lenght + 1 == BC_RADIO_MAX_DEVICES)
+    if (_bc_radio.peer_devices_lenght == BC_RADIO_MAX_DEVICES)
     {
         if (_bc_radio.event_handler != NULL)
         {
@@ -883,10 +1167,14 @@ static bool _bc_radio_peer_device_add(uint64_t id)
 
     _bc_radio.peer_devices[_bc_radio.peer_devices_lenght].id = id;
     _bc_radio.peer_devices[_bc_radio.peer_devices_lenght].message_id_synced = false;
-    _bc_radio.peer_devices_lenght++;
 
-    _bc_radio.save_peer_devices = true;
-    bc_scheduler_plan_now(_bc_radio.task_id);
+    _bc_radio_link_init(&_bc_radio.peer_devices[_bc_radio.peer_devices_lenght].link);
+
+    _bc_radio_peer_device_hash_insert(_bc_radio.peer_devices_lenght);
+
+    _bc_radio_peer_devices_changed(_bc_radio.peer_devices_lenght);
+
+    _bc_radio.peer_devices_lenght++;
 
     if (_bc_radio.event_handler != NULL)
     {
@@ -899,31 +1187,485 @@ static bool _bc_radio_peer_device_add(uint64_t id)
 
 static bool _bc_radio_peer_device_remove(uint64_t id)
 {
-    for (int i = 0; i < _bc_radio.peer_devices_lenght; i++)
+    int i = _bc_radio_peer_device_find(id);
+
+    if (i < 0)
     {
-        if (id == _bc_radio.peer_devices[i].id)
+        return false;
+    }
+
+    _bc_radio_peer_device_hash_remove(id);
+
+    _bc_radio.peer_devices_lenght--;
+
+    // The last device takes place of removed one
+    if (i != _bc_radio.peer_devices_lenght)
+    {
+        _bc_radio_peer_device_hash_remove(_bc_radio.peer_devices[_bc_radio.peer_devices_lenght].id);
+
+        memcpy(_bc_radio.peer_devices + i, _bc_radio.peer_devices + _bc_radio.peer_devices_lenght, sizeof(bc_radio_peer_t));
+
+        _bc_radio_peer_device_hash_insert(i);
+    }
+
+    _bc_radio_peer_devices_changed(i);
+
+    if (_bc_radio.event_handler != NULL)
+    {
+        _bc_radio.peer_id = id;
+        _bc_radio.event_handler(BC_RADIO_EVENT_DETACH, _bc_radio.event_param);
+    }
+
+    return true;
+}
+
+static inline uint32_t _bc_radio_peer_device_hash(uint64_t id)
+{
+    // Radio ID has 48 bits, both halves are folded and spread by multiplication (cheap on Cortex-M0+)
+    return (((uint32_t) id ^ (uint32_t) (id >> 24)) * 0x9e3779b1) >> (32 - _BC_RADIO_PEER_HASH_BITS);
+}
+
+static int _bc_radio_peer_device_find(uint64_t id)
+{
+    uint32_t slot = _bc_radio_peer_device_hash(id);
+
+    // Table is never full so there is always an empty slot which ends the probe
+    while (_bc_radio.peer_devices_hash[slot] != 0)
+    {
+        int index = _bc_radio.peer_devices_hash[slot] - 1;
+
+        if (_bc_radio.peer_devices[index].id == id)
         {
-            _bc_radio.peer_devices_lenght--;
+            return index;
+        }
 
-            if (i != _bc_radio.peer_devices_lenght)
-            {
-                memcpy(_bc_radio.peer_devices + i, _bc_radio.peer_devices + _bc_radio.peer_devices_lenght, sizeof(bc_radio_peer_t));
-            }
+        slot = (slot + 1) & _BC_RADIO_PEER_HASH_MASK;
+    }
 
-            _bc_radio.save_peer_devices = true;
-            bc_scheduler_plan_now(_bc_radio.task_id);
+    return -1;
+}
 
-            if (_bc_radio.event_handler != NULL)
-            {
-                _bc_radio.peer_id = id;
-                _bc_radio.event_handler(BC_RADIO_EVENT_DETACH, _bc_radio.event_param);
-            }
+static void _bc_radio_peer_device_hash_insert(int index)
+{
+    uint32_t slot = _bc_radio_peer_device_hash(_bc_radio.peer_devices[index].id);
+
+    while (_bc_radio.peer_devices_hash[slot] != 0)
+    {
+        slot = (slot + 1) & _BC_RADIO_PEER_HASH_MASK;
+    }
+
+    _bc_radio.peer_devices_hash[slot] = index + 1;
+}
+
+static void _bc_radio_peer_device_hash_remove(uint64_t id)
+{
+    uint32_t slot = _bc_radio_peer_device_hash(id);
+
+    while (_bc_radio.peer_devices[_bc_radio.peer_devices_hash[slot] - 1].id != id)
+    {
+        slot = (slot + 1) & _BC_RADIO_PEER_HASH_MASK;
+    }
+
+    // Following entries of the probe sequence are shifted back, so that no tombstones are needed
+    uint32_t next = slot;
+
+    while (true)
+    {
+        next = (next + 1) & _BC_RADIO_PEER_HASH_MASK;
+
+        if (_bc_radio.peer_devices_hash[next] == 0)
+        {
+            break;
+        }
+
+        uint32_t home = _bc_radio_peer_device_hash(_bc_radio.peer_devices[_bc_radio.peer_devices_hash[next] - 1].id);
+
+        // Entry can be moved only if its home slot is not between free slot and entry itself
+        if (((next - home) & _BC_RADIO_PEER_HASH_MASK) >= ((next - slot) & _BC_RADIO_PEER_HASH_MASK))
+        {
+            _bc_radio.peer_devices_hash[slot] = _bc_radio.peer_devices_hash[next];
 
-            return true;
+            slot = next;
         }
     }
 
-    return false;
+    _bc_radio.peer_devices_hash[slot] = 0;
+}
+
+static void _bc_radio_peer_devices_changed(int index)
+{
+    if (!_bc_radio.save_peer_devices || (index < _bc_radio.save_peer_devices_from))
+    {
+        _bc_radio.save_peer_devices_from = index;
+    }
+
+    _bc_radio.save_peer_devices = true;
+
+    bc_scheduler_plan_now(_bc_radio.task_id);
+}
+
+static void _bc_radio_link_init(bc_radio_link_t *link)
+{
+    memset(link, 0, sizeof(*link));
+
+    link->stats.ack_timeout = _BC_RADIO_ACK_TIMEOUT;
+    link->stats.quality = 255;
+
+    link->retry_budget = _BC_RADIO_RETRY_BUDGET_MAX;
+}
+
+static bool _bc_radio_message_id_is_duplicate(bc_radio_peer_t *peer, uint16_t message_id)
+{
+    // Sender retransmits only its last message, any other ID is new (lower one after sender has restarted)
+    return peer->message_id_synced && (message_id == peer->message_id);
+}
+
+static void _bc_radio_message_id_accept(bc_radio_peer_t *peer, uint16_t message_id)
+{
+    peer->message_id = message_id;
+    peer->message_id_synced = true;
+}
+
+static bc_radio_link_t *_bc_radio_tx_link(void)
+{
+    uint8_t *buffer = bc_spirit1_get_tx_buffer();
+    size_t length = bc_spirit1_get_tx_length();
+    int i = -1;
+
+    if ((length >= 15) && ((buffer[8] == BC_RADIO_HEADER_NODE_ATTACH) || (buffer[8] == BC_RADIO_HEADER_NODE_DETACH) || ((buffer[8] >= 0x15) && (buffer[8] <= 0x1c))))
+    {
+        uint64_t for_id;
+
+        bc_radio_id_from_buffer(buffer + 9, &for_id);
+
+        i = _bc_radio_peer_device_find(for_id);
+    }
+    else if (_bc_radio.peer_devices_lenght == 1)
+    {
+        // Node paired to single gateway
+        i = 0;
+    }
+
+    return i < 0 ? &_bc_radio.link : &_bc_radio.peer_devices[i].link;
+}
+
+static bc_tick_t _bc_radio_ack_timeout(void)
+{
+    if (_bc_radio.retry_policy == BC_RADIO_RETRY_POLICY_FIXED)
+    {
+        return _BC_RADIO_ACK_TIMEOUT - 50 + rand() % _BC_RADIO_ACK_TIMEOUT;
+    }
+
+    bc_radio_link_t *link = _bc_radio_tx_link();
+
+    // Back-off is not needed after the last transmission
+    if ((_bc_radio.transmit_count == 0) || (link->retry_budget < _BC_RADIO_RETRY_BUDGET_COST))
+    {
+        return link->stats.ack_timeout;
+    }
+
+    bc_tick_t window = _BC_RADIO_BACKOFF_MAX;
+
+    if (_bc_radio.transmit_attempt <= 5)
+    {
+        window = (bc_tick_t) _BC_RADIO_BACKOFF_BASE << (_bc_radio.transmit_attempt - 1);
+
+        if (window > _BC_RADIO_BACKOFF_MAX)
+        {
+            window = _BC_RADIO_BACKOFF_MAX;
+        }
+    }
+
+    return link->stats.ack_timeout + rand() % window;
+}
+
+static void _bc_radio_tx_done(void)
+{
+    bc_radio_link_t *link = _bc_radio_tx_link();
+
+    _bc_radio.transmit_attempt++;
+
+    _bc_radio.transmit_tick_done = bc_tick_get();
+
+    // Round-trip time of retransmitted message is ambiguous
+    _bc_radio.transmit_rtt_valid = _bc_radio.transmit_attempt == 1;
+
+    link->stats.tx_frames++;
+
+    if (_bc_radio.transmit_attempt == 1)
+    {
+        link->stats.tx_messages++;
+
+        if (link->retry_budget > _BC_RADIO_RETRY_BUDGET_MAX - _BC_RADIO_RETRY_BUDGET_DEPOSIT)
+        {
+            link->retry_budget = _BC_RADIO_RETRY_BUDGET_MAX;
+        }
+        else
+        {
+            link->retry_budget += _BC_RADIO_RETRY_BUDGET_DEPOSIT;
+        }
+    }
+}
+
+static void _bc_radio_tx_acknowledged(void)
+{
+    bc_radio_link_t *link = _bc_radio_tx_link();
+
+    link->stats.tx_acknowledged++;
+
+    link->stats.quality += (255 - link->stats.quality + 7) >> 3;
+
+    if (!_bc_radio.transmit_rtt_valid)
+    {
+        return;
+    }
+
+    bc_tick_t rtt = bc_tick_get() - _bc_radio.transmit_tick_done;
+
+    if (rtt > _BC_RADIO_ACK_TIMEOUT_MAX)
+    {
+        rtt = _BC_RADIO_ACK_TIMEOUT_MAX;
+    }
+
+    // Estimator of RFC 6298 in fixed point
+    if (link->srtt == 0)
+    {
+        link->srtt = rtt << 3;
+        link->rttvar = rtt << 1;
+    }
+    else
+    {
+        int delta = (int) rtt - (link->srtt >> 3);
+
+        link->srtt += delta;
+
+        if (delta < 0)
+        {
+            delta = -delta;
+        }
+
+        link->rttvar += delta - (link->rttvar >> 2);
+    }
+
+    // Zero is reserved for link without measurement
+    if (link->srtt == 0)
+    {
+        link->srtt = 1;
+    }
+
+    uint32_t timeout = (link->srtt >> 3) + link->rttvar;
+
+    if (timeout < _BC_RADIO_ACK_TIMEOUT_MIN)
+    {
+        timeout = _BC_RADIO_ACK_TIMEOUT_MIN;
+    }
+    else if (timeout > _BC_RADIO_ACK_TIMEOUT_MAX)
+    {
+        timeout = _BC_RADIO_ACK_TIMEOUT_MAX;
+    }
+
+    link->stats.round_trip_time = link->srtt >> 3;
+    link->stats.ack_timeout = timeout;
+}
+
+static bool _bc_radio_tx_timeout(void)
+{
+    bc_radio_link_t *link = _bc_radio_tx_link();
+
+    link->stats.quality -= (link->stats.quality + 7) >> 3;
+
+    _bc_radio.stats.tx_ack_timeouts++;
+
+    if (_bc_radio.transmit_count == 0)
+    {
+        link->stats.tx_failed++;
+
+        return false;
+    }
+
+    if (_bc_radio.retry_policy == BC_RADIO_RETRY_POLICY_ADAPTIVE)
+    {
+        if (link->retry_budget < _BC_RADIO_RETRY_BUDGET_COST)
+        {
+            link->stats.tx_retry_denied++;
+            link->stats.tx_failed++;
+
+            return false;
+        }
+
+        link->retry_budget -= _BC_RADIO_RETRY_BUDGET_COST;
+    }
+
+    _bc_radio.stats.tx_retransmissions++;
+
+    return true;
+}
+
+static void _bc_radio_spirit1_tx(void)
+{
+    uint8_t *buffer = bc_spirit1_get_tx_buffer();
+
+    _bc_radio_airtime_update(BC_RADIO_STATE_TX);
+
+    _bc_radio.stats.tx_frames++;
+
+    // ACK is expected right after frame, channel is held by its sender
+    bc_spirit1_set_lbt(_bc_radio.lbt && (buffer[8] != BC_RADIO_HEADER_ACK));
+
+    bc_spirit1_tx();
+}
+
+static void _bc_radio_spirit1_rx(void)
+{
+    _bc_radio_airtime_update(BC_RADIO_STATE_RX);
+
+    bc_spirit1_rx();
+}
+
+static void _bc_radio_spirit1_sleep(void)
+{
+    _bc_radio_airtime_update(BC_RADIO_STATE_SLEEP);
+
+    bc_spirit1_sleep();
+}
+
+static void _bc_radio_airtime_update(bc_radio_state_t state)
+{
+    bc_tick_t tick_now = bc_tick_get();
+
+    if (_bc_radio.airtime_state == BC_RADIO_STATE_TX)
+    {
+        _bc_radio.stats.tx_airtime += tick_now - _bc_radio.airtime_tick;
+    }
+    else if (_bc_radio.airtime_state == BC_RADIO_STATE_RX)
+    {
+        _bc_radio.stats.rx_airtime += tick_now - _bc_radio.airtime_tick;
+    }
+
+    _bc_radio.airtime_state = state;
+
+    _bc_radio.airtime_tick = tick_now;
+}
+
+static void _bc_radio_channel_select(void)
+{
+    if ((_bc_radio.channel_set == 0) || (_bc_radio.my_id == 0))
+    {
+        return;
+    }
+
+    // Devices spread over channel set by their ID, gateways stay there and nodes start there
+    uint8_t hash = 0;
+    int count = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        hash ^= _bc_radio.my_id >> (i * 8);
+    }
+
+    for (uint8_t channel = 0; channel < BC_SPIRIT1_CHANNEL_COUNT; channel++)
+    {
+        if ((_bc_radio.channel_set & (1 << channel)) != 0)
+        {
+            count++;
+        }
+    }
+
+    hash %= count;
+
+    for (uint8_t channel = 0; channel < BC_SPIRIT1_CHANNEL_COUNT; channel++)
+    {
+        if (((_bc_radio.channel_set & (1 << channel)) != 0) && (hash-- == 0))
+        {
+            bc_spirit1_set_channel(channel);
+
+            return;
+        }
+    }
+}
+
+static void _bc_radio_channel_failure(void)
+{
+    if ((_bc_radio.mode == BC_RADIO_MODE_GATEWAY) || (_bc_radio.channel_set == 0))
+    {
+        return;
+    }
+
+    if (++_bc_radio.channel_failures < _BC_RADIO_CHANNEL_MAX_FAILURES)
+    {
+        return;
+    }
+
+    _bc_radio.channel_failures = 0;
+
+    // Gateway is searched on the next channel of channel set
+    uint8_t channel = bc_spirit1_get_channel();
+
+    for (int i = 0; i < BC_SPIRIT1_CHANNEL_COUNT; i++)
+    {
+        channel = channel + 1 < BC_SPIRIT1_CHANNEL_COUNT ? channel + 1 : 0;
+
+        if ((_bc_radio.channel_set & (1 << channel)) != 0)
+        {
+            bc_spirit1_set_channel(channel);
+
+            return;
+        }
+    }
+}
+
+static void _bc_radio_queue_high_water_update(void)
+{
+    size_t length = bc_queue_get_length(&_bc_radio.pub_queue);
+
+    if (length > _bc_radio.stats.pub_queue_high_water)
+    {
+        _bc_radio.stats.pub_queue_high_water = length;
+    }
+
+    if ((uint16_t) _bc_radio.rx_pool_length > _bc_radio.stats.rx_queue_high_water)
+    {
+        _bc_radio.stats.rx_queue_high_water = _bc_radio.rx_pool_length;
+    }
+}
+
+static bool _bc_radio_rx_pool_put(size_t length)
+{
+    if (_bc_radio.rx_pool_length == _BC_RADIO_RX_POOL_SIZE - 1)
+    {
+        return false;
+    }
+
+    int i = (_bc_radio.rx_pool_head + _bc_radio.rx_pool_length) % _BC_RADIO_RX_POOL_SIZE;
+
+    // Spirit1 has received frame to this buffer, it is kept for decoding and Spirit1 gets the next one
+    _bc_radio.rx_pool[i].length = length;
+
+    _bc_radio.rx_pool_length++;
+
+    bc_spirit1_set_rx_buffer(_bc_radio.rx_pool[(i + 1) % _BC_RADIO_RX_POOL_SIZE].buffer);
+
+    return true;
+}
+
+static void _bc_radio_rx_pool_remove(void)
+{
+    _bc_radio.rx_pool_head = (_bc_radio.rx_pool_head + 1) % _BC_RADIO_RX_POOL_SIZE;
+
+    _bc_radio.rx_pool_length--;
+}
+
+static void _bc_radio_stats_task(void *param)
+{
+    (void) param;
+
+    bc_radio_stats_t stats;
+
+    bc_radio_get_stats(&stats);
+
+    bc_radio_pub_radio_stats(&stats);
+
+    bc_scheduler_plan_current_relative(_bc_radio.stats_interval);
 }
 
 uint8_t *bc_radio_id_to_buffer(uint64_t *id, uint8_t *buffer)
@@ -1005,7 +1747,7 @@ uint8_t *bc_radio_data_to_buffer(void *data, size_t length, uint8_t *buffer)
     return buffer + length;
 }
 
-uint8_t *bc_radio_id_from_buffer(uint8_t *buffer, uint64_t *id)
+uint8_t *bc_radio_id_from_buffer(const uint8_t *buffer, uint64_t *id)
 {
     *id  = (uint64_t) buffer[0];
     *id |= (uint64_t) buffer[1] << 8;
@@ -1014,10 +1756,10 @@ uint8_t *bc_radio_id_from_buffer(uint8_t *buffer, uint64_t *id)
     *id |= (uint64_t) buffer[4] << 32;
     *id |= (uint64_t) buffer[5] << 40;
 
-    return buffer + BC_RADIO_ID_SIZE;
+    return (uint8_t *) buffer + BC_RADIO_ID_SIZE;
 }
 
-uint8_t *bc_radio_bool_from_buffer(uint8_t *buffer, bool *value, bool **pointer)
+uint8_t *bc_radio_bool_from_buffer(const uint8_t *buffer, bool *value, bool **pointer)
 {
     if (*buffer == BC_RADIO_NULL_BOOL)
     {
@@ -1025,14 +1767,14 @@ uint8_t *bc_radio_bool_from_buffer(uint8_t *buffer, bool *value, bool **pointer)
     }
     else
     {
-        *value = *(bool *) buffer;
+        *value = *(const bool *) buffer;
         *pointer = value;
     }
 
-    return  buffer + 1;
+    return (uint8_t *) buffer + 1;
 }
 
-uint8_t *bc_radio_int_from_buffer(uint8_t *buffer, int *value, int **pointer)
+uint8_t *bc_radio_int_from_buffer(const uint8_t *buffer, int *value, int **pointer)
 {
     memcpy(value, buffer, sizeof(int));
 
@@ -1045,10 +1787,10 @@ uint8_t *bc_radio_int_from_buffer(uint8_t *buffer, int *value, int **pointer)
         *pointer = value;
     }
 
-    return buffer + sizeof(int);
+    return (uint8_t *) buffer + sizeof(int);
 }
 
-uint8_t *bc_radio_uint32_from_buffer(uint8_t *buffer, uint32_t *value, uint32_t **pointer)
+uint8_t *bc_radio_uint32_from_buffer(const uint8_t *buffer, uint32_t *value, uint32_t **pointer)
 {
     memcpy(value, buffer, sizeof(uint32_t));
 
@@ -1061,10 +1803,10 @@ uint8_t *bc_radio_uint32_from_buffer(uint8_t *buffer, uint32_t *value, uint32_t
         *pointer = value;
     }
 
-    return buffer + sizeof(uint32_t);
+    return (uint8_t *) buffer + sizeof(uint32_t);
 }
 
-uint8_t *bc_radio_float_from_buffer(uint8_t *buffer, float *value, float **pointer)
+uint8_t *bc_radio_float_from_buffer(const uint8_t *buffer, float *value, float **pointer)
 {
     memcpy(value, buffer, sizeof(float));
 
@@ -1077,19 +1819,19 @@ uint8_t *bc_radio_float_from_buffer(uint8_t *buffer, float *value, float **point
         *pointer = value;
     }
 
-    return buffer + sizeof(float);
+    return (uint8_t *) buffer + sizeof(float);
 }
 
-uint8_t *bc_radio_data_from_buffer(uint8_t *buffer, void *data, size_t length)
+uint8_t *bc_radio_data_from_buffer(const uint8_t *buffer, void *data, size_t length)
 {
     if (data == NULL)
     {
-        return buffer + length;
+        return (uint8_t *) buffer + length;
     }
 
     memcpy(data, buffer, length);
 
-    return buffer + length;
+    return (uint8_t *) buffer + length;
 }
 
 typedef struct
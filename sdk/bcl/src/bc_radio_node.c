@@ -9,6 +9,34 @@ __attribute__((weak)) void bc_radio_node_on_led_strip_compound_set(uint64_t *id,
 __attribute__((weak)) void bc_radio_node_on_led_strip_effect_set(uint64_t *id, bc_radio_node_led_strip_effect_t type, uint16_t wait, uint32_t *color) { (void) id; (void) type; (void) wait; (void) color; }
 __attribute__((weak)) void bc_radio_node_on_led_strip_thermometer_set(uint64_t *id, float *temperature, int8_t *min, int8_t *max, uint8_t *white_dots, float *set_point, uint32_t *set_point_color) { (void) id; (void) temperature; (void) min; (void) max; (void) white_dots; (void) set_point; (void) set_point_color; }
 
+typedef struct
+{
+    uint8_t min_length;
+    void (*decode)(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+
+} bc_radio_node_decoder_t;
+
+static void _bc_radio_node_decode_state_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_state_get(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_buffer(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_led_strip_color_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_led_strip_brightness_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_led_strip_compound_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_led_strip_effect_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+static void _bc_radio_node_decode_led_strip_thermometer_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length);
+
+// Decoders indexed by header from BC_RADIO_HEADER_NODE_STATE_SET, minimum length is counted behind id of target node
+static const bc_radio_node_decoder_t _bc_radio_node_decoders[] =
+{
+    [BC_RADIO_HEADER_NODE_STATE_SET - BC_RADIO_HEADER_NODE_STATE_SET] = { 2, _bc_radio_node_decode_state_set },
+    [BC_RADIO_HEADER_NODE_STATE_GET - BC_RADIO_HEADER_NODE_STATE_SET] = { 1, _bc_radio_node_decode_state_get },
+    [BC_RADIO_HEADER_NODE_BUFFER - BC_RADIO_HEADER_NODE_STATE_SET] = { 0, _bc_radio_node_decode_buffer },
+    [BC_RADIO_HEADER_NODE_LED_STRIP_COLOR_SET - BC_RADIO_HEADER_NODE_STATE_SET] = { sizeof(uint32_t), _bc_radio_node_decode_led_strip_color_set },
+    [BC_RADIO_HEADER_NODE_LED_STRIP_BRIGHTNESS_SET - BC_RADIO_HEADER_NODE_STATE_SET] = { 1, _bc_radio_node_decode_led_strip_brightness_set },
+    [BC_RADIO_HEADER_NODE_LED_STRIP_COMPOUND_SET - BC_RADIO_HEADER_NODE_STATE_SET] = { 0, _bc_radio_node_decode_led_strip_compound_set },
+    [BC_RADIO_HEADER_NODE_LED_STRIP_EFFECT_SET - BC_RADIO_HEADER_NODE_STATE_SET] = { 1 + sizeof(uint16_t) + sizeof(uint32_t), _bc_radio_node_decode_led_strip_effect_set },
+    [BC_RADIO_HEADER_NODE_LED_STRIP_THERMOMETER_SET - BC_RADIO_HEADER_NODE_STATE_SET] = { sizeof(float) + 3, _bc_radio_node_decode_led_strip_thermometer_set },
+};
 
 bool bc_radio_node_state_set(uint64_t *id, uint8_t state_id, bool *state)
 {
@@ -145,10 +173,8 @@ bool bc_radio_node_led_strip_thermometer_set(uint64_t *id, float temperature, in
     return bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
-void bc_radio_node_decode(uint64_t *id, uint8_t *buffer, size_t length)
+void bc_radio_node_decode(uint64_t *id, const uint8_t *buffer, size_t length)
 {
-    (void) id;
-
     uint64_t for_id;
 
     if (length < BC_RADIO_ID_SIZE + 1)
@@ -156,75 +182,118 @@ void bc_radio_node_decode(uint64_t *id, uint8_t *buffer, size_t length)
         return;
     }
 
-    uint8_t *pbuffer = buffer + 1 + BC_RADIO_ID_SIZE;
-    length = length - 1 - BC_RADIO_ID_SIZE;
-
-    if (buffer[0] == BC_RADIO_HEADER_NODE_STATE_SET)
+    if ((buffer[0] < BC_RADIO_HEADER_NODE_STATE_SET) || (buffer[0] > BC_RADIO_HEADER_NODE_LED_STRIP_THERMOMETER_SET))
     {
-        bool state;
-        bool *pstate;
+        return;
+    }
 
-        bc_radio_bool_from_buffer(pbuffer + 1, &state, &pstate);
+    const bc_radio_node_decoder_t *decoder = &_bc_radio_node_decoders[buffer[0] - BC_RADIO_HEADER_NODE_STATE_SET];
 
-        bc_radio_node_on_state_set(&for_id, pbuffer[0], pstate);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_STATE_GET)
-    {
-        bc_radio_node_on_state_get(&for_id, pbuffer[0]);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_BUFFER)
+    length = length - 1 - BC_RADIO_ID_SIZE;
+
+    if (length < decoder->min_length)
     {
-        bc_radio_node_on_buffer(id, pbuffer, length);
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_LED_STRIP_COLOR_SET)
-    {
-        uint32_t color;
 
-        bc_radio_data_from_buffer(pbuffer, &color, sizeof(color));
+    bc_radio_id_from_buffer(buffer + 1, &for_id);
 
-        bc_radio_node_on_led_strip_color_set(id, &color);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_LED_STRIP_BRIGHTNESS_SET)
-    {
-        bc_radio_node_on_led_strip_brightness_set(id, pbuffer);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_LED_STRIP_COMPOUND_SET)
-    {
-        bc_radio_node_on_led_strip_compound_set(id, pbuffer, length);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_LED_STRIP_EFFECT_SET)
-    {
-        bc_radio_node_led_strip_effect_t type = (bc_radio_node_led_strip_effect_t) *pbuffer++;
+    decoder->decode(id, &for_id, buffer + 1 + BC_RADIO_ID_SIZE, length);
+}
 
-        uint16_t wait = (uint16_t) *pbuffer++;
-        wait |= (uint16_t) *pbuffer++ >> 8;
+static void _bc_radio_node_decode_state_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) id;
+    (void) length;
 
-        uint32_t color;
+    bool state;
+    bool *pstate;
 
-        bc_radio_data_from_buffer(pbuffer, &color, sizeof(color));
+    bc_radio_bool_from_buffer(buffer + 1, &state, &pstate);
 
-        bc_radio_node_on_led_strip_effect_set(id, type, wait, &color);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_NODE_LED_STRIP_THERMOMETER_SET)
-    {
-        float temperature;
-        float *ptemperature;
-        float set_point = 0;
-        float *pset_point = NULL;
-        uint32_t color = 0;
+    bc_radio_node_on_state_set(for_id, buffer[0], pstate);
+}
 
-        pbuffer = bc_radio_float_from_buffer(pbuffer, &temperature, &ptemperature);
-        int8_t *min = (int8_t *) pbuffer;
-        int8_t *max = (int8_t *) pbuffer + 1;
-        uint8_t *white_dots = (uint8_t *) pbuffer + 2;
+static void _bc_radio_node_decode_state_get(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) id;
+    (void) length;
 
-        if (length == sizeof(float) + sizeof(int8_t) + sizeof(int8_t) + sizeof(uint8_t) + sizeof(float) + sizeof(uint32_t))
-        {
-            pbuffer = bc_radio_float_from_buffer(pbuffer + 3, &set_point, &pset_point);
+    bc_radio_node_on_state_get(for_id, buffer[0]);
+}
 
-            bc_radio_data_from_buffer(pbuffer, &color, sizeof(color));
-        }
+static void _bc_radio_node_decode_buffer(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) for_id;
 
-        bc_radio_node_on_led_strip_thermometer_set(id, ptemperature, min, max, white_dots, pset_point, &color);
+    bc_radio_node_on_buffer(id, (uint8_t *) buffer, length);
+}
+
+static void _bc_radio_node_decode_led_strip_color_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) for_id;
+    (void) length;
+
+    uint32_t color;
+
+    bc_radio_data_from_buffer(buffer, &color, sizeof(color));
+
+    bc_radio_node_on_led_strip_color_set(id, &color);
+}
+
+static void _bc_radio_node_decode_led_strip_brightness_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) for_id;
+    (void) length;
+
+    bc_radio_node_on_led_strip_brightness_set(id, (uint8_t *) buffer);
+}
+
+static void _bc_radio_node_decode_led_strip_compound_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) for_id;
+
+    bc_radio_node_on_led_strip_compound_set(id, (uint8_t *) buffer, length);
+}
+
+static void _bc_radio_node_decode_led_strip_effect_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) for_id;
+    (void) length;
+
+    bc_radio_node_led_strip_effect_t type = (bc_radio_node_led_strip_effect_t) *buffer++;
+
+    uint16_t wait = (uint16_t) *buffer++;
+    wait |= (uint16_t) *buffer++ << 8;
+
+    uint32_t color;
+
+    bc_radio_data_from_buffer(buffer, &color, sizeof(color));
+
+    bc_radio_node_on_led_strip_effect_set(id, type, wait, &color);
+}
+
+static void _bc_radio_node_decode_led_strip_thermometer_set(uint64_t *id, uint64_t *for_id, const uint8_t *buffer, size_t length)
+{
+    (void) for_id;
+
+    float temperature;
+    float *ptemperature;
+    float set_point = 0;
+    float *pset_point = NULL;
+    uint32_t color = 0;
+
+    const uint8_t *pbuffer = bc_radio_float_from_buffer(buffer, &temperature, &ptemperature);
+    int8_t *min = (int8_t *) pbuffer;
+    int8_t *max = (int8_t *) pbuffer + 1;
+    uint8_t *white_dots = (uint8_t *) pbuffer + 2;
+
+    if (length == sizeof(float) + sizeof(int8_t) + sizeof(int8_t) + sizeof(uint8_t) + sizeof(float) + sizeof(uint32_t))
+    {
+        pbuffer = bc_radio_float_from_buffer(pbuffer + 3, &set_point, &pset_point);
+
+        bc_radio_data_from_buffer(pbuffer, &color, sizeof(color));
     }
+
+    bc_radio_node_on_led_strip_thermometer_set(id, ptemperature, min, max, white_dots, pset_point, &color);
 }
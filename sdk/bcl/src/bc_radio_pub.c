@@ -2,6 +2,195 @@
 
 #define _BC_RADIO_PUB_BUFFER_SIZE_ACCELERATION (1 + sizeof(float) + sizeof(float) + sizeof(float))
 
+// Header, nine counters (airtime in milliseconds) and two high-water marks
+#define _BC_RADIO_PUB_BUFFER_SIZE_RADIO_STATS (1 + 9 * sizeof(uint32_t) + 2 * sizeof(uint16_t))
+
+// Header, length of one buffer and number of buffers
+#define _BC_RADIO_PUB_BATCH_HEAD_SIZE 3
+
+// Time from buffer to next one (or to sending of frame) in seconds
+#define _BC_RADIO_PUB_BATCH_DELTA_SIZE 2
+
+// Header and number of entries of multi frame, every entry has one byte length
+#define _BC_RADIO_PUB_MULTI_HEAD_SIZE 2
+
+// Maximum number of frames between keyframes of telemetry
+#define _BC_RADIO_PUB_TELEMETRY_KEYFRAME_INTERVAL 16
+
+// Number of devices whose telemetry can be decoded at the same time (not less than number of received frames waiting for decoding)
+#ifndef BC_RADIO_PUB_TELEMETRY_DEVICES
+#define BC_RADIO_PUB_TELEMETRY_DEVICES 4
+#endif
+
+// Number of handlers of custom headers
+#ifndef BC_RADIO_PUB_CUSTOM_HANDLERS
+#define BC_RADIO_PUB_CUSTOM_HANDLERS 4
+#endif
+
+typedef struct
+{
+    uint8_t min_length;
+    uint8_t max_length;
+    void (*decode)(uint64_t *id, const uint8_t *buffer, size_t length);
+
+} bc_radio_pub_decoder_t;
+
+static struct
+{
+    struct
+    {
+        uint8_t first;
+        uint8_t last;
+        void (*handler)(uint64_t *id, const uint8_t *buffer, size_t length, void *param);
+        void *param;
+
+    } handlers[BC_RADIO_PUB_CUSTOM_HANDLERS];
+
+    int handlers_length;
+
+} _bc_radio_pub_custom;
+
+static struct
+{
+    uint8_t buffer[BC_RADIO_MAX_BUFFER_SIZE];
+    size_t length;
+    int size;
+    bc_tick_t tick_last;
+
+} _bc_radio_pub_batch = { .size = 1 };
+
+static struct
+{
+    uint8_t buffer[BC_RADIO_MAX_BUFFER_SIZE];
+    size_t length;
+    bool active;
+
+} _bc_radio_pub_multi;
+
+// Maximum number of topic frames with id between frames which define it
+#define _BC_RADIO_PUB_TOPIC_REFRESH_INTERVAL 16
+
+// Number of subtopics which can have id assigned
+#ifndef BC_RADIO_PUB_TOPIC_IDS
+#define BC_RADIO_PUB_TOPIC_IDS 8
+#endif
+
+// Maximum length of subtopic which can have id assigned
+#ifndef BC_RADIO_PUB_TOPIC_MAX_LEN
+#define BC_RADIO_PUB_TOPIC_MAX_LEN 24
+#endif
+
+// Number of devices whose subtopic ids can be expanded at the same time (not less than number of received frames waiting for decoding)
+#ifndef BC_RADIO_PUB_TOPIC_DEVICES
+#define BC_RADIO_PUB_TOPIC_DEVICES 4
+#endif
+
+static struct
+{
+    bool enabled;
+
+    struct
+    {
+        char subtopic[BC_RADIO_PUB_TOPIC_MAX_LEN + 1];
+        bool acknowledged;
+        int refresh;
+
+    } ids[BC_RADIO_PUB_TOPIC_IDS];
+
+    int ids_head;
+
+    struct
+    {
+        uint64_t id;
+        uint32_t used;
+        char subtopic[BC_RADIO_PUB_TOPIC_IDS][BC_RADIO_PUB_TOPIC_MAX_LEN + 1];
+
+    } devices[BC_RADIO_PUB_TOPIC_DEVICES];
+
+    int devices_length;
+    uint32_t used;
+
+} _bc_radio_pub_topic;
+
+static struct
+{
+    bc_telemetry_codec_encoder_t encoder;
+    int32_t values[BC_TELEMETRY_CODEC_MAX_VALUES];
+    int count;
+    uint8_t sequence;
+
+    struct
+    {
+        uint64_t id;
+        uint32_t used;
+        bc_telemetry_codec_decoder_t decoder;
+
+    } devices[BC_RADIO_PUB_TELEMETRY_DEVICES];
+
+    int devices_length;
+    uint32_t used;
+
+} _bc_radio_pub_telemetry;
+
+static void _bc_radio_pub_batch_set_delta(bc_tick_t tick);
+static bool _bc_radio_pub_queue_put(const void *buffer, size_t length);
+static bool _bc_radio_pub_multi_flush(void);
+static bool _bc_radio_pub_topic_queue_put(const char *subtopic, const uint8_t *buffer, size_t length);
+static const char *_bc_radio_pub_topic_get_subtopic(const uint8_t *buffer, size_t length);
+static size_t _bc_radio_pub_topic_expand(const char *subtopic, const uint8_t *buffer, size_t length, uint8_t *frame);
+static char (*_bc_radio_pub_topic_get_device(uint64_t *id, bool create))[BC_RADIO_PUB_TOPIC_MAX_LEN + 1];
+static bool _bc_radio_pub_telemetry_put(void);
+static bc_telemetry_codec_decoder_t *_bc_radio_pub_telemetry_get_decoder(uint64_t *id, bool create);
+static void _bc_radio_pub_decode_push_button(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_event_count(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_temperature(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_humidity(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_lux_meter(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_barometer(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_co2(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_battery(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_acceleration(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_buffer(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_buffer_batch(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_telemetry(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_multi(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_define(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_id(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_radio_stats(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_state(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_bool(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_int(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_uint32(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_float(uint64_t *id, const uint8_t *buffer, size_t length);
+static void _bc_radio_pub_decode_topic_string(uint64_t *id, const uint8_t *buffer, size_t length);
+
+// Decoders indexed by header, frames out of length bounds are dropped
+static const bc_radio_pub_decoder_t _bc_radio_pub_decoders[] =
+{
+    [BC_RADIO_HEADER_PUB_PUSH_BUTTON] = { 3, UINT8_MAX, _bc_radio_pub_decode_push_button },
+    [BC_RADIO_HEADER_PUB_EVENT_COUNT] = { 4, UINT8_MAX, _bc_radio_pub_decode_event_count },
+    [BC_RADIO_HEADER_PUB_TEMPERATURE] = { 6, UINT8_MAX, _bc_radio_pub_decode_temperature },
+    [BC_RADIO_HEADER_PUB_HUMIDITY] = { 6, UINT8_MAX, _bc_radio_pub_decode_humidity },
+    [BC_RADIO_HEADER_PUB_LUX_METER] = { 6, UINT8_MAX, _bc_radio_pub_decode_lux_meter },
+    [BC_RADIO_HEADER_PUB_BAROMETER] = { 10, UINT8_MAX, _bc_radio_pub_decode_barometer },
+    [BC_RADIO_HEADER_PUB_CO2] = { 5, UINT8_MAX, _bc_radio_pub_decode_co2 },
+    [BC_RADIO_HEADER_PUB_BATTERY] = { 5, UINT8_MAX, _bc_radio_pub_decode_battery },
+    [BC_RADIO_HEADER_PUB_ACCELERATION] = { _BC_RADIO_PUB_BUFFER_SIZE_ACCELERATION, _BC_RADIO_PUB_BUFFER_SIZE_ACCELERATION, _bc_radio_pub_decode_acceleration },
+    [BC_RADIO_HEADER_PUB_BUFFER] = { 1, UINT8_MAX, _bc_radio_pub_decode_buffer },
+    [BC_RADIO_HEADER_PUB_BUFFER_BATCH] = { _BC_RADIO_PUB_BATCH_HEAD_SIZE, UINT8_MAX, _bc_radio_pub_decode_buffer_batch },
+    [BC_RADIO_HEADER_PUB_TELEMETRY] = { 1, UINT8_MAX, _bc_radio_pub_decode_telemetry },
+    [BC_RADIO_HEADER_PUB_MULTI] = { _BC_RADIO_PUB_MULTI_HEAD_SIZE, UINT8_MAX, _bc_radio_pub_decode_multi },
+    [BC_RADIO_HEADER_PUB_TOPIC_DEFINE] = { 3, UINT8_MAX, _bc_radio_pub_decode_topic_define },
+    [BC_RADIO_HEADER_PUB_TOPIC_ID] = { 3, UINT8_MAX, _bc_radio_pub_decode_topic_id },
+    [BC_RADIO_HEADER_PUB_RADIO_STATS] = { _BC_RADIO_PUB_BUFFER_SIZE_RADIO_STATS, _BC_RADIO_PUB_BUFFER_SIZE_RADIO_STATS, _bc_radio_pub_decode_radio_stats },
+    [BC_RADIO_HEADER_PUB_STATE] = { 3, UINT8_MAX, _bc_radio_pub_decode_state },
+    [BC_RADIO_HEADER_PUB_TOPIC_BOOL] = { 3, UINT8_MAX, _bc_radio_pub_decode_topic_bool },
+    [BC_RADIO_HEADER_PUB_TOPIC_INT] = { 6, UINT8_MAX, _bc_radio_pub_decode_topic_int },
+    [BC_RADIO_HEADER_PUB_TOPIC_UINT32] = { 6, UINT8_MAX, _bc_radio_pub_decode_topic_uint32 },
+    [BC_RADIO_HEADER_PUB_TOPIC_FLOAT] = { 6, UINT8_MAX, _bc_radio_pub_decode_topic_float },
+    [BC_RADIO_HEADER_PUB_TOPIC_STRING] = { 3, UINT8_MAX, _bc_radio_pub_decode_topic_string },
+};
+
 __attribute__((weak)) void bc_radio_pub_on_event_count(uint64_t *id, uint8_t event_id, uint16_t *event_count) { (void) id; (void) event_id; (void) event_count; }
 __attribute__((weak)) void bc_radio_pub_on_push_button(uint64_t *id, uint16_t *event_count) { (void) id; (void) event_count; }
 __attribute__((weak)) void bc_radio_pub_on_temperature(uint64_t *id, uint8_t channel, float *celsius) { (void) id; (void) channel; (void) celsius; }
@@ -12,6 +201,9 @@ __attribute__((weak)) void bc_radio_pub_on_co2(uint64_t *id, float *concentratio
 __attribute__((weak)) void bc_radio_pub_on_battery(uint64_t *id, float *voltage) { (void) id; (void) voltage; }
 __attribute__((weak)) void bc_radio_pub_on_acceleration(uint64_t *id, float *x_axis, float *y_axis, float *z_axis) { (void) id; (void) x_axis; (void) y_axis; (void) z_axis; }
 __attribute__((weak)) void bc_radio_pub_on_buffer(uint64_t *id, void *buffer, size_t length) { (void) id; (void) buffer; (void) length; }
+__attribute__((weak)) void bc_radio_pub_on_buffer_sample(uint64_t *id, void *buffer, size_t length, uint32_t age) { (void) age; bc_radio_pub_on_buffer(id, buffer, length); }
+__attribute__((weak)) void bc_radio_pub_on_telemetry(uint64_t *id, int32_t *values, int count) { (void) id; (void) values; (void) count; }
+__attribute__((weak)) void bc_radio_pub_on_radio_stats(uint64_t *id, bc_radio_stats_t *stats) { (void) id; (void) stats; }
 __attribute__((weak)) void bc_radio_pub_on_state(uint64_t *id, uint8_t state_id, bool *state) { (void) id; (void) state_id; (void) state; }
 __attribute__((weak)) void bc_radio_pub_on_bool(uint64_t *id, char *subtopic, bool *value) { (void) id; (void) subtopic; (void) value; }
 __attribute__((weak)) void bc_radio_pub_on_int(uint64_t *id, char *subtopic, int *value) { (void) id; (void) subtopic; (void) value; }
@@ -28,7 +220,7 @@ bool bc_radio_pub_event_count(uint8_t event_id, uint16_t *event_count)
 
     memcpy(buffer + 2, event_count, sizeof(*event_count));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_push_button(uint16_t *event_count)
@@ -45,7 +237,7 @@ bool bc_radio_pub_temperature(uint8_t channel, float *celsius)
 
     memcpy(&buffer[2], celsius, sizeof(*celsius));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_humidity(uint8_t channel, float *percentage)
@@ -57,7 +249,7 @@ bool bc_radio_pub_humidity(uint8_t channel, float *percentage)
 
     memcpy(&buffer[2], percentage, sizeof(*percentage));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_luminosity(uint8_t channel, float *lux)
@@ -69,7 +261,7 @@ bool bc_radio_pub_luminosity(uint8_t channel, float *lux)
 
     memcpy(&buffer[2], lux, sizeof(*lux));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_barometer(uint8_t channel, float *pascal, float *meter)
@@ -82,7 +274,7 @@ bool bc_radio_pub_barometer(uint8_t channel, float *pascal, float *meter)
     memcpy(&buffer[2], pascal, sizeof(*pascal));
     memcpy(&buffer[2 + sizeof(*pascal)], meter, sizeof(*meter));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_co2(float *concentration)
@@ -93,7 +285,7 @@ bool bc_radio_pub_co2(float *concentration)
 
     memcpy(&buffer[1], concentration, sizeof(*concentration));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_battery(float *voltage)
@@ -104,7 +296,7 @@ bool bc_radio_pub_battery(float *voltage)
 
     memcpy(&buffer[1], voltage, sizeof(*voltage));
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_acceleration(float *x_axis, float *y_axis, float *z_axis)
@@ -119,7 +311,7 @@ bool bc_radio_pub_acceleration(float *x_axis, float *y_axis, float *z_axis)
 
     pointer = bc_radio_float_to_buffer(z_axis, pointer);
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_buffer(void *buffer, size_t length)
@@ -135,7 +327,142 @@ bool bc_radio_pub_buffer(void *buffer, size_t length)
 
     memcpy(&qbuffer[1], buffer, length);
 
-    return bc_radio_pub_queue_put(qbuffer, length + 1);
+    return _bc_radio_pub_queue_put(qbuffer, length + 1);
+}
+
+void bc_radio_pub_batch_set_size(int size)
+{
+    _bc_radio_pub_batch.size = size;
+}
+
+bool bc_radio_pub_batch_buffer(void *buffer, size_t length)
+{
+    if (_bc_radio_pub_batch.size <= 1)
+    {
+        return bc_radio_pub_buffer(buffer, length);
+    }
+
+    if ((length == 0) || (_BC_RADIO_PUB_BATCH_HEAD_SIZE + _BC_RADIO_PUB_BATCH_DELTA_SIZE + length > sizeof(_bc_radio_pub_batch.buffer)))
+    {
+        return false;
+    }
+
+    // Buffer of different length or buffer which does not fit starts new batch
+    if ((_bc_radio_pub_batch.length != 0) && ((length != _bc_radio_pub_batch.buffer[1]) || (_bc_radio_pub_batch.length + _BC_RADIO_PUB_BATCH_DELTA_SIZE + length > sizeof(_bc_radio_pub_batch.buffer))))
+    {
+        if (!bc_radio_pub_batch_flush())
+        {
+            return false;
+        }
+    }
+
+    bc_tick_t tick_now = bc_tick_get();
+
+    if (_bc_radio_pub_batch.length == 0)
+    {
+        _bc_radio_pub_batch.buffer[0] = BC_RADIO_HEADER_PUB_BUFFER_BATCH;
+        _bc_radio_pub_batch.buffer[1] = length;
+        _bc_radio_pub_batch.buffer[2] = 0;
+
+        _bc_radio_pub_batch.length = _BC_RADIO_PUB_BATCH_HEAD_SIZE;
+    }
+    else
+    {
+        _bc_radio_pub_batch_set_delta(tick_now);
+    }
+
+    _bc_radio_pub_batch.length += _BC_RADIO_PUB_BATCH_DELTA_SIZE;
+
+    memcpy(_bc_radio_pub_batch.buffer + _bc_radio_pub_batch.length, buffer, length);
+
+    _bc_radio_pub_batch.length += length;
+
+    _bc_radio_pub_batch.buffer[2]++;
+
+    _bc_radio_pub_batch.tick_last = tick_now;
+
+    if (_bc_radio_pub_batch.buffer[2] >= _bc_radio_pub_batch.size)
+    {
+        return bc_radio_pub_batch_flush();
+    }
+
+    return true;
+}
+
+bool bc_radio_pub_batch_flush(void)
+{
+    if (_bc_radio_pub_batch.length == 0)
+    {
+        return true;
+    }
+
+    // Age of last buffer
+    _bc_radio_pub_batch_set_delta(bc_tick_get());
+
+    if (!bc_radio_pub_queue_put(_bc_radio_pub_batch.buffer, _bc_radio_pub_batch.length))
+    {
+        return false;
+    }
+
+    _bc_radio_pub_batch.length = 0;
+
+    return true;
+}
+
+void bc_radio_pub_multi_begin(void)
+{
+    _bc_radio_pub_multi.length = 0;
+
+    _bc_radio_pub_multi.active = true;
+}
+
+bool bc_radio_pub_multi_end(void)
+{
+    _bc_radio_pub_multi.active = false;
+
+    return _bc_radio_pub_multi_flush();
+}
+
+void bc_radio_pub_set_topic_dictionary(bool enable)
+{
+    _bc_radio_pub_topic.enabled = enable;
+}
+
+bool bc_radio_pub_telemetry(const int32_t *values, int count)
+{
+    if ((count < 1) || (count > BC_TELEMETRY_CODEC_MAX_VALUES))
+    {
+        return false;
+    }
+
+    if (_bc_radio_pub_telemetry.count != count)
+    {
+        bc_telemetry_codec_encoder_init(&_bc_radio_pub_telemetry.encoder, count, _BC_RADIO_PUB_TELEMETRY_KEYFRAME_INTERVAL);
+
+        _bc_radio_pub_telemetry.count = count;
+    }
+
+    memcpy(_bc_radio_pub_telemetry.values, values, count * sizeof(int32_t));
+
+    return _bc_radio_pub_telemetry_put();
+}
+
+bool bc_radio_pub_radio_stats(bc_radio_stats_t *stats)
+{
+    uint8_t buffer[_BC_RADIO_PUB_BUFFER_SIZE_RADIO_STATS];
+    uint32_t counters[9] =
+    {
+        stats->tx_frames, stats->tx_retransmissions, stats->tx_ack_timeouts, stats->rx_frames, stats->rx_duplicates,
+        stats->pub_queue_full, stats->rx_queue_full, stats->tx_airtime, stats->rx_airtime
+    };
+
+    buffer[0] = BC_RADIO_HEADER_PUB_RADIO_STATS;
+
+    memcpy(buffer + 1, counters, sizeof(counters));
+    memcpy(buffer + 1 + sizeof(counters), &stats->pub_queue_high_water, sizeof(uint16_t));
+    memcpy(buffer + 1 + sizeof(counters) + sizeof(uint16_t), &stats->rx_queue_high_water, sizeof(uint16_t));
+
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_state(uint8_t state_id, bool *state)
@@ -147,7 +474,7 @@ bool bc_radio_pub_state(uint8_t state_id, bool *state)
 
     bc_radio_bool_to_buffer(state, buffer + 2);
 
-    return bc_radio_pub_queue_put(buffer, sizeof(buffer));
+    return _bc_radio_pub_queue_put(buffer, sizeof(buffer));
 }
 
 bool bc_radio_pub_bool(const char *subtopic, bool *value)
@@ -167,7 +494,7 @@ bool bc_radio_pub_bool(const char *subtopic, bool *value)
 
     strcpy((char *)buffer + 2, subtopic);
 
-    return bc_radio_pub_queue_put(buffer, len + 3);
+    return _bc_radio_pub_topic_queue_put(subtopic, buffer, len + 3);
 }
 
 bool bc_radio_pub_int(const char *subtopic, int *value)
@@ -187,7 +514,7 @@ bool bc_radio_pub_int(const char *subtopic, int *value)
 
     strcpy((char *)buffer + 5, subtopic);
 
-    return bc_radio_pub_queue_put(buffer, len + 6);
+    return _bc_radio_pub_topic_queue_put(subtopic, buffer, len + 6);
 }
 
 bool bc_radio_pub_uint32(const char *subtopic, uint32_t *value)
@@ -207,7 +534,7 @@ bool bc_radio_pub_uint32(const char *subtopic, uint32_t *value)
 
     strcpy((char *)buffer + 5, subtopic);
 
-    return bc_radio_pub_queue_put(buffer, len + 6);
+    return _bc_radio_pub_topic_queue_put(subtopic, buffer, len + 6);
 }
 
 bool bc_radio_pub_float(const char *subtopic, float *value)
@@ -227,7 +554,7 @@ bool bc_radio_pub_float(const char *subtopic, float *value)
 
     strcpy((char *)buffer + 5, subtopic);
 
-    return bc_radio_pub_queue_put(buffer, len + 6);
+    return _bc_radio_pub_topic_queue_put(subtopic, buffer, len + 6);
 }
 
 bool bc_radio_pub_string(const char *subtopic, const char *value)
@@ -247,170 +574,899 @@ bool bc_radio_pub_string(const char *subtopic, const char *value)
     strcpy((char *)buffer + 1, subtopic);
     strcpy((char *)buffer + 1 + len + 1, value);
 
-    return bc_radio_pub_queue_put(buffer, len + len_value + 3);
+    return _bc_radio_pub_topic_queue_put(subtopic, buffer, len + len_value + 3);
 }
 
-void bc_radio_pub_decode(uint64_t *id, uint8_t *buffer, size_t length)
+bool bc_radio_pub_register_custom_handler(uint8_t first, uint8_t last, void (*handler)(uint64_t *id, const uint8_t *buffer, size_t length, void *param), void *param)
 {
+    if ((first < BC_RADIO_HEADER_CUSTOM_FIRST) || (last < first) || ((first <= BC_RADIO_HEADER_ACK) && (last >= BC_RADIO_HEADER_ACK)))
+    {
+        return false;
+    }
 
-    if (buffer[0] == BC_RADIO_HEADER_PUB_PUSH_BUTTON)
+    if (_bc_radio_pub_custom.handlers_length == BC_RADIO_PUB_CUSTOM_HANDLERS)
     {
-        uint16_t event_count;
+        return false;
+    }
 
-        memcpy(&event_count, buffer + 1, sizeof(event_count));
+    int i = _bc_radio_pub_custom.handlers_length++;
 
-        bc_radio_pub_on_push_button(id, &event_count);
+    _bc_radio_pub_custom.handlers[i].first = first;
+    _bc_radio_pub_custom.handlers[i].last = last;
+    _bc_radio_pub_custom.handlers[i].handler = handler;
+    _bc_radio_pub_custom.handlers[i].param = param;
+
+    return true;
+}
 
-        bc_radio_pub_on_event_count(id, BC_RADIO_PUB_EVENT_PUSH_BUTTON, &event_count);
+void bc_radio_pub_decode(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    if (length == 0)
+    {
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_EVENT_COUNT)
+
+    if (buffer[0] < sizeof(_bc_radio_pub_decoders) / sizeof(_bc_radio_pub_decoders[0]))
     {
-        uint16_t event_count;
+        const bc_radio_pub_decoder_t *decoder = &_bc_radio_pub_decoders[buffer[0]];
+
+        if (decoder->decode != NULL)
+        {
+            if ((length >= decoder->min_length) && (length <= decoder->max_length))
+            {
+                decoder->decode(id, buffer, length);
+            }
 
-        memcpy(&event_count, buffer + 2, sizeof(event_count));
+            return;
+        }
+    }
 
-        if (buffer[1] == BC_RADIO_PUB_EVENT_PUSH_BUTTON)
+    for (int i = 0; i < _bc_radio_pub_custom.handlers_length; i++)
+    {
+        if ((buffer[0] >= _bc_radio_pub_custom.handlers[i].first) && (buffer[0] <= _bc_radio_pub_custom.handlers[i].last))
         {
-            bc_radio_pub_on_push_button(id, &event_count);
+            _bc_radio_pub_custom.handlers[i].handler(id, buffer, length, _bc_radio_pub_custom.handlers[i].param);
+
+            return;
         }
+    }
+}
 
-        bc_radio_pub_on_event_count(id, buffer[1], &event_count);
+bool bc_radio_pub_is_decodable(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    if (length < 1)
+    {
+        return true;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_TEMPERATURE)
+
+    if (buffer[0] == BC_RADIO_HEADER_PUB_MULTI)
     {
-        float celsius;
+        size_t offset = _BC_RADIO_PUB_MULTI_HEAD_SIZE;
+
+        // Multi frame is refused as a whole, its sender learns about it only by delivery of the whole frame
+        while ((offset < length) && (offset + 1 + buffer[offset] <= length))
+        {
+            if (!bc_radio_pub_is_decodable(id, buffer + offset + 1, buffer[offset]))
+            {
+                return false;
+            }
 
-        memcpy(&celsius, buffer + 2, sizeof(celsius));
+            offset += 1 + buffer[offset];
+        }
 
-        bc_radio_pub_on_temperature(id, buffer[1], &celsius);
+        return true;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_HUMIDITY)
+
+    if (buffer[0] == BC_RADIO_HEADER_PUB_TELEMETRY)
     {
-        float percentage;
+        bc_telemetry_codec_decoder_t *decoder = _bc_radio_pub_telemetry_get_decoder(id, false);
 
-        memcpy(&percentage, buffer + 2, sizeof(percentage));
+        if (decoder == NULL)
+        {
+            return bc_telemetry_codec_is_keyframe(buffer + 1, length - 1);
+        }
 
-        bc_radio_pub_on_humidity(id, buffer[1], &percentage);
+        return bc_telemetry_codec_decoder_has_reference(decoder, buffer + 1, length - 1);
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_LUX_METER)
+
+    if ((buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_ID) && (length >= 3) && (buffer[1] < BC_RADIO_PUB_TOPIC_IDS))
     {
-        float lux;
+        char (*subtopics)[BC_RADIO_PUB_TOPIC_MAX_LEN + 1] = _bc_radio_pub_topic_get_device(id, false);
+
+        return (subtopics != NULL) && (subtopics[buffer[1]][0] != 0);
+    }
 
-        memcpy(&lux, buffer + 2, sizeof(lux));
+    return true;
+}
 
-        bc_radio_pub_on_lux_meter(id, buffer[1], &lux);
+void bc_radio_pub_delivery(uint8_t *buffer, size_t length, bool delivered)
+{
+    if (length < 1)
+    {
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_BAROMETER)
+
+    if (buffer[0] == BC_RADIO_HEADER_PUB_MULTI)
     {
-        float pascal;
-        float meter;
+        size_t offset = _BC_RADIO_PUB_MULTI_HEAD_SIZE;
 
-        memcpy(&pascal, buffer + 2, sizeof(pascal));
-        memcpy(&meter, buffer + 2 + sizeof(pascal), sizeof(meter));
+        while ((offset < length) && (offset + 1 + buffer[offset] <= length))
+        {
+            bc_radio_pub_delivery(buffer + offset + 1, buffer[offset], delivered);
+
+            offset += 1 + buffer[offset];
+        }
 
-        bc_radio_pub_on_barometer(id, buffer[1], &pascal, &meter);
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_CO2)
+
+    if ((buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_DEFINE) && (length > 2) && (buffer[1] < BC_RADIO_PUB_TOPIC_IDS))
     {
-        float concentration;
+        const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer + 2, length - 2);
 
-        memcpy(&concentration, buffer + 1, sizeof(concentration));
+        // Id could have been assigned to another subtopic in the meantime
+        if ((subtopic != NULL) && (strcmp(_bc_radio_pub_topic.ids[buffer[1]].subtopic, subtopic) == 0))
+        {
+            _bc_radio_pub_topic.ids[buffer[1]].acknowledged = delivered;
+        }
 
-        bc_radio_pub_on_co2(id, &concentration);
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_BATTERY)
+
+    if (buffer[0] != BC_RADIO_HEADER_PUB_TELEMETRY)
     {
-        float voltage;
+        return;
+    }
 
-        memcpy(&voltage, buffer + (length == 5 ? 1 : 2), sizeof(voltage));
+    if (delivered)
+    {
+        bc_telemetry_codec_acknowledge(&_bc_radio_pub_telemetry.encoder, buffer + 1, length - 1);
+    }
+    else
+    {
+        bc_telemetry_codec_force_keyframe(&_bc_radio_pub_telemetry.encoder);
+    }
+}
 
-        bc_radio_pub_on_battery(id, &voltage);
+void bc_radio_pub_refusal(uint8_t *buffer, size_t length)
+{
+    if (length < 1)
+    {
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_ACCELERATION)
+
+    if (buffer[0] == BC_RADIO_HEADER_PUB_MULTI)
     {
-        if (length != _BC_RADIO_PUB_BUFFER_SIZE_ACCELERATION)
+        size_t offset = _BC_RADIO_PUB_MULTI_HEAD_SIZE;
+
+        // Receiver has dropped all entries, they are sent again together in new multi frame
+        bool active = _bc_radio_pub_multi.active;
+
+        if (!active)
         {
-            return;
+            bc_radio_pub_multi_begin();
         }
 
-        float x_axis;
-        float *px_axis;
-        float y_axis;
-        float *py_axis;
-        float z_axis;
-        float *pz_axis;
-
-        buffer = bc_radio_float_from_buffer(buffer + 1, &x_axis, &px_axis);
+        while ((offset < length) && (offset + 1 + buffer[offset] <= length))
+        {
+            bc_radio_pub_refusal(buffer + offset + 1, buffer[offset]);
 
-        buffer = bc_radio_float_from_buffer(buffer, &y_axis, &py_axis);
+            offset += 1 + buffer[offset];
+        }
 
-        bc_radio_float_from_buffer(buffer, &z_axis, &pz_axis);
+        if (!active)
+        {
+            bc_radio_pub_multi_end();
+        }
 
-        bc_radio_pub_on_acceleration(id, px_axis, py_axis, pz_axis);
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_BUFFER)
+
+    // Entry of refused multi frame which receiver could decode is sent again as it is
+    if ((buffer[0] != BC_RADIO_HEADER_PUB_TELEMETRY) && (buffer[0] != BC_RADIO_HEADER_PUB_TOPIC_ID))
     {
-        bc_radio_pub_on_buffer(id, buffer + 1, length - 1);
+        _bc_radio_pub_queue_put(buffer, length);
+
+        return;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_STATE)
-    {
-        bool state;
-        bool *pstate = NULL;
 
-        bc_radio_bool_from_buffer(buffer + 2, &state, &pstate);
+    bc_radio_pub_delivery(buffer, length, false);
 
-        bc_radio_pub_on_state(id, buffer[1], pstate);
+    // Values of refused telemetry are sent again in keyframe (receiver always accepts it) unless newer values have been published
+    if ((length > 2) && (buffer[0] == BC_RADIO_HEADER_PUB_TELEMETRY) && (bc_telemetry_codec_get_sequence(buffer + 1, length - 1) == _bc_radio_pub_telemetry.sequence))
+    {
+        _bc_radio_pub_telemetry_put();
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_BOOL)
+
+    // Receiver does not know id, value is sent again with frame which defines it (id which is not acknowledged could have been reassigned)
+    if ((length >= 3) && (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_ID) && (buffer[1] < BC_RADIO_PUB_TOPIC_IDS) && _bc_radio_pub_topic.ids[buffer[1]].acknowledged)
     {
-        bool value;
-        bool *pvalue;
+        uint8_t frame[BC_RADIO_MAX_BUFFER_SIZE + BC_RADIO_PUB_TOPIC_MAX_LEN + 1];
 
-        buffer = bc_radio_bool_from_buffer(buffer + 1, &value, &pvalue);
+        _bc_radio_pub_topic.ids[buffer[1]].acknowledged = false;
 
-        buffer[length - 1] = 0;
+        const char *subtopic = _bc_radio_pub_topic.ids[buffer[1]].subtopic;
 
-        bc_radio_pub_on_bool(id, (char *) buffer, pvalue);
+        _bc_radio_pub_topic_queue_put(subtopic, frame, _bc_radio_pub_topic_expand(subtopic, buffer, length, frame));
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_INT)
-    {
-        int value;
-        int *pvalue;
+}
 
-        buffer = bc_radio_int_from_buffer(buffer + 1, &value, &pvalue);
+static void _bc_radio_pub_decode_push_button(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
 
-        buffer[length - 1] = 0;
+    uint16_t event_count;
 
-        bc_radio_pub_on_int(id, (char *) buffer, pvalue);
-    }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_UINT32)
-    {
-        uint32_t value;
-        uint32_t *pvalue;
+    memcpy(&event_count, buffer + 1, sizeof(event_count));
+
+    bc_radio_pub_on_push_button(id, &event_count);
 
-        buffer = bc_radio_uint32_from_buffer(buffer + 1, &value, &pvalue);
+    bc_radio_pub_on_event_count(id, BC_RADIO_PUB_EVENT_PUSH_BUTTON, &event_count);
+}
+
+static void _bc_radio_pub_decode_event_count(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    uint16_t event_count;
 
-        buffer[length - 1] = 0;
+    memcpy(&event_count, buffer + 2, sizeof(event_count));
 
-        bc_radio_pub_on_uint32(id, (char *) buffer, pvalue);
+    if (buffer[1] == BC_RADIO_PUB_EVENT_PUSH_BUTTON)
+    {
+        bc_radio_pub_on_push_button(id, &event_count);
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_FLOAT)
+
+    bc_radio_pub_on_event_count(id, buffer[1], &event_count);
+}
+
+static void _bc_radio_pub_decode_temperature(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    float celsius;
+
+    memcpy(&celsius, buffer + 2, sizeof(celsius));
+
+    bc_radio_pub_on_temperature(id, buffer[1], &celsius);
+}
+
+static void _bc_radio_pub_decode_humidity(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    float percentage;
+
+    memcpy(&percentage, buffer + 2, sizeof(percentage));
+
+    bc_radio_pub_on_humidity(id, buffer[1], &percentage);
+}
+
+static void _bc_radio_pub_decode_lux_meter(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    float lux;
+
+    memcpy(&lux, buffer + 2, sizeof(lux));
+
+    bc_radio_pub_on_lux_meter(id, buffer[1], &lux);
+}
+
+static void _bc_radio_pub_decode_barometer(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    float pascal;
+    float meter;
+
+    memcpy(&pascal, buffer + 2, sizeof(pascal));
+    memcpy(&meter, buffer + 2 + sizeof(pascal), sizeof(meter));
+
+    bc_radio_pub_on_barometer(id, buffer[1], &pascal, &meter);
+}
+
+static void _bc_radio_pub_decode_co2(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    float concentration;
+
+    memcpy(&concentration, buffer + 1, sizeof(concentration));
+
+    bc_radio_pub_on_co2(id, &concentration);
+}
+
+static void _bc_radio_pub_decode_battery(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    float voltage;
+
+    memcpy(&voltage, buffer + (length == 5 ? 1 : 2), sizeof(voltage));
+
+    bc_radio_pub_on_battery(id, &voltage);
+}
+
+static void _bc_radio_pub_decode_acceleration(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    float x_axis;
+    float *px_axis;
+    float y_axis;
+    float *py_axis;
+    float z_axis;
+    float *pz_axis;
+
+    buffer = bc_radio_float_from_buffer(buffer + 1, &x_axis, &px_axis);
+
+    buffer = bc_radio_float_from_buffer(buffer, &y_axis, &py_axis);
+
+    bc_radio_float_from_buffer(buffer, &z_axis, &pz_axis);
+
+    bc_radio_pub_on_acceleration(id, px_axis, py_axis, pz_axis);
+}
+
+static void _bc_radio_pub_decode_buffer(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    bc_radio_pub_on_buffer(id, (uint8_t *) buffer + 1, length - 1);
+}
+
+static void _bc_radio_pub_decode_buffer_batch(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    size_t sample_length = buffer[1];
+    int count = buffer[2];
+
+    if ((sample_length == 0) || (length != _BC_RADIO_PUB_BATCH_HEAD_SIZE + count * (_BC_RADIO_PUB_BATCH_DELTA_SIZE + sample_length)))
     {
-        float value;
-        float *pvalue;
+        return;
+    }
 
-        buffer = bc_radio_float_from_buffer(buffer + 1, &value, &pvalue);
+    // Age of buffer is sum of its delta and deltas of all following buffers
+    uint32_t age = 0;
 
-        buffer[length - 1] = 0;
+    const uint8_t *pointer = buffer + length;
+
+    for (int i = 0; i < count; i++)
+    {
+        pointer -= _BC_RADIO_PUB_BATCH_DELTA_SIZE + sample_length;
 
-        bc_radio_pub_on_float(id, (char *) buffer, pvalue);
+        age += pointer[0] | (uint16_t) pointer[1] << 8;
     }
-    else if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_STRING)
+
+    for (int i = 0; i < count; i++)
     {
-        buffer[length - 1] = 0;
+        bc_radio_pub_on_buffer_sample(id, (uint8_t *) pointer + _BC_RADIO_PUB_BATCH_DELTA_SIZE, sample_length, age);
 
-        size_t len = strlen((char *) buffer + 1);
+        age -= pointer[0] | (uint16_t) pointer[1] << 8;
 
-        bc_radio_pub_on_string(id, (char *) buffer + 1, (char *) buffer + 2 + len);
+        pointer += _BC_RADIO_PUB_BATCH_DELTA_SIZE + sample_length;
     }
 }
+
+static void _bc_radio_pub_decode_telemetry(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    int32_t values[BC_TELEMETRY_CODEC_MAX_VALUES];
+    int count;
+
+    // Only keyframe starts decoding of device, delta frame of unknown device has been refused by bc_radio_pub_is_decodable
+    bc_telemetry_codec_decoder_t *decoder = _bc_radio_pub_telemetry_get_decoder(id, bc_telemetry_codec_is_keyframe(buffer + 1, length - 1));
+
+    if (decoder == NULL)
+    {
+        return;
+    }
+
+    if (bc_telemetry_codec_decode(decoder, buffer + 1, length - 1, values, &count))
+    {
+        bc_radio_pub_on_telemetry(id, values, count);
+    }
+}
+
+static void _bc_radio_pub_decode_multi(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    const uint8_t *pointer = buffer + _BC_RADIO_PUB_MULTI_HEAD_SIZE;
+    const uint8_t *end = buffer + length;
+
+    for (int i = 0; i < buffer[1]; i++)
+    {
+        if ((pointer == end) || (pointer[0] == 0) || (pointer[0] > end - pointer - 1))
+        {
+            return;
+        }
+
+        // Entry is the same as standalone frame, nested multi frame is not allowed
+        if (pointer[1] != BC_RADIO_HEADER_PUB_MULTI)
+        {
+            bc_radio_pub_decode(id, pointer + 1, pointer[0]);
+        }
+
+        pointer += 1 + pointer[0];
+    }
+}
+
+static void _bc_radio_pub_decode_topic_define(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    if (buffer[1] >= BC_RADIO_PUB_TOPIC_IDS)
+    {
+        return;
+    }
+
+    const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer + 2, length - 2);
+
+    if (subtopic == NULL)
+    {
+        return;
+    }
+
+    if (strlen(subtopic) <= BC_RADIO_PUB_TOPIC_MAX_LEN)
+    {
+        strcpy(_bc_radio_pub_topic_get_device(id, true)[buffer[1]], subtopic);
+    }
+
+    bc_radio_pub_decode(id, buffer + 2, length - 2);
+}
+
+static void _bc_radio_pub_decode_topic_id(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    if (buffer[1] >= BC_RADIO_PUB_TOPIC_IDS)
+    {
+        return;
+    }
+
+    char (*subtopics)[BC_RADIO_PUB_TOPIC_MAX_LEN + 1] = _bc_radio_pub_topic_get_device(id, false);
+
+    // Device or id is unknown (e.g. after reset), radio refuses such frame before it is decoded
+    if ((subtopics == NULL) || (subtopics[buffer[1]][0] == 0))
+    {
+        return;
+    }
+
+    char *subtopic = subtopics[buffer[1]];
+    uint8_t frame[BC_RADIO_MAX_BUFFER_SIZE + BC_RADIO_PUB_TOPIC_MAX_LEN + 1];
+
+    size_t frame_length = _bc_radio_pub_topic_expand(subtopic, buffer, length, frame);
+
+    const char *expanded = _bc_radio_pub_topic_get_subtopic(frame, frame_length);
+
+    // Other headers or value of unexpected size would not get subtopic back
+    if ((expanded != NULL) && (strcmp(expanded, subtopic) == 0))
+    {
+        bc_radio_pub_decode(id, frame, frame_length);
+    }
+}
+
+static void _bc_radio_pub_decode_radio_stats(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    bc_radio_stats_t stats;
+    uint32_t counters[9];
+
+    memcpy(counters, buffer + 1, sizeof(counters));
+    memcpy(&stats.pub_queue_high_water, buffer + 1 + sizeof(counters), sizeof(uint16_t));
+    memcpy(&stats.rx_queue_high_water, buffer + 1 + sizeof(counters) + sizeof(uint16_t), sizeof(uint16_t));
+
+    stats.tx_frames = counters[0];
+    stats.tx_retransmissions = counters[1];
+    stats.tx_ack_timeouts = counters[2];
+    stats.rx_frames = counters[3];
+    stats.rx_duplicates = counters[4];
+    stats.pub_queue_full = counters[5];
+    stats.rx_queue_full = counters[6];
+    stats.tx_airtime = counters[7];
+    stats.rx_airtime = counters[8];
+
+    bc_radio_pub_on_radio_stats(id, &stats);
+}
+
+static void _bc_radio_pub_decode_state(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    (void) length;
+
+    bool state;
+    bool *pstate = NULL;
+
+    bc_radio_bool_from_buffer(buffer + 2, &state, &pstate);
+
+    bc_radio_pub_on_state(id, buffer[1], pstate);
+}
+
+static void _bc_radio_pub_decode_topic_bool(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    bool value;
+    bool *pvalue;
+
+    const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer, length);
+
+    if (subtopic == NULL)
+    {
+        return;
+    }
+
+    bc_radio_bool_from_buffer(buffer + 1, &value, &pvalue);
+
+    bc_radio_pub_on_bool(id, (char *) subtopic, pvalue);
+}
+
+static void _bc_radio_pub_decode_topic_int(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    int value;
+    int *pvalue;
+
+    const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer, length);
+
+    if (subtopic == NULL)
+    {
+        return;
+    }
+
+    bc_radio_int_from_buffer(buffer + 1, &value, &pvalue);
+
+    bc_radio_pub_on_int(id, (char *) subtopic, pvalue);
+}
+
+static void _bc_radio_pub_decode_topic_uint32(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    uint32_t value;
+    uint32_t *pvalue;
+
+    const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer, length);
+
+    if (subtopic == NULL)
+    {
+        return;
+    }
+
+    bc_radio_uint32_from_buffer(buffer + 1, &value, &pvalue);
+
+    bc_radio_pub_on_uint32(id, (char *) subtopic, pvalue);
+}
+
+static void _bc_radio_pub_decode_topic_float(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    float value;
+    float *pvalue;
+
+    const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer, length);
+
+    if (subtopic == NULL)
+    {
+        return;
+    }
+
+    bc_radio_float_from_buffer(buffer + 1, &value, &pvalue);
+
+    bc_radio_pub_on_float(id, (char *) subtopic, pvalue);
+}
+
+static void _bc_radio_pub_decode_topic_string(uint64_t *id, const uint8_t *buffer, size_t length)
+{
+    const char *subtopic = _bc_radio_pub_topic_get_subtopic(buffer, length);
+
+    // Value follows subtopic and it has to be terminated as well
+    if ((subtopic == NULL) || (1 + strlen(subtopic) + 1 >= length) || (buffer[length - 1] != 0))
+    {
+        return;
+    }
+
+    bc_radio_pub_on_string(id, (char *) subtopic, (char *) subtopic + strlen(subtopic) + 1);
+}
+
+static bool _bc_radio_pub_queue_put(const void *buffer, size_t length)
+{
+    if (!_bc_radio_pub_multi.active)
+    {
+        return bc_radio_pub_queue_put(buffer, length);
+    }
+
+    // Frame which is too long to be entry is sent alone
+    if (_BC_RADIO_PUB_MULTI_HEAD_SIZE + 1 + length > sizeof(_bc_radio_pub_multi.buffer))
+    {
+        if (!_bc_radio_pub_multi_flush())
+        {
+            return false;
+        }
+
+        return bc_radio_pub_queue_put(buffer, length);
+    }
+
+    if (_bc_radio_pub_multi.length + 1 + length > sizeof(_bc_radio_pub_multi.buffer))
+    {
+        if (!_bc_radio_pub_multi_flush())
+        {
+            return false;
+        }
+    }
+
+    if (_bc_radio_pub_multi.length == 0)
+    {
+        _bc_radio_pub_multi.buffer[0] = BC_RADIO_HEADER_PUB_MULTI;
+        _bc_radio_pub_multi.buffer[1] = 0;
+
+        _bc_radio_pub_multi.length = _BC_RADIO_PUB_MULTI_HEAD_SIZE;
+    }
+
+    _bc_radio_pub_multi.buffer[_bc_radio_pub_multi.length++] = length;
+
+    memcpy(_bc_radio_pub_multi.buffer + _bc_radio_pub_multi.length, buffer, length);
+
+    _bc_radio_pub_multi.length += length;
+
+    _bc_radio_pub_multi.buffer[1]++;
+
+    return true;
+}
+
+static bool _bc_radio_pub_multi_flush(void)
+{
+    bool result;
+
+    if (_bc_radio_pub_multi.length == 0)
+    {
+        return true;
+    }
+
+    // Single entry is sent as standalone frame without overhead
+    if (_bc_radio_pub_multi.buffer[1] == 1)
+    {
+        result = bc_radio_pub_queue_put(_bc_radio_pub_multi.buffer + _BC_RADIO_PUB_MULTI_HEAD_SIZE + 1, _bc_radio_pub_multi.length - _BC_RADIO_PUB_MULTI_HEAD_SIZE - 1);
+    }
+    else
+    {
+        result = bc_radio_pub_queue_put(_bc_radio_pub_multi.buffer, _bc_radio_pub_multi.length);
+    }
+
+    _bc_radio_pub_multi.length = 0;
+
+    return result;
+}
+
+static bool _bc_radio_pub_topic_queue_put(const char *subtopic, const uint8_t *buffer, size_t length)
+{
+    size_t len = strlen(subtopic);
+
+    if (!_bc_radio_pub_topic.enabled || (len > BC_RADIO_PUB_TOPIC_MAX_LEN))
+    {
+        return _bc_radio_pub_queue_put(buffer, length);
+    }
+
+    int i;
+
+    for (i = 0; i < BC_RADIO_PUB_TOPIC_IDS; i++)
+    {
+        if (strcmp(_bc_radio_pub_topic.ids[i].subtopic, subtopic) == 0)
+        {
+            break;
+        }
+    }
+
+    if (i == BC_RADIO_PUB_TOPIC_IDS)
+    {
+        // The oldest subtopic loses its id, frame which defines it again overwrites receiver's entry
+        i = _bc_radio_pub_topic.ids_head;
+
+        if (++_bc_radio_pub_topic.ids_head == BC_RADIO_PUB_TOPIC_IDS)
+        {
+            _bc_radio_pub_topic.ids_head = 0;
+        }
+
+        strcpy(_bc_radio_pub_topic.ids[i].subtopic, subtopic);
+
+        _bc_radio_pub_topic.ids[i].acknowledged = false;
+    }
+
+    uint8_t frame[BC_RADIO_MAX_BUFFER_SIZE];
+
+    if (_bc_radio_pub_topic.ids[i].acknowledged && (_bc_radio_pub_topic.ids[i].refresh > 0))
+    {
+        size_t len_value = length - 1 - len - 1;
+
+        frame[0] = BC_RADIO_HEADER_PUB_TOPIC_ID;
+        frame[1] = i;
+        frame[2] = buffer[0];
+
+        // String value follows subtopic, other values precede it
+        memcpy(frame + 3, buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_STRING ? buffer + 1 + len + 1 : buffer + 1, len_value);
+
+        _bc_radio_pub_topic.ids[i].refresh--;
+
+        return _bc_radio_pub_queue_put(frame, 3 + len_value);
+    }
+
+    if (length + 2 > sizeof(frame))
+    {
+        return _bc_radio_pub_queue_put(buffer, length);
+    }
+
+    frame[0] = BC_RADIO_HEADER_PUB_TOPIC_DEFINE;
+    frame[1] = i;
+
+    memcpy(frame + 2, buffer, length);
+
+    _bc_radio_pub_topic.ids[i].refresh = _BC_RADIO_PUB_TOPIC_REFRESH_INTERVAL;
+
+    return _bc_radio_pub_queue_put(frame, length + 2);
+}
+
+static const char *_bc_radio_pub_topic_get_subtopic(const uint8_t *buffer, size_t length)
+{
+    size_t offset;
+
+    if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_STRING)
+    {
+        offset = 1;
+    }
+    else if (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_BOOL)
+    {
+        offset = 2;
+    }
+    else if ((buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_INT) || (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_UINT32) || (buffer[0] == BC_RADIO_HEADER_PUB_TOPIC_FLOAT))
+    {
+        offset = 5;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    if ((length <= offset) || (memchr(buffer + offset, 0, length - offset) == NULL))
+    {
+        return NULL;
+    }
+
+    return (const char *) buffer + offset;
+}
+
+static size_t _bc_radio_pub_topic_expand(const char *subtopic, const uint8_t *buffer, size_t length, uint8_t *frame)
+{
+    size_t len = strlen(subtopic);
+    size_t len_value = length - 3;
+
+    frame[0] = buffer[2];
+
+    if (buffer[2] == BC_RADIO_HEADER_PUB_TOPIC_STRING)
+    {
+        strcpy((char *) frame + 1, subtopic);
+
+        memcpy(frame + 1 + len + 1, buffer + 3, len_value);
+    }
+    else
+    {
+        memcpy(frame + 1, buffer + 3, len_value);
+
+        strcpy((char *) frame + 1 + len_value, subtopic);
+    }
+
+    return 1 + len_value + len + 1;
+}
+
+static char (*_bc_radio_pub_topic_get_device(uint64_t *id, bool create))[BC_RADIO_PUB_TOPIC_MAX_LEN + 1]
+{
+    int i;
+
+    for (i = 0; i < _bc_radio_pub_topic.devices_length; i++)
+    {
+        if (_bc_radio_pub_topic.devices[i].id == *id)
+        {
+            _bc_radio_pub_topic.devices[i].used = ++_bc_radio_pub_topic.used;
+
+            return _bc_radio_pub_topic.devices[i].subtopic;
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    if (_bc_radio_pub_topic.devices_length < BC_RADIO_PUB_TOPIC_DEVICES)
+    {
+        i = _bc_radio_pub_topic.devices_length++;
+    }
+    else
+    {
+        // The least recently used device is replaced, its frames with ids are refused until it defines them again
+        i = 0;
+
+        for (int j = 1; j < BC_RADIO_PUB_TOPIC_DEVICES; j++)
+        {
+            if ((int32_t) (_bc_radio_pub_topic.devices[j].used - _bc_radio_pub_topic.devices[i].used) < 0)
+            {
+                i = j;
+            }
+        }
+    }
+
+    _bc_radio_pub_topic.devices[i].id = *id;
+    _bc_radio_pub_topic.devices[i].used = ++_bc_radio_pub_topic.used;
+
+    memset(_bc_radio_pub_topic.devices[i].subtopic, 0, sizeof(_bc_radio_pub_topic.devices[i].subtopic));
+
+    return _bc_radio_pub_topic.devices[i].subtopic;
+}
+
+static bool _bc_radio_pub_telemetry_put(void)
+{
+    uint8_t buffer[1 + BC_TELEMETRY_CODEC_MAX_FRAME_SIZE];
+
+    buffer[0] = BC_RADIO_HEADER_PUB_TELEMETRY;
+
+    size_t length = bc_telemetry_codec_encode(&_bc_radio_pub_telemetry.encoder, _bc_radio_pub_telemetry.values, buffer + 1, sizeof(buffer) - 1);
+
+    if (length == 0)
+    {
+        return false;
+    }
+
+    _bc_radio_pub_telemetry.sequence = bc_telemetry_codec_get_sequence(buffer + 1, length);
+
+    if (!bc_radio_pub_queue_put(buffer, length + 1))
+    {
+        // Frame has never been sent so the receiver cannot have it as reference
+        bc_telemetry_codec_force_keyframe(&_bc_radio_pub_telemetry.encoder);
+
+        return false;
+    }
+
+    return true;
+}
+
+static bc_telemetry_codec_decoder_t *_bc_radio_pub_telemetry_get_decoder(uint64_t *id, bool create)
+{
+    int i;
+
+    for (i = 0; i < _bc_radio_pub_telemetry.devices_length; i++)
+    {
+        if (_bc_radio_pub_telemetry.devices[i].id == *id)
+        {
+            _bc_radio_pub_telemetry.devices[i].used = ++_bc_radio_pub_telemetry.used;
+
+            return &_bc_radio_pub_telemetry.devices[i].decoder;
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    if (_bc_radio_pub_telemetry.devices_length < BC_RADIO_PUB_TELEMETRY_DEVICES)
+    {
+        i = _bc_radio_pub_telemetry.devices_length++;
+    }
+    else
+    {
+        // The least recently used device is replaced, device whose frame waits for decoding has been checked after the others
+        i = 0;
+
+        for (int j = 1; j < BC_RADIO_PUB_TELEMETRY_DEVICES; j++)
+        {
+            if ((int32_t) (_bc_radio_pub_telemetry.devices[j].used - _bc_radio_pub_telemetry.devices[i].used) < 0)
+            {
+                i = j;
+            }
+        }
+    }
+
+    _bc_radio_pub_telemetry.devices[i].id = *id;
+    _bc_radio_pub_telemetry.devices[i].used = ++_bc_radio_pub_telemetry.used;
+
+    bc_telemetry_codec_decoder_init(&_bc_radio_pub_telemetry.devices[i].decoder);
+
+    return &_bc_radio_pub_telemetry.devices[i].decoder;
+}
+
+static void _bc_radio_pub_batch_set_delta(bc_tick_t tick)
+{
+    uint8_t *pointer = _bc_radio_pub_batch.buffer + _bc_radio_pub_batch.length - _bc_radio_pub_batch.buffer[1] - _BC_RADIO_PUB_BATCH_DELTA_SIZE;
+
+    bc_tick_t delta = (tick - _bc_radio_pub_batch.tick_last + 500) / 1000;
+
+    if (delta > UINT16_MAX)
+    {
+        delta = UINT16_MAX;
+    }
+
+    pointer[0] = delta;
+    pointer[1] = delta >> 8;
+}
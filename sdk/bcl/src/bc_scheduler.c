@@ -1,6 +1,13 @@
 #include <bc_scheduler.h>
 #include <bc_system.h>
 #include <bc_error.h>
+#include <bc_irq.h>
+
+// Task is not in timer heap (it is not planned or it is being executed)
+#define _BC_SCHEDULER_NOT_QUEUED ((size_t) -1)
+
+// Task has been executed in current spin and waits for the next one
+#define _BC_SCHEDULER_DEFERRED ((size_t) -2)
 
 static struct
 {
@@ -9,10 +16,20 @@ static struct
         bc_tick_t tick_execution;
         void (*task)(void *);
         void *param;
+        size_t heap_index;
+        uint32_t spin;
 
     } pool[BC_SCHEDULER_MAX_TASKS];
 
+    // Min-heap of planned tasks ordered by execution tick and task ID
+    bc_scheduler_task_id_t heap[BC_SCHEDULER_MAX_TASKS];
+    size_t heap_length;
+
+    bc_scheduler_task_id_t deferred[BC_SCHEDULER_MAX_TASKS];
+    size_t deferred_length;
+
     bc_tick_t tick_spin;
+    uint32_t spin;
     bc_scheduler_task_id_t current_task_id;
     bc_scheduler_task_id_t max_task_id;
     int sleep_bypass_semaphore;
@@ -21,31 +38,83 @@ static struct
 
 void application_error(bc_error_t code);
 
+static void _bc_scheduler_plan(bc_scheduler_task_id_t task_id, bc_tick_t tick);
+static void _bc_scheduler_heap_update(bc_scheduler_task_id_t task_id);
+static void _bc_scheduler_heap_remove(size_t index);
+static bool _bc_scheduler_heap_sift_up(size_t index);
+static void _bc_scheduler_heap_sift_down(size_t index);
+
 void bc_scheduler_init(void)
 {
     memset(&_bc_scheduler, 0, sizeof(_bc_scheduler));
+
+    for (bc_scheduler_task_id_t i = 0; i < BC_SCHEDULER_MAX_TASKS; i++)
+    {
+        _bc_scheduler.pool[i].heap_index = _BC_SCHEDULER_NOT_QUEUED;
+    }
 }
 
 void bc_scheduler_run(void)
 {
-    static bc_scheduler_task_id_t *task_id = &_bc_scheduler.current_task_id;
+    bc_scheduler_task_id_t task_id;
 
     while (true)
     {
         _bc_scheduler.tick_spin = bc_tick_get();
 
-        for (*task_id = 0; *task_id <= _bc_scheduler.max_task_id; (*task_id)++)
+        _bc_scheduler.spin++;
+
+        while (true)
         {
-            if (_bc_scheduler.pool[*task_id].task != NULL)
+            bc_irq_disable();
+
+            if ((_bc_scheduler.heap_length == 0) || (_bc_scheduler.pool[_bc_scheduler.heap[0]].tick_execution > _bc_scheduler.tick_spin))
+            {
+                bc_irq_enable();
+
+                break;
+            }
+
+            task_id = _bc_scheduler.heap[0];
+
+            _bc_scheduler_heap_remove(0);
+
+            // Every task runs at most once per spin
+            if (_bc_scheduler.pool[task_id].spin == _bc_scheduler.spin)
             {
-                if (_bc_scheduler.tick_spin >= _bc_scheduler.pool[*task_id].tick_execution)
-                {
-                    _bc_scheduler.pool[*task_id].tick_execution = BC_TICK_INFINITY;
+                _bc_scheduler.pool[task_id].heap_index = _BC_SCHEDULER_DEFERRED;
+
+                _bc_scheduler.deferred[_bc_scheduler.deferred_length++] = task_id;
+
+                bc_irq_enable();
 
-                    _bc_scheduler.pool[*task_id].task(_bc_scheduler.pool[*task_id].param);
-                }
+                continue;
             }
+
+            _bc_scheduler.pool[task_id].spin = _bc_scheduler.spin;
+
+            _bc_scheduler.pool[task_id].tick_execution = BC_TICK_INFINITY;
+
+            bc_irq_enable();
+
+            _bc_scheduler.current_task_id = task_id;
+
+            _bc_scheduler.pool[task_id].task(_bc_scheduler.pool[task_id].param);
         }
+
+        bc_irq_disable();
+
+        while (_bc_scheduler.deferred_length != 0)
+        {
+            task_id = _bc_scheduler.deferred[--_bc_scheduler.deferred_length];
+
+            _bc_scheduler.pool[task_id].heap_index = _BC_SCHEDULER_NOT_QUEUED;
+
+            _bc_scheduler_heap_update(task_id);
+        }
+
+        bc_irq_enable();
+
         if (_bc_scheduler.sleep_bypass_semaphore == 0)
         {
             bc_system_sleep();
@@ -59,9 +128,11 @@ bc_scheduler_task_id_t bc_scheduler_register(void (*task)(void *), void *param,
     {
         if (_bc_scheduler.pool[i].task == NULL)
         {
-            _bc_scheduler.pool[i].tick_execution = tick;
             _bc_scheduler.pool[i].task = task;
             _bc_scheduler.pool[i].param = param;
+            _bc_scheduler.pool[i].spin = 0;
+
+            _bc_scheduler_plan(i, tick);
 
             if (_bc_scheduler.max_task_id < i)
             {
@@ -79,8 +150,19 @@ bc_scheduler_task_id_t bc_scheduler_register(void (*task)(void *), void *param,
 
 void bc_scheduler_unregister(bc_scheduler_task_id_t task_id)
 {
+    bc_irq_disable();
+
     _bc_scheduler.pool[task_id].task = NULL;
 
+    _bc_scheduler.pool[task_id].tick_execution = BC_TICK_INFINITY;
+
+    if (_bc_scheduler.pool[task_id].heap_index != _BC_SCHEDULER_DEFERRED)
+    {
+        _bc_scheduler_heap_update(task_id);
+    }
+
+    bc_irq_enable();
+
     if (_bc_scheduler.max_task_id == task_id)
     {
         do
@@ -106,6 +188,33 @@ bc_tick_t bc_scheduler_get_spin_tick(void)
     return _bc_scheduler.tick_spin;
 }
 
+bc_tick_t bc_scheduler_get_next_deadline(void)
+{
+    bc_tick_t tick = BC_TICK_INFINITY;
+
+    bc_irq_disable();
+
+    if (_bc_scheduler.heap_length != 0)
+    {
+        tick = _bc_scheduler.pool[_bc_scheduler.heap[0]].tick_execution;
+    }
+
+    // Deferred tasks are not in heap until the end of spin
+    for (size_t i = 0; i < _bc_scheduler.deferred_length; i++)
+    {
+        bc_scheduler_task_id_t task_id = _bc_scheduler.deferred[i];
+
+        if ((_bc_scheduler.pool[task_id].task != NULL) && (_bc_scheduler.pool[task_id].tick_execution < tick))
+        {
+            tick = _bc_scheduler.pool[task_id].tick_execution;
+        }
+    }
+
+    bc_irq_enable();
+
+    return tick;
+}
+
 void bc_scheduler_disable_sleep(void)
 {
     _bc_scheduler.sleep_bypass_semaphore++;
@@ -118,40 +227,175 @@ void bc_scheduler_enable_sleep(void)
 
 void bc_scheduler_plan_now(bc_scheduler_task_id_t task_id)
 {
-    _bc_scheduler.pool[task_id].tick_execution = 0;
+    _bc_scheduler_plan(task_id, 0);
 }
 
 void bc_scheduler_plan_absolute(bc_scheduler_task_id_t task_id, bc_tick_t tick)
 {
-    _bc_scheduler.pool[task_id].tick_execution = tick;
+    _bc_scheduler_plan(task_id, tick);
 }
 
 void bc_scheduler_plan_relative(bc_scheduler_task_id_t task_id, bc_tick_t tick)
 {
-    _bc_scheduler.pool[task_id].tick_execution = _bc_scheduler.tick_spin + tick;
+    _bc_scheduler_plan(task_id, _bc_scheduler.tick_spin + tick);
 }
 
 void bc_scheduler_plan_from_now(bc_scheduler_task_id_t task_id, bc_tick_t tick)
 {
-    _bc_scheduler.pool[task_id].tick_execution = bc_tick_get() + tick;
+    _bc_scheduler_plan(task_id, bc_tick_get() + tick);
 }
 
 void bc_scheduler_plan_current_now(void)
 {
-    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = 0;
+    _bc_scheduler_plan(_bc_scheduler.current_task_id, 0);
 }
 
 void bc_scheduler_plan_current_absolute(bc_tick_t tick)
 {
-    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = tick;
+    _bc_scheduler_plan(_bc_scheduler.current_task_id, tick);
 }
 
 void bc_scheduler_plan_current_relative(bc_tick_t tick)
 {
-    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = _bc_scheduler.tick_spin + tick;
+    _bc_scheduler_plan(_bc_scheduler.current_task_id, _bc_scheduler.tick_spin + tick);
 }
 
 void bc_scheduler_plan_current_from_now(bc_tick_t tick)
 {
-    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = bc_tick_get() + tick;
+    _bc_scheduler_plan(_bc_scheduler.current_task_id, bc_tick_get() + tick);
+}
+
+static void _bc_scheduler_plan(bc_scheduler_task_id_t task_id, bc_tick_t tick)
+{
+    // Tasks are planned from interrupts as well
+    bc_irq_disable();
+
+    _bc_scheduler.pool[task_id].tick_execution = tick;
+
+    // Deferred task is put back to heap at the end of spin
+    if (_bc_scheduler.pool[task_id].heap_index != _BC_SCHEDULER_DEFERRED)
+    {
+        _bc_scheduler_heap_update(task_id);
+    }
+
+    bc_irq_enable();
+}
+
+static inline bool _bc_scheduler_heap_less(bc_scheduler_task_id_t a, bc_scheduler_task_id_t b)
+{
+    if (_bc_scheduler.pool[a].tick_execution != _bc_scheduler.pool[b].tick_execution)
+    {
+        return _bc_scheduler.pool[a].tick_execution < _bc_scheduler.pool[b].tick_execution;
+    }
+
+    return a < b;
+}
+
+static inline void _bc_scheduler_heap_set(size_t index, bc_scheduler_task_id_t task_id)
+{
+    _bc_scheduler.heap[index] = task_id;
+    _bc_scheduler.pool[task_id].heap_index = index;
+}
+
+static void _bc_scheduler_heap_update(bc_scheduler_task_id_t task_id)
+{
+    size_t index = _bc_scheduler.pool[task_id].heap_index;
+
+    if ((_bc_scheduler.pool[task_id].task == NULL) || (_bc_scheduler.pool[task_id].tick_execution == BC_TICK_INFINITY))
+    {
+        if (index != _BC_SCHEDULER_NOT_QUEUED)
+        {
+            _bc_scheduler_heap_remove(index);
+        }
+
+        return;
+    }
+
+    if (index == _BC_SCHEDULER_NOT_QUEUED)
+    {
+        index = _bc_scheduler.heap_length++;
+
+        _bc_scheduler_heap_set(index, task_id);
+    }
+
+    if (!_bc_scheduler_heap_sift_up(index))
+    {
+        _bc_scheduler_heap_sift_down(index);
+    }
+}
+
+static void _bc_scheduler_heap_remove(size_t index)
+{
+    bc_scheduler_task_id_t task_id = _bc_scheduler.heap[index];
+
+    _bc_scheduler.pool[task_id].heap_index = _BC_SCHEDULER_NOT_QUEUED;
+
+    if (--_bc_scheduler.heap_length == index)
+    {
+        return;
+    }
+
+    _bc_scheduler_heap_set(index, _bc_scheduler.heap[_bc_scheduler.heap_length]);
+
+    if (!_bc_scheduler_heap_sift_up(index))
+    {
+        _bc_scheduler_heap_sift_down(index);
+    }
+}
+
+static bool _bc_scheduler_heap_sift_up(size_t index)
+{
+    bc_scheduler_task_id_t task_id = _bc_scheduler.heap[index];
+    bool moved = false;
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+
+        if (!_bc_scheduler_heap_less(task_id, _bc_scheduler.heap[parent]))
+        {
+            break;
+        }
+
+        _bc_scheduler_heap_set(index, _bc_scheduler.heap[parent]);
+
+        index = parent;
+
+        moved = true;
+    }
+
+    _bc_scheduler_heap_set(index, task_id);
+
+    return moved;
+}
+
+static void _bc_scheduler_heap_sift_down(size_t index)
+{
+    bc_scheduler_task_id_t task_id = _bc_scheduler.heap[index];
+
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child >= _bc_scheduler.heap_length)
+        {
+            break;
+        }
+
+        if ((child + 1 < _bc_scheduler.heap_length) && _bc_scheduler_heap_less(_bc_scheduler.heap[child + 1], _bc_scheduler.heap[child]))
+        {
+            child++;
+        }
+
+        if (!_bc_scheduler_heap_less(_bc_scheduler.heap[child], task_id))
+        {
+            break;
+        }
+
+        _bc_scheduler_heap_set(index, _bc_scheduler.heap[child]);
+
+        index = child;
+    }
+
+    _bc_scheduler_heap_set(index, task_id);
 }
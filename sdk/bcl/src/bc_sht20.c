@@ -9,6 +9,12 @@ static void _bc_sht20_task_interval(void *param);
 
 static void _bc_sht20_task_measure(void *param);
 
+static bool _bc_sht20_i2c_write(bc_sht20_t *self, uint8_t command);
+
+static bool _bc_sht20_i2c_read(bc_sht20_t *self);
+
+static void _bc_sht20_i2c_event_handler(bc_i2c_event_t event, void *event_param);
+
 // TODO SHT20 has only one fixed address so it is no necessary to pass it as parameter
 
 void bc_sht20_init(bc_sht20_t *self, bc_i2c_channel_t i2c_channel, uint8_t i2c_address)
@@ -136,6 +142,21 @@ static void _bc_sht20_task_measure(void *param)
 {
     bc_sht20_t *self = param;
 
+    // Transfers of previous state are not finished yet, their event handler plans task again
+    if (self->_i2c_pending != 0)
+    {
+        self->_i2c_wait = true;
+
+        return;
+    }
+
+    if (self->_i2c_error)
+    {
+        self->_i2c_error = false;
+
+        self->_state = BC_SHT20_STATE_ERROR;
+    }
+
 start:
 
     switch (self->_state)
@@ -160,17 +181,7 @@ start:
         {
             self->_state = BC_SHT20_STATE_ERROR;
 
-            uint8_t buffer[1];
-
-            buffer[0] = 0xfe;
-
-            bc_i2c_transfer_t transfer;
-
-            transfer.device_address = self->_i2c_address;
-            transfer.buffer = buffer;
-            transfer.length = sizeof(buffer);
-
-            if (!bc_i2c_write(self->_i2c_channel, &transfer))
+            if (!_bc_sht20_i2c_write(self, 0xfe))
             {
                 goto start;
             }
@@ -190,17 +201,7 @@ start:
         {
             self->_state = BC_SHT20_STATE_ERROR;
 
-            uint8_t buffer[1];
-
-            buffer[0] = 0xf5;
-
-            bc_i2c_transfer_t transfer;
-
-            transfer.device_address = self->_i2c_address;
-            transfer.buffer = buffer;
-            transfer.length = sizeof(buffer);
-
-            if (!bc_i2c_write(self->_i2c_channel, &transfer))
+            if (!_bc_sht20_i2c_write(self, 0xf5))
             {
                 goto start;
             }
@@ -215,42 +216,26 @@ start:
         {
             self->_state = BC_SHT20_STATE_ERROR;
 
-            uint8_t buffer[2];
-
-            bc_i2c_transfer_t transfer;
-
-            transfer.device_address = self->_i2c_address;
-            transfer.buffer = buffer;
-            transfer.length = sizeof(buffer);
-
-            if (!bc_i2c_read(self->_i2c_channel, &transfer))
+            if (!_bc_sht20_i2c_read(self))
             {
                 goto start;
             }
 
-            self->_reg_humidity = buffer[0] << 8 | buffer[1];
-
-            self->_humidity_valid = true;
-
             self->_state = BC_SHT20_STATE_MEASURE_T;
 
-            goto start;
+            bc_scheduler_plan_current_now();
+
+            return;
         }
         case BC_SHT20_STATE_MEASURE_T:
         {
-            self->_state = BC_SHT20_STATE_ERROR;
-
-            uint8_t buffer[1];
+            self->_reg_humidity = self->_i2c_buffer[0] << 8 | self->_i2c_buffer[1];
 
-            buffer[0] = 0xf3;
-
-            bc_i2c_transfer_t transfer;
+            self->_humidity_valid = true;
 
-            transfer.device_address = self->_i2c_address;
-            transfer.buffer = buffer;
-            transfer.length = sizeof(buffer);
+            self->_state = BC_SHT20_STATE_ERROR;
 
-            if (!bc_i2c_write(self->_i2c_channel, &transfer))
+            if (!_bc_sht20_i2c_write(self, 0xf3))
             {
                 goto start;
             }
@@ -265,29 +250,23 @@ start:
         {
             self->_state = BC_SHT20_STATE_ERROR;
 
-            uint8_t buffer[2];
-
-            bc_i2c_transfer_t transfer;
-
-            transfer.device_address = self->_i2c_address;
-            transfer.buffer = buffer;
-            transfer.length = sizeof(buffer);
-
-            if (!bc_i2c_read(self->_i2c_channel, &transfer))
+            if (!_bc_sht20_i2c_read(self))
             {
                 goto start;
             }
 
-            self->_reg_temperature = buffer[0] << 8 | buffer[1];
-
-            self->_temperature_valid = true;
-
             self->_state = BC_SHT20_STATE_UPDATE;
 
-            goto start;
+            bc_scheduler_plan_current_now();
+
+            return;
         }
         case BC_SHT20_STATE_UPDATE:
         {
+            self->_reg_temperature = self->_i2c_buffer[0] << 8 | self->_i2c_buffer[1];
+
+            self->_temperature_valid = true;
+
             self->_measurement_active = false;
 
             if (self->_event_handler != NULL)
@@ -307,3 +286,59 @@ start:
         }
     }
 }
+
+static bool _bc_sht20_i2c_write(bc_sht20_t *self, uint8_t command)
+{
+    bc_i2c_transfer_t transfer;
+
+    self->_i2c_buffer[0] = command;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.buffer = self->_i2c_buffer;
+    transfer.length = 1;
+
+    if (!bc_i2c_async_write(self->_i2c_channel, &transfer, _bc_sht20_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static bool _bc_sht20_i2c_read(bc_sht20_t *self)
+{
+    bc_i2c_transfer_t transfer;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.buffer = self->_i2c_buffer;
+    transfer.length = sizeof(self->_i2c_buffer);
+
+    if (!bc_i2c_async_read(self->_i2c_channel, &transfer, _bc_sht20_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static void _bc_sht20_i2c_event_handler(bc_i2c_event_t event, void *event_param)
+{
+    bc_sht20_t *self = event_param;
+
+    if (event == BC_I2C_EVENT_ERROR)
+    {
+        self->_i2c_error = true;
+    }
+
+    // Failure is handled immediately, otherwise task continues at its planned time
+    if ((--self->_i2c_pending == 0) && (self->_i2c_wait || self->_i2c_error))
+    {
+        self->_i2c_wait = false;
+
+        bc_scheduler_plan_now(self->_task_id_measure);
+    }
+}
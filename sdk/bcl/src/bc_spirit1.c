@@ -8,6 +8,12 @@
 #include "SDK_Configuration_Common.h"
 #include "MCU_Interface.h"
 
+// Channels do not overlap with receiver bandwidth of 100 kHz
+#define _BC_SPIRIT1_CHANNEL_SPACE 100e3
+
+// Time for which receiver measures RSSI before carrier sense is read in microseconds
+#define _BC_SPIRIT1_LBT_LISTEN_TIME 1000
+
 typedef enum
 {
     BC_SPIRIT1_STATE_SLEEP = 0,
@@ -25,10 +31,18 @@ typedef struct
     bc_spirit1_state_t current_state;
     uint8_t tx_buffer[BC_SPIRIT1_MAX_PACKET_SIZE];
     size_t tx_length;
-    uint8_t  rx_buffer[BC_SPIRIT1_MAX_PACKET_SIZE];
+    bool tx_backoff;
+    int tx_backoff_count;
+    bc_tick_t tx_tick_backoff;
+    uint8_t rx_buffer_internal[BC_SPIRIT1_MAX_PACKET_SIZE];
+    uint8_t *rx_buffer;
     size_t rx_length;
     bc_tick_t rx_timeout;
     bc_tick_t rx_tick_timeout;
+    uint8_t channel;
+    bool channel_update;
+    bool lbt;
+    uint32_t lbt_backoff_count;
 
 } bc_spirit1_t;
 
@@ -39,7 +53,7 @@ static bc_spirit1_t _bc_spirit1;
 SRadioInit xRadioInit = {
   XTAL_OFFSET_PPM,
   BASE_FREQUENCY,
-  CHANNEL_SPACE,
+  _BC_SPIRIT1_CHANNEL_SPACE,
   CHANNEL_NUMBER,
   MODULATION_SELECT,
   DATARATE,
@@ -76,10 +90,13 @@ SGpioInit xGpioIRQ={
 };
 
 static void _bc_spirit1_enter_state_tx(void);
+static void _bc_spirit1_transmit(void);
 static void _bc_spirit1_check_state_tx(void);
 static void _bc_spirit1_enter_state_rx(void);
 static void _bc_spirit1_check_state_rx(void);
 static void _bc_spirit1_enter_state_sleep(void);
+static void _bc_spirit1_update_channel(void);
+static bool _bc_spirit1_carrier_sense(void);
 
 void bc_spirit1_hal_chip_select_low(void);
 void bc_spirit1_hal_chip_select_high(void);
@@ -94,6 +111,8 @@ void bc_spirit1_init(void)
 {
     memset(&_bc_spirit1, 0, sizeof(_bc_spirit1));
 
+    _bc_spirit1.rx_buffer = _bc_spirit1.rx_buffer_internal;
+
     SpiritRadioSetXtalFrequency(XTAL_FREQUENCY);
     SpiritSpiInit();
 
@@ -112,6 +131,10 @@ void bc_spirit1_init(void)
     SpiritPktBasicInit(&xBasicInit);
     SpiritPktBasicAddressesInit(&xAddressInit);
 
+    /* Spirit carrier sense config */
+    SpiritQiSetRssiThresholddBm(BC_SPIRIT1_LBT_RSSI_THRESHOLD);
+    SpiritQiSetCsMode(CS_MODE_STATIC_3DB);
+
     _bc_spirit1.task_id = bc_scheduler_register(_bc_spirit1_task, NULL, BC_TICK_INFINITY);
 
     _bc_spirit1_enter_state_sleep();
@@ -143,6 +166,11 @@ void *bc_spirit1_get_rx_buffer(void)
     return _bc_spirit1.rx_buffer;
 }
 
+void bc_spirit1_set_rx_buffer(void *buffer)
+{
+    _bc_spirit1.rx_buffer = buffer != NULL ? buffer : _bc_spirit1.rx_buffer_internal;
+}
+
 size_t bc_spirit1_get_rx_length(void)
 {
     return _bc_spirit1.rx_length;
@@ -167,6 +195,33 @@ void bc_spirit1_set_rx_timeout(bc_tick_t timeout)
     }
 }
 
+void bc_spirit1_set_channel(uint8_t channel)
+{
+    if (channel >= BC_SPIRIT1_CHANNEL_COUNT)
+    {
+        return;
+    }
+
+    _bc_spirit1.channel_update = _bc_spirit1.channel_update || (_bc_spirit1.channel != channel);
+
+    _bc_spirit1.channel = channel;
+}
+
+uint8_t bc_spirit1_get_channel(void)
+{
+    return _bc_spirit1.channel;
+}
+
+void bc_spirit1_set_lbt(bool enable)
+{
+    _bc_spirit1.lbt = enable;
+}
+
+uint32_t bc_spirit1_get_lbt_backoff_count(void)
+{
+    return _bc_spirit1.lbt_backoff_count;
+}
+
 void bc_spirit1_tx(void)
 {
     _bc_spirit1.desired_state = BC_SPIRIT1_STATE_TX;
@@ -240,10 +295,39 @@ static void _bc_spirit1_task(void *param)
 
 static void _bc_spirit1_enter_state_tx(void)
 {
-    GPIOA->PUPDR |= GPIO_PUPDR_PUPD7_1;
-
     _bc_spirit1.current_state = BC_SPIRIT1_STATE_TX;
 
+    _bc_spirit1.tx_backoff_count = 0;
+
+    _bc_spirit1_transmit();
+}
+
+static void _bc_spirit1_transmit(void)
+{
+    _bc_spirit1_update_channel();
+
+    if (_bc_spirit1.lbt && (_bc_spirit1.tx_backoff_count < BC_SPIRIT1_LBT_MAX_BACKOFFS) && _bc_spirit1_carrier_sense())
+    {
+        // Back-off is at least one slot, random part in milliseconds doubles with every busy channel
+        bc_tick_t backoff = BC_SPIRIT1_LBT_BACKOFF_SLOT + rand() % (BC_SPIRIT1_LBT_BACKOFF_SLOT << (_bc_spirit1.tx_backoff_count + 1));
+
+        _bc_spirit1.tx_backoff = true;
+        _bc_spirit1.tx_backoff_count++;
+        _bc_spirit1.tx_tick_backoff = bc_tick_get() + backoff;
+
+        _bc_spirit1.lbt_backoff_count++;
+
+        SpiritCmdStrobeStandby();
+
+        bc_scheduler_plan_absolute(_bc_spirit1.task_id, _bc_spirit1.tx_tick_backoff);
+
+        return;
+    }
+
+    _bc_spirit1.tx_backoff = false;
+
+    GPIOA->PUPDR |= GPIO_PUPDR_PUPD7_1;
+
     SpiritCmdStrobeSabort();
     SpiritCmdStrobeReady();
     SpiritCmdStrobeFlushTxFifo();
@@ -266,6 +350,20 @@ static void _bc_spirit1_enter_state_tx(void)
 
 static void _bc_spirit1_check_state_tx(void)
 {
+    if (_bc_spirit1.tx_backoff)
+    {
+        if (bc_tick_get() < _bc_spirit1.tx_tick_backoff)
+        {
+            bc_scheduler_plan_current_absolute(_bc_spirit1.tx_tick_backoff);
+
+            return;
+        }
+
+        _bc_spirit1_transmit();
+
+        return;
+    }
+
     SpiritIrqs xIrqStatus;
 
     SpiritIrqGetStatus(&xIrqStatus);
@@ -302,6 +400,8 @@ static void _bc_spirit1_enter_state_rx(void)
 
     _bc_spirit1.current_state = BC_SPIRIT1_STATE_RX;
 
+    _bc_spirit1_update_channel();
+
     if (_bc_spirit1.rx_timeout == BC_TICK_INFINITY)
     {
         _bc_spirit1.rx_tick_timeout = BC_TICK_INFINITY;
@@ -404,6 +504,50 @@ static void _bc_spirit1_enter_state_sleep(void)
     GPIOA->PUPDR &= ~GPIO_PUPDR_PUPD7_1;
 }
 
+static void _bc_spirit1_update_channel(void)
+{
+    if (!_bc_spirit1.channel_update)
+    {
+        return;
+    }
+
+    _bc_spirit1.channel_update = false;
+
+    SpiritCmdStrobeSabort();
+    SpiritCmdStrobeReady();
+
+    SpiritRadioSetChannel(_bc_spirit1.channel);
+}
+
+static bool _bc_spirit1_carrier_sense(void)
+{
+    SpiritCmdStrobeSabort();
+    SpiritCmdStrobeReady();
+    SpiritIrqDeInit(NULL);
+    SpiritIrqClearStatus();
+
+    SpiritCmdStrobeRx();
+
+    // Enable PLL
+    bc_system_pll_enable();
+
+    bc_timer_start();
+
+    bc_timer_delay(_BC_SPIRIT1_LBT_LISTEN_TIME);
+
+    bc_timer_stop();
+
+    // Disable PLL
+    bc_system_pll_disable();
+
+    bool busy = SpiritQiGetCs() == S_SET;
+
+    SpiritCmdStrobeSabort();
+    SpiritCmdStrobeReady();
+
+    return busy;
+}
+
 bc_spirit_status_t bc_spirit1_command(uint8_t command)
 {
     // Enable PLL
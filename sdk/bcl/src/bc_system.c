@@ -5,6 +5,12 @@
 
 #define _BC_SYSTEM_DEBUG_ENABLE 0
 
+// Shortest sleep for which wake-up timer is reprogrammed (in milliseconds)
+#define _BC_SYSTEM_TICKLESS_MIN_INTERVAL 20
+
+// Longest sleep wake-up timer can measure (in timer periods)
+#define _BC_SYSTEM_TICKLESS_MAX_COUNT 0x10000
+
 static const uint32_t bc_system_clock_table[3] =
 {
     RCC_CFGR_SW_MSI,
@@ -18,6 +24,10 @@ static int _bc_system_pll_enable_semaphore;
 
 static int _bc_system_deep_sleep_disable_semaphore;
 
+static int _bc_system_tickless_disable_semaphore;
+
+static uint32_t _bc_system_tick_fraction;
+
 static void _bc_system_init_flash(void);
 
 static void _bc_system_init_debug(void);
@@ -32,6 +42,14 @@ static void _bc_system_init_rtc(void);
 
 static void _bc_system_switch_clock(bc_system_clock_t clock);
 
+static void _bc_system_sleep_tickless(bc_tick_t interval);
+
+static void _bc_system_rtc_set_wakeup(uint32_t count);
+
+static uint32_t _bc_system_rtc_get_time(void);
+
+static void _bc_system_tick_advance(uint32_t count);
+
 void bc_system_init(void)
 {
     _bc_system_init_flash();
@@ -235,7 +253,7 @@ static void _bc_system_init_rtc(void)
     }
 
     // Set wake-up auto-reload value
-    RTC->WUTR = 20;
+    RTC->WUTR = BC_SYSTEM_RTC_WAKEUP_COUNT - 1;
 
     // Clear timer flag
     RTC->ISR &= ~RTC_ISR_WUTF;
@@ -258,7 +276,42 @@ static void _bc_system_init_rtc(void)
 
 void bc_system_sleep(void)
 {
-    __WFI();
+    bc_tick_t interval = 0;
+
+    // Pending interrupt wakes core up even if interrupts are disabled
+    bc_irq_disable();
+
+    if (_bc_system_tickless_disable_semaphore == 0)
+    {
+        bc_tick_t tick_now = bc_tick_get();
+        bc_tick_t tick_deadline = bc_scheduler_get_next_deadline();
+
+        if (tick_deadline > tick_now)
+        {
+            interval = tick_deadline - tick_now;
+        }
+    }
+
+    if (interval >= _BC_SYSTEM_TICKLESS_MIN_INTERVAL)
+    {
+        _bc_system_sleep_tickless(interval);
+    }
+    else
+    {
+        __WFI();
+    }
+
+    bc_irq_enable();
+}
+
+void bc_system_tickless_enable(void)
+{
+    _bc_system_tickless_disable_semaphore--;
+}
+
+void bc_system_tickless_disable(void)
+{
+    _bc_system_tickless_disable_semaphore++;
 }
 
 void bc_system_deep_sleep_enable(void)
@@ -432,13 +485,127 @@ void RTC_IRQHandler(void)
         // Clear wake-up timer flag
         RTC->ISR &= ~RTC_ISR_WUTF;
 
-        bc_tick_inrement_irq(10);
+        _bc_system_tick_advance(BC_SYSTEM_RTC_WAKEUP_COUNT);
     }
 
     // Clear EXTI interrupt flag
     EXTI->PR = EXTI_IMR_IM20;
 }
 
+static void _bc_system_sleep_tickless(bc_tick_t interval)
+{
+    uint32_t count;
+
+    // Round up so that core never wakes up before deadline
+    if (interval >= (bc_tick_t) _BC_SYSTEM_TICKLESS_MAX_COUNT * 1000 / BC_SYSTEM_RTC_WAKEUP_FREQUENCY)
+    {
+        count = _BC_SYSTEM_TICKLESS_MAX_COUNT;
+    }
+    else
+    {
+        count = (interval * BC_SYSTEM_RTC_WAKEUP_FREQUENCY + 999) / 1000;
+    }
+
+    uint32_t time_start = _bc_system_rtc_get_time();
+
+    _bc_system_rtc_set_wakeup(count);
+
+    __WFI();
+
+    // If core has been woken up by other interrupt than wake-up timer...
+    if ((RTC->ISR & RTC_ISR_WUTF) == 0)
+    {
+        // Calendar runs at 256 Hz and wraps around at midnight
+        uint32_t elapsed = (_bc_system_rtc_get_time() + 86400 * 256 - time_start) % (86400 * 256);
+
+        elapsed *= BC_SYSTEM_RTC_WAKEUP_FREQUENCY / 256;
+
+        if (elapsed < count)
+        {
+            count = elapsed;
+        }
+    }
+
+    _bc_system_rtc_set_wakeup(BC_SYSTEM_RTC_WAKEUP_COUNT);
+
+    // Wake-up timer interrupt has been handled here
+    EXTI->PR = EXTI_IMR_IM20;
+
+    NVIC_ClearPendingIRQ(RTC_IRQn);
+
+    _bc_system_tick_advance(count);
+}
+
+static void _bc_system_rtc_set_wakeup(uint32_t count)
+{
+    // Disable write protection
+    RTC->WPR = 0xca;
+    RTC->WPR = 0x53;
+
+    // Disable timer
+    RTC->CR &= ~RTC_CR_WUTE;
+
+    // Wait until timer configuration update is allowed...
+    while ((RTC->ISR & RTC_ISR_WUTWF) == 0)
+    {
+        continue;
+    }
+
+    // Set wake-up auto-reload value
+    RTC->WUTR = count - 1;
+
+    // Clear timer flag
+    RTC->ISR &= ~RTC_ISR_WUTF;
+
+    // Enable timer
+    RTC->CR |= RTC_CR_WUTE;
+
+    // Enable write protection
+    RTC->WPR = 0xff;
+}
+
+static uint32_t _bc_system_rtc_get_time(void)
+{
+    // Disable write protection
+    RTC->WPR = 0xca;
+    RTC->WPR = 0x53;
+
+    // Clear registers synchronization flag (it is write protected)
+    RTC->ISR &= ~RTC_ISR_RSF;
+
+    // Enable write protection
+    RTC->WPR = 0xff;
+
+    // Wait for shadow registers to be updated (they are not updated in Stop mode)...
+    while ((RTC->ISR & RTC_ISR_RSF) == 0)
+    {
+        continue;
+    }
+
+    // Reading sub-second register locks time register until date register is read
+    uint32_t ssr = RTC->SSR;
+    uint32_t tr = RTC->TR;
+
+    // Unlock shadow registers
+    (void) RTC->DR;
+
+    uint32_t hours = ((tr & RTC_TR_HT) >> RTC_TR_HT_Pos) * 10 + ((tr & RTC_TR_HU) >> RTC_TR_HU_Pos);
+    uint32_t minutes = ((tr & RTC_TR_MNT) >> RTC_TR_MNT_Pos) * 10 + ((tr & RTC_TR_MNU) >> RTC_TR_MNU_Pos);
+    uint32_t seconds = ((tr & RTC_TR_ST) >> RTC_TR_ST_Pos) * 10 + ((tr & RTC_TR_SU) >> RTC_TR_SU_Pos);
+
+    // Sub-second counter counts down from synchronous prescaler value (255)
+    return ((hours * 60 + minutes) * 60 + seconds) * 256 + (255 - (ssr & RTC_SSR_SS));
+}
+
+static void _bc_system_tick_advance(uint32_t count)
+{
+    // Keep fraction of millisecond so that tick does not drift (timer period is not a whole number of milliseconds)
+    _bc_system_tick_fraction += count * 1000;
+
+    bc_tick_inrement_irq(_bc_system_tick_fraction / BC_SYSTEM_RTC_WAKEUP_FREQUENCY);
+
+    _bc_system_tick_fraction %= BC_SYSTEM_RTC_WAKEUP_FREQUENCY;
+}
 
 static void _bc_system_switch_clock(bc_system_clock_t clock)
 {
@@ -0,0 +1,285 @@
+#include <bc_telemetry_codec.h>
+
+// Frame starts with one byte of keyframe flag, sequence and distance to reference (delta frame only), values follow
+#define _BC_TELEMETRY_CODEC_FLAG_KEYFRAME 0x80
+#define _BC_TELEMETRY_CODEC_SEQUENCE_SHIFT 2
+#define _BC_TELEMETRY_CODEC_SEQUENCE_MASK 0x1f
+#define _BC_TELEMETRY_CODEC_DISTANCE_MASK 0x03
+
+// Reference is 1 to 4 frames back, older one needs keyframe
+#define _BC_TELEMETRY_CODEC_DISTANCE_MAX (_BC_TELEMETRY_CODEC_DISTANCE_MASK + 1)
+
+static uint8_t *_bc_telemetry_codec_varint_to_buffer(int32_t value, uint8_t *buffer, uint8_t *end);
+static const uint8_t *_bc_telemetry_codec_varint_from_buffer(const uint8_t *buffer, const uint8_t *end, int32_t *value);
+static uint8_t _bc_telemetry_codec_get_reference_sequence(uint8_t head);
+static const bc_telemetry_codec_reference_t *_bc_telemetry_codec_find_reference(const bc_telemetry_codec_decoder_t *self, uint8_t head);
+
+void bc_telemetry_codec_encoder_init(bc_telemetry_codec_encoder_t *self, int count, int keyframe_interval)
+{
+    memset(self, 0, sizeof(*self));
+
+    self->_count = count;
+    self->_keyframe_interval = keyframe_interval;
+}
+
+size_t bc_telemetry_codec_encode(bc_telemetry_codec_encoder_t *self, const int32_t *values, uint8_t *buffer, size_t size)
+{
+    if ((self->_count < 1) || (self->_count > BC_TELEMETRY_CODEC_MAX_VALUES) || (size < 2))
+    {
+        return 0;
+    }
+
+    uint8_t distance = (self->_sequence - self->_reference.sequence) & _BC_TELEMETRY_CODEC_SEQUENCE_MASK;
+
+    bool keyframe = !self->_reference.valid || (distance < 1) || (distance > _BC_TELEMETRY_CODEC_DISTANCE_MAX);
+
+    if ((self->_keyframe_interval != 0) && (self->_keyframe_counter >= self->_keyframe_interval))
+    {
+        keyframe = true;
+    }
+
+    uint8_t *pointer = buffer;
+    uint8_t *end = buffer + size;
+
+    *pointer = self->_sequence << _BC_TELEMETRY_CODEC_SEQUENCE_SHIFT;
+
+    *pointer++ |= keyframe ? _BC_TELEMETRY_CODEC_FLAG_KEYFRAME : distance - 1;
+
+    for (int i = 0; i < self->_count; i++)
+    {
+        // Difference is computed in unsigned arithmetic so that it wraps around instead of overflowing
+        int32_t value = keyframe ? values[i] : (int32_t) ((uint32_t) values[i] - (uint32_t) self->_reference.values[i]);
+
+        pointer = _bc_telemetry_codec_varint_to_buffer(value, pointer, end);
+
+        if (pointer == NULL)
+        {
+            return 0;
+        }
+    }
+
+    // Remember frame until it is acknowledged
+    bc_telemetry_codec_reference_t *pending = &self->_pending[self->_pending_head];
+
+    memcpy(pending->values, values, self->_count * sizeof(int32_t));
+    pending->count = self->_count;
+    pending->sequence = self->_sequence;
+    pending->valid = true;
+
+    if (++self->_pending_head == BC_TELEMETRY_CODEC_HISTORY)
+    {
+        self->_pending_head = 0;
+    }
+
+    self->_sequence = (self->_sequence + 1) & _BC_TELEMETRY_CODEC_SEQUENCE_MASK;
+
+    self->_keyframe_counter = keyframe ? 1 : self->_keyframe_counter + 1;
+
+    return pointer - buffer;
+}
+
+void bc_telemetry_codec_acknowledge(bc_telemetry_codec_encoder_t *self, const uint8_t *buffer, size_t length)
+{
+    if (length < 2)
+    {
+        return;
+    }
+
+    for (int i = 0; i < BC_TELEMETRY_CODEC_HISTORY; i++)
+    {
+        bc_telemetry_codec_reference_t *pending = &self->_pending[i];
+
+        if (pending->valid && (pending->sequence == bc_telemetry_codec_get_sequence(buffer, length)))
+        {
+            self->_reference = *pending;
+
+            pending->valid = false;
+
+            return;
+        }
+    }
+}
+
+void bc_telemetry_codec_force_keyframe(bc_telemetry_codec_encoder_t *self)
+{
+    self->_reference.valid = false;
+}
+
+void bc_telemetry_codec_decoder_init(bc_telemetry_codec_decoder_t *self)
+{
+    memset(self, 0, sizeof(*self));
+}
+
+bool bc_telemetry_codec_decode(bc_telemetry_codec_decoder_t *self, const uint8_t *buffer, size_t length, int32_t *values, int *count)
+{
+    const uint8_t *pointer = buffer + 1;
+    const uint8_t *end = buffer + length;
+
+    if (length < 2)
+    {
+        return false;
+    }
+
+    bool keyframe = bc_telemetry_codec_is_keyframe(buffer, length);
+
+    const bc_telemetry_codec_reference_t *reference = NULL;
+
+    if (!keyframe)
+    {
+        reference = _bc_telemetry_codec_find_reference(self, buffer[0]);
+
+        // Reference frame has not been received
+        if (reference == NULL)
+        {
+            return false;
+        }
+    }
+
+    // Number of values is given by number of varints in frame
+    for (*count = 0; pointer != end; (*count)++)
+    {
+        if (*count == BC_TELEMETRY_CODEC_MAX_VALUES)
+        {
+            return false;
+        }
+
+        pointer = _bc_telemetry_codec_varint_from_buffer(pointer, end, &values[*count]);
+
+        if (pointer == NULL)
+        {
+            return false;
+        }
+    }
+
+    if (reference != NULL)
+    {
+        if (*count != reference->count)
+        {
+            return false;
+        }
+
+        for (int i = 0; i < *count; i++)
+        {
+            values[i] = (int32_t) ((uint32_t) values[i] + (uint32_t) reference->values[i]);
+        }
+    }
+
+    // Keyframe invalidates frames of previous sequence
+    if (keyframe)
+    {
+        memset(self->_history, 0, sizeof(self->_history));
+    }
+
+    bc_telemetry_codec_reference_t *history = &self->_history[self->_history_head];
+
+    memcpy(history->values, values, *count * sizeof(int32_t));
+    history->count = *count;
+    history->sequence = bc_telemetry_codec_get_sequence(buffer, length);
+    history->valid = true;
+
+    if (++self->_history_head == BC_TELEMETRY_CODEC_HISTORY)
+    {
+        self->_history_head = 0;
+    }
+
+    return true;
+}
+
+bool bc_telemetry_codec_is_keyframe(const uint8_t *buffer, size_t length)
+{
+    return (length >= 2) && ((buffer[0] & _BC_TELEMETRY_CODEC_FLAG_KEYFRAME) != 0);
+}
+
+uint8_t bc_telemetry_codec_get_sequence(const uint8_t *buffer, size_t length)
+{
+    if (length < 1)
+    {
+        return 0;
+    }
+
+    return (buffer[0] >> _BC_TELEMETRY_CODEC_SEQUENCE_SHIFT) & _BC_TELEMETRY_CODEC_SEQUENCE_MASK;
+}
+
+bool bc_telemetry_codec_decoder_has_reference(const bc_telemetry_codec_decoder_t *self, const uint8_t *buffer, size_t length)
+{
+    if (length < 2)
+    {
+        return false;
+    }
+
+    return bc_telemetry_codec_is_keyframe(buffer, length) || (_bc_telemetry_codec_find_reference(self, buffer[0]) != NULL);
+}
+
+static uint8_t _bc_telemetry_codec_get_reference_sequence(uint8_t head)
+{
+    uint8_t distance = (head & _BC_TELEMETRY_CODEC_DISTANCE_MASK) + 1;
+
+    return ((head >> _BC_TELEMETRY_CODEC_SEQUENCE_SHIFT) - distance) & _BC_TELEMETRY_CODEC_SEQUENCE_MASK;
+}
+
+static const bc_telemetry_codec_reference_t *_bc_telemetry_codec_find_reference(const bc_telemetry_codec_decoder_t *self, uint8_t head)
+{
+    uint8_t sequence = _bc_telemetry_codec_get_reference_sequence(head);
+
+    for (int i = 0; i < BC_TELEMETRY_CODEC_HISTORY; i++)
+    {
+        if (self->_history[i].valid && (self->_history[i].sequence == sequence))
+        {
+            return &self->_history[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint8_t *_bc_telemetry_codec_varint_to_buffer(int32_t value, uint8_t *buffer, uint8_t *end)
+{
+    // Zigzag encoding maps small negative numbers to small positive ones
+    uint32_t zigzag = ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+
+    do
+    {
+        if (buffer == end)
+        {
+            return NULL;
+        }
+
+        *buffer = zigzag & 0x7f;
+
+        zigzag >>= 7;
+
+        if (zigzag != 0)
+        {
+            *buffer |= 0x80;
+        }
+
+        buffer++;
+
+    } while (zigzag != 0);
+
+    return buffer;
+}
+
+static const uint8_t *_bc_telemetry_codec_varint_from_buffer(const uint8_t *buffer, const uint8_t *end, int32_t *value)
+{
+    uint32_t zigzag = 0;
+
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (buffer == end)
+        {
+            return NULL;
+        }
+
+        zigzag |= (uint32_t) (*buffer & 0x7f) << shift;
+
+        if ((*buffer++ & 0x80) == 0)
+        {
+            *value = (int32_t) ((zigzag >> 1) ^ -(zigzag & 1));
+
+            return buffer;
+        }
+    }
+
+    return NULL;
+}
@@ -1,6 +1,5 @@
 #include <bc_tick.h>
 #include <bc_irq.h>
-#include <stm32l0xx.h>
 
 static bc_tick_t _bc_tick_counter = 0;
 
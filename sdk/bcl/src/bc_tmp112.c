@@ -8,6 +8,12 @@ static void _bc_tmp112_task_interval(void *param);
 
 static void _bc_tmp112_task_measure(void *param);
 
+static bool _bc_tmp112_i2c_write(bc_tmp112_t *self, uint32_t memory_address, uint8_t *buffer, size_t length);
+
+static bool _bc_tmp112_i2c_read(bc_tmp112_t *self, uint32_t memory_address, uint8_t *buffer, size_t length);
+
+static void _bc_tmp112_i2c_event_handler(bc_i2c_event_t event, void *event_param);
+
 void bc_tmp112_init(bc_tmp112_t *self, bc_i2c_channel_t i2c_channel, uint8_t i2c_address)
 {
     memset(self, 0, sizeof(*self));
@@ -131,6 +137,21 @@ static void _bc_tmp112_task_measure(void *param)
 {
     bc_tmp112_t *self = param;
 
+    // Transfers of previous state are not finished yet, their event handler plans task again
+    if (self->_i2c_pending != 0)
+    {
+        self->_i2c_wait = true;
+
+        return;
+    }
+
+    if (self->_i2c_error)
+    {
+        self->_i2c_error = false;
+
+        self->_state = BC_TMP112_STATE_ERROR;
+    }
+
 start:
 
     switch (self->_state)
@@ -154,7 +175,10 @@ start:
         {
             self->_state = BC_TMP112_STATE_ERROR;
 
-            if (!bc_i2c_memory_write_16b(self->_i2c_channel, self->_i2c_address, 0x01, 0x0180))
+            self->_i2c_buffer[0] = 0x01;
+            self->_i2c_buffer[1] = 0x80;
+
+            if (!_bc_tmp112_i2c_write(self, 0x01, self->_i2c_buffer, 2))
             {
                 goto start;
             }
@@ -174,7 +198,9 @@ start:
         {
             self->_state = BC_TMP112_STATE_ERROR;
 
-            if (!bc_i2c_memory_write_8b(self->_i2c_channel, self->_i2c_address, 0x01, 0x81))
+            self->_i2c_buffer[0] = 0x81;
+
+            if (!_bc_tmp112_i2c_write(self, 0x01, self->_i2c_buffer, 1))
             {
                 goto start;
             }
@@ -189,31 +215,35 @@ start:
         {
             self->_state = BC_TMP112_STATE_ERROR;
 
-            uint8_t reg_configuration;
-
-            if (!bc_i2c_memory_read_8b(self->_i2c_channel, self->_i2c_address, 0x01, &reg_configuration))
+            if (!_bc_tmp112_i2c_read(self, 0x01, &self->_i2c_buffer[0], 1))
             {
                 goto start;
             }
 
-            if ((reg_configuration & 0x81) != 0x81)
+            if (!_bc_tmp112_i2c_read(self, 0x00, &self->_i2c_buffer[1], 2))
             {
                 goto start;
             }
 
-            if (!bc_i2c_memory_read_16b(self->_i2c_channel, self->_i2c_address, 0x00, &self->_reg_temperature))
+            self->_state = BC_TMP112_STATE_UPDATE;
+
+            bc_scheduler_plan_current_now();
+
+            return;
+        }
+        case BC_TMP112_STATE_UPDATE:
+        {
+            if ((self->_i2c_buffer[0] & 0x81) != 0x81)
             {
+                self->_state = BC_TMP112_STATE_ERROR;
+
                 goto start;
             }
 
-            self->_temperature_valid = true;
+            self->_reg_temperature = self->_i2c_buffer[1] << 8 | self->_i2c_buffer[2];
 
-            self->_state = BC_TMP112_STATE_UPDATE;
+            self->_temperature_valid = true;
 
-            goto start;
-        }
-        case BC_TMP112_STATE_UPDATE:
-        {
             self->_measurement_active = false;
 
             if (self->_event_handler != NULL)
@@ -233,3 +263,59 @@ start:
         }
     }
 }
+
+static bool _bc_tmp112_i2c_write(bc_tmp112_t *self, uint32_t memory_address, uint8_t *buffer, size_t length)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = length;
+
+    if (!bc_i2c_async_memory_write(self->_i2c_channel, &transfer, _bc_tmp112_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static bool _bc_tmp112_i2c_read(bc_tmp112_t *self, uint32_t memory_address, uint8_t *buffer, size_t length)
+{
+    bc_i2c_memory_transfer_t transfer;
+
+    transfer.device_address = self->_i2c_address;
+    transfer.memory_address = memory_address;
+    transfer.buffer = buffer;
+    transfer.length = length;
+
+    if (!bc_i2c_async_memory_read(self->_i2c_channel, &transfer, _bc_tmp112_i2c_event_handler, self))
+    {
+        return false;
+    }
+
+    self->_i2c_pending++;
+
+    return true;
+}
+
+static void _bc_tmp112_i2c_event_handler(bc_i2c_event_t event, void *event_param)
+{
+    bc_tmp112_t *self = event_param;
+
+    if (event == BC_I2C_EVENT_ERROR)
+    {
+        self->_i2c_error = true;
+    }
+
+    // Failure is handled immediately, otherwise task continues at its planned time
+    if ((--self->_i2c_pending == 0) && (self->_i2c_wait || self->_i2c_error))
+    {
+        self->_i2c_wait = false;
+
+        bc_scheduler_plan_now(self->_task_id_measure);
+    }
+}
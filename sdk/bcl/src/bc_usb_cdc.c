@@ -61,34 +61,12 @@ bool bc_usb_cdc_write(const void *buffer, size_t length)
 
 size_t bc_usb_cdc_read(void *buffer, size_t length)
 {
-    size_t bytes_read = 0;
-
-    while (length != 0)
-    {
-        uint8_t value;
-
-        if (bc_fifo_read(&_bc_usb_cdc.receive_fifo, &value, 1) == 1)
-        {
-            *(uint8_t *) buffer = value;
-
-            buffer = (uint8_t *) buffer + 1;
-
-            bytes_read++;
-        }
-        else
-        {
-            break;
-        }
-
-        length--;
-    }
-
-    return bytes_read;
+    return bc_fifo_spsc_read(&_bc_usb_cdc.receive_fifo, buffer, length);
 }
 
 void bc_usb_cdc_received_data(const void *buffer, size_t length)
 {
-    bc_fifo_irq_write(&_bc_usb_cdc.receive_fifo, (uint8_t *) buffer, length);
+    bc_fifo_spsc_write(&_bc_usb_cdc.receive_fifo, (uint8_t *) buffer, length);
 }
 
 static void _bc_usb_cdc_task_start(void *param)